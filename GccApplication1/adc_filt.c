@@ -0,0 +1,102 @@
+/**
+ * @file adc_filt.c
+ * @brief ADC 過取樣、CIC 抽取與定點數低通濾波處理段實作。
+ */
+
+#include "adc_filt.h"
+
+#define ADC_FILT_IN_BITS 10
+
+uint8_t AdcFilt_net(AdcFiltStr_t* Str_p, uint16_t* Buf_p, uint8_t Size) {
+    uint8_t gain_bits;
+
+    if (Size < 2 || Size > 128 || (Size & (Size - 1))) {
+        return 1;
+    }
+    if (Str_p->Order < 1 || Str_p->Order > 2) {
+        return 2;
+    }
+    gain_bits = Str_p->Order * Str_p->DecBits;
+    if (ADC_FILT_IN_BITS + gain_bits > 32 || Str_p->DecBits > 15 ||
+        ADC_FILT_IN_BITS + Str_p->ExtraBits > 16 ||
+        Str_p->ExtraBits > gain_bits) {
+        return 3;
+    }
+    if (Str_p->IirShift > 8) {
+        return 4;
+    }
+
+    Str_p->OutShift = gain_bits - Str_p->ExtraBits;
+    Str_p->DecCount = 0;
+    Str_p->Integ[0] = 0;
+    Str_p->Integ[1] = 0;
+    Str_p->Comb[0]  = 0;
+    Str_p->Comb[1]  = 0;
+    Str_p->IirState = -1;
+    Str_p->Buf_p    = Buf_p;
+    Str_p->Mask     = Size - 1;
+    Str_p->Head     = 0;
+    Str_p->Tail     = 0;
+    Str_p->Overrun  = 0;
+    return 0;
+}
+
+void AdcFilt_put(AdcFiltStr_t* Str_p, uint16_t Sample) {
+    uint32_t out;
+    uint32_t last;
+    uint8_t head;
+
+    /* 積分器以模數運算累加，溢位不影響 CIC 結果 */
+    Str_p->Integ[0] += Sample;
+    if (Str_p->Order == 2) {
+        Str_p->Integ[1] += Str_p->Integ[0];
+    }
+    if (++Str_p->DecCount < ((uint16_t)1 << Str_p->DecBits)) {
+        return;
+    }
+    Str_p->DecCount = 0;
+
+    /* 梳狀濾波器：Comb[0] 為最後一級積分器前次值，Comb[1] 為第一級梳狀前次輸出 */
+    last           = (Str_p->Order == 2) ? Str_p->Integ[1] : Str_p->Integ[0];
+    out            = last - Str_p->Comb[0];
+    Str_p->Comb[0] = last;
+    if (Str_p->Order == 2) {
+        last           = out;
+        out            = out - Str_p->Comb[1];
+        Str_p->Comb[1] = last;
+    }
+    out >>= Str_p->OutShift;
+
+    if (Str_p->IirShift) {
+        if (Str_p->IirState < 0) {
+            Str_p->IirState = (int32_t)out << Str_p->IirShift;
+        }
+        else {
+            Str_p->IirState += (int32_t)out - (Str_p->IirState >> Str_p->IirShift);
+        }
+        out = Str_p->IirState >> Str_p->IirShift;
+    }
+
+    head = Str_p->Head;
+    if ((uint8_t)(head - Str_p->Tail) > Str_p->Mask) {
+        Str_p->Overrun++;
+        return;
+    }
+    Str_p->Buf_p[head & Str_p->Mask] = (uint16_t)out;
+    Str_p->Head = head + 1;
+}
+
+uint8_t AdcFilt_get(AdcFiltStr_t* Str_p, uint16_t* Data_p) {
+    uint8_t tail = Str_p->Tail;
+
+    if (tail == Str_p->Head) {
+        return 1;
+    }
+    *Data_p     = Str_p->Buf_p[tail & Str_p->Mask];
+    Str_p->Tail = tail + 1;
+    return 0;
+}
+
+void AdcFilt_step(void* Str_p) {
+    AdcFilt_put((AdcFiltStr_t*)Str_p, ADCW);
+}
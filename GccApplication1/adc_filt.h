@@ -0,0 +1,87 @@
+/**
+ * @file adc_filt.h
+ * @brief ADC 過取樣、CIC 抽取與定點數低通濾波處理段。
+ *
+ * AdcFilt 可直接以 AdcInt_reg 註冊在 ADC 中斷中，每次轉換完成時累加
+ * 取樣，經 CIC(Order 1 即累加後傾出)抽取與可選的一階 IIR 低通後，
+ * 將 12~16 位元有效解析度的結果放入環狀緩衝區。
+ * 設定由 adc.cfg 中的 ADC0_FILT_STR_INI 提供。
+ */
+
+#ifndef ADC_FILT_H
+#define ADC_FILT_H
+
+#include "c4mlib.h"
+
+/**
+ * @brief ADC 濾波處理段結構
+ * @ingroup adcfilt_struct
+ *
+ * 前四個欄位為設定值，以 ADC0_FILT_STR_INI 初始化，其餘為執行狀態。
+ */
+typedef struct {
+    uint8_t Order;       ///< CIC 階數，1 或 2。
+    uint8_t DecBits;     ///< 抽取率 2^DecBits。
+    uint8_t ExtraBits;   ///< 輸出增加的解析度位元數。
+    uint8_t IirShift;    ///< 一階低通係數 2^-IirShift，0 為關閉。
+
+    uint8_t OutShift;    ///< CIC 輸出右移位元數。
+    uint16_t DecCount;   ///< 本次抽取已累加的取樣數。
+    uint32_t Integ[2];   ///< CIC 積分器。
+    uint32_t Comb[2];    ///< CIC 梳狀濾波器延遲。
+    int32_t IirState;    ///< 低通濾波狀態，放大 2^IirShift 倍。
+
+    uint16_t* Buf_p;          ///< 輸出緩衝區。
+    uint8_t Mask;             ///< 輸出緩衝區大小減一。
+    volatile uint8_t Head;    ///< 寫入計數。
+    volatile uint8_t Tail;    ///< 讀出計數。
+    volatile uint8_t Overrun; ///< 輸出緩衝區已滿而捨棄的筆數。
+} AdcFiltStr_t;
+
+/**
+ * @brief 檢查設定並鏈結輸出緩衝區。
+ *
+ * @ingroup adcfilt_func
+ * @param Str_p 以 ADC0_FILT_STR_INI 初始化過的結構指標。
+ * @param Buf_p 輸出緩衝區。
+ * @param Size  輸出緩衝區大小，須為2的冪次且介於2~128。
+ * @return uint8_t 錯誤代碼：
+ *   - 0：成功無誤。
+ *   - 1：參數 Size 錯誤。
+ *   - 2：Order 錯誤。
+ *   - 3：DecBits、ExtraBits 超出範圍。
+ *   - 4：IirShift 超出範圍。
+ */
+uint8_t AdcFilt_net(AdcFiltStr_t* Str_p, uint16_t* Buf_p, uint8_t Size);
+
+/**
+ * @brief 輸入一筆取樣。
+ *
+ * @ingroup adcfilt_func
+ * @param Str_p  ADC 濾波處理段結構指標。
+ * @param Sample 10位元 ADC 取樣值。
+ *
+ * 可由其他處理段(如 AdcScan 讀出的資料)呼叫，每 2^DecBits 筆輸入
+ * 產生一筆輸出。
+ */
+void AdcFilt_put(AdcFiltStr_t* Str_p, uint16_t Sample);
+
+/**
+ * @brief 讀出一筆濾波結果。
+ *
+ * @ingroup adcfilt_func
+ * @return uint8_t 錯誤代碼：
+ *   - 0：成功無誤。
+ *   - 1：沒有新的結果。
+ */
+uint8_t AdcFilt_get(AdcFiltStr_t* Str_p, uint16_t* Data_p);
+
+/**
+ * @brief 讀取 ADCW 並輸入濾波，可登錄在 ADC 中斷中執行。
+ *
+ * @ingroup adcfilt_func
+ * @param Str_p AdcFiltStr_t 結構指標。
+ */
+void AdcFilt_step(void* Str_p);
+
+#endif  // ADC_FILT_H
@@ -0,0 +1,130 @@
+/**
+ * @file adc_scan.c
+ * @brief ADC 多通道掃描取樣引擎實作。
+ */
+
+#include "adc_scan.h"
+
+#define ADMUX_MUX_MASK 0x1F
+
+static inline void AdcScan_mux(AdcScanStr_t* Str_p, uint8_t Index) {
+    ADMUX = Str_p->AdmuxBase | Str_p->Ch_p[Index].Channel;
+}
+
+static inline void AdcScan_store(AdcScanChStr_t* Ch_p, uint16_t Data) {
+    uint8_t head = Ch_p->Head;
+
+    if ((uint8_t)(head - Ch_p->Tail) > Ch_p->Mask) {
+        Ch_p->Overrun++;
+        return;
+    }
+    Ch_p->Buf_p[head & Ch_p->Mask] = Data;
+    Ch_p->Head = head + 1;
+}
+
+uint8_t AdcScan_chnet(AdcScanChStr_t* Ch_p, uint8_t Channel, uint16_t* Buf_p,
+                      uint8_t Size) {
+    if (Size < 2 || Size > 128 || (Size & (Size - 1))) {
+        return 1;
+    }
+    if (Channel > ADMUX_MUX_MASK) {
+        return 2;
+    }
+    Ch_p->Channel = Channel;
+    Ch_p->Mask    = Size - 1;
+    Ch_p->Buf_p   = Buf_p;
+    Ch_p->Head    = 0;
+    Ch_p->Tail    = 0;
+    Ch_p->Overrun = 0;
+    return 0;
+}
+
+uint8_t AdcScan_net(AdcScanStr_t* Str_p, AdcScanChStr_t* Ch_p, uint8_t Total,
+                    uint8_t ConvMode) {
+    if (Total == 0) {
+        return 1;
+    }
+    if (ConvMode != ADC_CONVMODE_SUCCESIVELY &&
+        ConvMode != ADC_CONVMODE_TRIGERED) {
+        return 2;
+    }
+    Str_p->Ch_p      = Ch_p;
+    Str_p->Total     = Total;
+    Str_p->ConvMode  = ConvMode;
+    Str_p->AdmuxBase = ADMUX & ~ADMUX_MUX_MASK;
+    Str_p->Cur       = 0;
+    Str_p->Next      = 0;
+    Str_p->Busy      = 0;
+    Str_p->TrigMiss  = 0;
+    Str_p->ScanCount = 0;
+    return 0;
+}
+
+void AdcScan_start(AdcScanStr_t* Str_p) {
+    if (Str_p->ConvMode == ADC_CONVMODE_TRIGERED) {
+        AdcScan_trig(Str_p);
+        return;
+    }
+    Str_p->Cur  = 0;
+    Str_p->Next = 0;
+    Str_p->Busy = 1;
+    AdcScan_mux(Str_p, 0);
+    SETBIT(ADCSRA, ADSC);
+}
+
+void AdcScan_trig(void* void_p) {
+    AdcScanStr_t* Str_p = (AdcScanStr_t*)void_p;
+
+    if (Str_p->Busy) {
+        Str_p->TrigMiss++;
+        return;
+    }
+    Str_p->Busy = 1;
+    Str_p->Cur  = 0;
+    AdcScan_mux(Str_p, 0);
+    SETBIT(ADCSRA, ADSC);
+}
+
+uint8_t AdcScan_get(AdcScanStr_t* Str_p, uint8_t Index, uint16_t* Data_p) {
+    AdcScanChStr_t* ch_p = &Str_p->Ch_p[Index];
+    uint8_t tail         = ch_p->Tail;
+
+    if (tail == ch_p->Head) {
+        return 1;
+    }
+    *Data_p    = ch_p->Buf_p[tail & ch_p->Mask];
+    ch_p->Tail = tail + 1;
+    return 0;
+}
+
+void AdcScan_step(void* void_p) {
+    AdcScanStr_t* Str_p = (AdcScanStr_t*)void_p;
+    uint8_t cur         = Str_p->Cur;
+    uint8_t next;
+
+    AdcScan_store(&Str_p->Ch_p[cur], ADCW);
+    if (cur == Str_p->Total - 1) {
+        Str_p->ScanCount++;
+    }
+
+    if (Str_p->ConvMode == ADC_CONVMODE_SUCCESIVELY) {
+        /* 正在轉換的是 Next，多工器改設為其下一個通道 */
+        next       = Str_p->Next;
+        Str_p->Cur = next;
+        if (++next >= Str_p->Total) {
+            next = 0;
+        }
+        Str_p->Next = next;
+        AdcScan_mux(Str_p, next);
+        return;
+    }
+
+    if (++cur < Str_p->Total) {
+        Str_p->Cur = cur;
+        AdcScan_mux(Str_p, cur);
+        SETBIT(ADCSRA, ADSC);
+    }
+    else {
+        Str_p->Busy = 0;
+    }
+}
@@ -0,0 +1,134 @@
+/**
+ * @file adc_scan.h
+ * @brief ADC 多通道掃描取樣引擎。
+ *
+ * AdcInt_trig / AdcInt_isDone / AdcInt_getConv 一次只轉換 ADC0_HW_SET_CFG
+ * 中的單一 Channel，讀取多個通道需要主程式逐一等待。AdcScan 依使用者提供
+ * 的通道表(可含 ADC_DIFF_* 差動增益通道)在 ADC 中斷中自動切換多工器，
+ * 並將結果存入各通道的環狀緩衝區。
+ *
+ * 支援兩種方式：
+ *  - ADC_CONVMODE_SUCCESIVELY：ADC 連續轉換，通道表循環掃描不停止。
+ *  - ADC_CONVMODE_TRIGERED：由 AdcScan_trig 啟動一輪掃描，可註冊在
+ *    TimIntStr_t 中以固定取樣率觸發。
+ */
+
+#ifndef ADC_SCAN_H
+#define ADC_SCAN_H
+
+#include "c4mlib.h"
+
+/**
+ * @brief ADC 掃描通道結構
+ * @ingroup adcscan_struct
+ *
+ * 每個通道擁有一個16位元環狀緩衝區，大小須為2的冪次。
+ * 中斷寫入 Head，主程式以 AdcScan_get 讀出並更新 Tail。
+ */
+typedef struct {
+    uint8_t Channel;          ///< ADC_CHANNEL_*、ADC_DIFF_* 通道設定值。
+    uint8_t Mask;             ///< 緩衝區大小減一。
+    uint16_t* Buf_p;          ///< 取樣結果緩衝區指標。
+    volatile uint8_t Head;    ///< 寫入計數。
+    volatile uint8_t Tail;    ///< 讀出計數。
+    volatile uint8_t Overrun; ///< 緩衝區已滿而捨棄的取樣數。
+} AdcScanChStr_t;
+
+/**
+ * @brief ADC 掃描管理結構
+ * @ingroup adcscan_struct
+ */
+typedef struct {
+    AdcScanChStr_t* Ch_p;        ///< 通道表指標。
+    uint8_t Total;               ///< 通道數量。
+    uint8_t ConvMode;            ///< ADC_CONVMODE_SUCCESIVELY 或 ADC_CONVMODE_TRIGERED。
+    uint8_t AdmuxBase;           ///< ADMUX 中參考電壓與資料對齊設定。
+    volatile uint8_t Cur;        ///< 剛完成轉換的通道表索引。
+    volatile uint8_t Next;       ///< 正在轉換的通道表索引。
+    volatile uint8_t Busy;       ///< 掃描進行中。
+    volatile uint8_t TrigMiss;   ///< 觸發時上一輪尚未完成的次數。
+    volatile uint16_t ScanCount; ///< 已完成的掃描輪數。
+} AdcScanStr_t;
+
+/**
+ * @brief 鏈結通道結構與其緩衝區。
+ *
+ * @ingroup adcscan_func
+ * @param Ch_p    通道結構指標。
+ * @param Channel ADC 通道設定值，同 AdcSetStr_t::Channel。
+ * @param Buf_p   取樣結果緩衝區。
+ * @param Size    緩衝區大小，須為2的冪次且介於2~128。
+ * @return uint8_t 錯誤代碼：
+ *   - 0：成功無誤。
+ *   - 1：參數 Size 錯誤。
+ *   - 2：參數 Channel 錯誤。
+ */
+uint8_t AdcScan_chnet(AdcScanChStr_t* Ch_p, uint8_t Channel, uint16_t* Buf_p,
+                      uint8_t Size);
+
+/**
+ * @brief 鏈結掃描結構與通道表。
+ *
+ * @ingroup adcscan_func
+ * @param Str_p    ADC 掃描管理結構指標。
+ * @param Ch_p     通道表指標。
+ * @param Total    通道數量。
+ * @param ConvMode ADC_CONVMODE_SUCCESIVELY 或 ADC_CONVMODE_TRIGERED，
+ *                 須與 AdcSet.ConvMode 相同。
+ * @return uint8_t 錯誤代碼：
+ *   - 0：成功無誤。
+ *   - 1：參數 Total 錯誤。
+ *   - 2：參數 ConvMode 錯誤。
+ *
+ * 須在 AdcInt_set 之後呼叫，會沿用 ADMUX 中已設定的參考電壓與資料對齊。
+ * 完成後以 AdcInt_reg 將 AdcScan_step 註冊至 ADC 中斷，並開啟 IntEn。
+ */
+uint8_t AdcScan_net(AdcScanStr_t* Str_p, AdcScanChStr_t* Ch_p, uint8_t Total,
+                    uint8_t ConvMode);
+
+/**
+ * @brief 開始掃描。
+ *
+ * @ingroup adcscan_func
+ *
+ * ADC_CONVMODE_SUCCESIVELY 時開始連續掃描；ADC_CONVMODE_TRIGERED 時等同於
+ * 呼叫一次 AdcScan_trig。
+ */
+void AdcScan_start(AdcScanStr_t* Str_p);
+
+/**
+ * @brief 觸發一輪掃描，可登錄在計時中斷中執行。
+ *
+ * @ingroup adcscan_func
+ * @param Str_p AdcScanStr_t 結構指標。
+ *
+ * 若上一輪尚未完成則不觸發，並將 TrigMiss 加1。
+ */
+void AdcScan_trig(void* Str_p);
+
+/**
+ * @brief 讀出一筆指定通道的取樣結果。
+ *
+ * @ingroup adcscan_func
+ * @param Str_p  ADC 掃描管理結構指標。
+ * @param Index  通道表索引。
+ * @param Data_p 資料指標。
+ * @return uint8_t 錯誤代碼：
+ *   - 0：成功無誤。
+ *   - 1：沒有新的取樣結果。
+ */
+uint8_t AdcScan_get(AdcScanStr_t* Str_p, uint8_t Index, uint16_t* Data_p);
+
+/**
+ * @brief ADC 轉換完成執行片段，可登錄在 ADC 中斷中執行。
+ *
+ * @ingroup adcscan_func
+ * @param Str_p AdcScanStr_t 結構指標。
+ *
+ * 連續轉換模式下，中斷發生時下一筆轉換已經以原通道開始，
+ * 因此結果會延後一個通道對應，通道表第一個通道在開始時會多取樣一次。
+ * 切換到差動增益通道後的第一筆結果可能需要較長的穩定時間。
+ */
+void AdcScan_step(void* Str_p);
+
+#endif  // ADC_SCAN_H
@@ -0,0 +1,147 @@
+/**
+ * @file asaspi_vec.c
+ * @brief ASA SPI Master 分段(scatter/gather)傳輸函式實作。
+ */
+
+#include "asaspi_vec.h"
+
+#include "remo_slave.h"
+
+#define SPIMV_W 0
+#define SPIMV_R 1
+
+static void SPIMV_wait(uint16_t WaitTick) {
+    while (WaitTick--) {
+        _delay_us(1);
+    }
+}
+
+/* 依 mode 產生第一筆位元組，無第一筆時回傳 1，mode 錯誤時回傳 5 */
+static char SPIMV_header(char mode, char RegAdd, uint8_t RW, uint8_t* Data_p) {
+    switch (mode) {
+        case 3:
+        case 4:
+            return 1;
+        case 5:
+        case 6:
+            *Data_p = RegAdd;
+            return 0;
+        case 7:
+        case 8:
+            *Data_p = (RW << 7) | (RegAdd & 0x7F);
+            return 0;
+        case 9:
+        case 10:
+            *Data_p = (RegAdd << 1) | RW;
+            return 0;
+        default:
+            return 5;
+    }
+}
+
+static char SPIMV_xfer(char mode, char ASAID, char RegAdd, uint8_t RW,
+                       char Cnt, const SpimVecStr_t* Vec_p, uint16_t WaitTick) {
+    uint8_t header;
+    char res = SPIMV_header(mode, RegAdd, RW, &header);
+
+    if (res == 5) {
+        return res;
+    }
+
+    ASABUS_ID_set(ASAID);
+    CLRBIT(ASA_SPIM_CS_PORT, ASA_SPIM_CS_PIN);
+
+    if (res == 0) {
+        ASABUS_SPI_swap(header);
+        SPIMV_wait(WaitTick);
+    }
+    for (uint8_t seg = 0; seg < (uint8_t)Cnt; seg++) {
+        uint8_t* data_p = (uint8_t*)Vec_p[seg].Data_p;
+        uint8_t bytes   = Vec_p[seg].Bytes;
+        uint8_t flags   = Vec_p[seg].Flags;
+        uint8_t is_tx   = (RW == SPIMV_W) || (flags & SPIMV_TX);
+
+        for (uint8_t i = 0; i < bytes; i++) {
+            uint8_t idx = (flags & SPIMV_HIFIRST) ? bytes - 1 - i : i;
+            if (is_tx) {
+                ASABUS_SPI_swap(data_p[idx]);
+            }
+            else {
+                data_p[idx] = ASABUS_SPI_swap(0x00);
+            }
+            SPIMV_wait(WaitTick);
+        }
+    }
+
+    SETBIT(ASA_SPIM_CS_PORT, ASA_SPIM_CS_PIN);
+    return 0;
+}
+
+/* mode 7~10 的 RegAdd 0x7F 為批次封包標記，只有 SPIMV_bulk 可使用 */
+static char SPIMV_regCheck(char mode, char RegAdd) {
+    if (mode >= 7 && mode <= 10 && (uint8_t)RegAdd >= REMOSLAVE_BULK_REG) {
+        return 4;
+    }
+    return 0;
+}
+
+char ASA_SPIM_trmv(char mode, char ASAID, char RegAdd, char Cnt,
+                   const SpimVecStr_t* Vec_p, uint16_t WaitTick) {
+    if (SPIMV_regCheck(mode, RegAdd)) {
+        return 4;
+    }
+    return SPIMV_xfer(mode, ASAID, RegAdd, SPIMV_W, Cnt, Vec_p, WaitTick);
+}
+
+char ASA_SPIM_recv(char mode, char ASAID, char RegAdd, char Cnt,
+                   const SpimVecStr_t* Vec_p, uint16_t WaitTick) {
+    if (SPIMV_regCheck(mode, RegAdd)) {
+        return 4;
+    }
+    return SPIMV_xfer(mode, ASAID, RegAdd, SPIMV_R, Cnt, Vec_p, WaitTick);
+}
+
+/* 將批次封包的數量、列表與資料組成分段描述表後傳輸 */
+static char SPIMV_bulk(char mode, char ASAID, uint8_t RW, char Num,
+                       const SpimBulkStr_t* List_p, void* Data_p,
+                       uint16_t WaitTick) {
+    SpimVecStr_t vec[REMOSLAVE_BULK_MAX + 2];
+    uint8_t* data_p = (uint8_t*)Data_p;
+    uint8_t num     = Num;
+    uint8_t order;
+
+    if (mode < 7 || mode > 10) {
+        return 5;
+    }
+    if (num == 0 || num > REMOSLAVE_BULK_MAX) {
+        return 4;
+    }
+    order = (mode & 0x01) ? SPIMV_LOWFIRST : SPIMV_HIFIRST;
+
+    vec[0].Data_p = &num;
+    vec[0].Bytes  = 1;
+    vec[0].Flags  = SPIMV_TX;
+    vec[1].Data_p = (void*)List_p;
+    vec[1].Bytes  = num * sizeof(SpimBulkStr_t);
+    vec[1].Flags  = SPIMV_TX;
+    for (uint8_t i = 0; i < num; i++) {
+        vec[i + 2].Data_p = data_p;
+        vec[i + 2].Bytes  = List_p[i].Bytes;
+        vec[i + 2].Flags  = order;
+        data_p += List_p[i].Bytes;
+    }
+    return SPIMV_xfer(mode, ASAID, REMOSLAVE_BULK_REG, RW, num + 2, vec,
+                      WaitTick);
+}
+
+char ASA_SPIM_trmb(char mode, char ASAID, char Num,
+                   const SpimBulkStr_t* List_p, void* Data_p,
+                   uint16_t WaitTick) {
+    return SPIMV_bulk(mode, ASAID, SPIMV_W, Num, List_p, Data_p, WaitTick);
+}
+
+char ASA_SPIM_recb(char mode, char ASAID, char Num,
+                   const SpimBulkStr_t* List_p, void* Data_p,
+                   uint16_t WaitTick) {
+    return SPIMV_bulk(mode, ASAID, SPIMV_R, Num, List_p, Data_p, WaitTick);
+}
@@ -0,0 +1,133 @@
+/**
+ * @file asaspi_vec.h
+ * @brief ASA SPI Master 分段(scatter/gather)傳輸函式。
+ *
+ * ASA_SPIM_trm / ASA_SPIM_rec 只接受單一連續資料區，傳送「標頭 + 資料」
+ * 時必須先複製到暫存緩衝區。本模組以分段描述表在同一個片選區間內依序
+ * 送收多個不連續的資料區，且每一段可以各自選擇位元組順序。
+ *
+ * ASA_SPIM_trmb / ASA_SPIM_recb 以同一個機制送出 RemoSlave 的批次封包，
+ * 在一個片選區間內讀寫多個遠端暫存器。批次封包以 RegAdd 0x7F 為標記，
+ * 因此 mode 7~10 的單一暫存器位址只能使用 0~0x7E。
+ */
+
+#ifndef ASASPI_VEC_H
+#define ASASPI_VEC_H
+
+#include "c4mlib.h"
+
+#define SPIMV_LOWFIRST 0x00  ///< 由低到高傳輸 @ingroup asaspi_macro
+#define SPIMV_HIFIRST  0x01  ///< 由高到低傳輸 @ingroup asaspi_macro
+#define SPIMV_TX       0x02  ///< ASA_SPIM_recv 中此段為傳送 @ingroup asaspi_macro
+
+/**
+ * @brief SPI 分段描述結構
+ * @ingroup asaspi_struct
+ */
+typedef struct {
+    void* Data_p;   ///< 資料區指標。
+    uint8_t Bytes;  ///< 資料區位元組數。
+    uint8_t Flags;  ///< 位元組順序與方向，SPIMV_* 的組合。
+} SpimVecStr_t;
+
+/**
+ * @brief SPI 批次傳輸列表項
+ * @ingroup asaspi_struct
+ */
+typedef struct {
+    uint8_t RegAdd;  ///< 遠端暫存器位址。
+    uint8_t Bytes;   ///< 暫存器位元組數。
+} SpimBulkStr_t;
+
+/**
+ * @brief ASA SPI Master 分段傳送函式。
+ *
+ * @ingroup asaspi_func
+ * @param mode     SPI通訊模式，目前支援：3~10。
+ * @param ASAID    ASA介面卡的ID編號。
+ * @param RegAdd   遠端讀寫暫存器(Register)的位址，mode 7~10 為 0~0x7E。
+ * @param Cnt      分段數量。
+ * @param Vec_p    分段描述表指標。
+ * @param WaitTick 位元組間延遲時間，單位為 1us。
+ * @return char    錯誤代碼：
+ *                  - 0：成功無誤。
+ *                  - 4：mode 7~10 時參數 RegAdd 超過 0x7E。
+ *                  - 5：模式選擇錯誤。
+ *
+ * 第一筆依 mode 決定，與 ASA_SPIM_trm 相同：
+ *  - mode 3、4 ：未送RegAdd。
+ *  - mode 5、6 ：[RegAdd]。
+ *  - mode 7、8 ：[W | RegAdd]。
+ *  - mode 9、10：[(RegAdd<<1) | W]。
+ *
+ * 之後在同一個片選區間內依序傳送每一段資料，位元組順序由該段的
+ * Flags 決定，與 mode 的奇偶無關。
+ */
+char ASA_SPIM_trmv(char mode, char ASAID, char RegAdd, char Cnt,
+                   const SpimVecStr_t* Vec_p, uint16_t WaitTick);
+
+/**
+ * @brief ASA SPI Master 分段接收函式。
+ *
+ * @ingroup asaspi_func
+ * @param mode     SPI通訊模式，目前支援：3~10。
+ * @param ASAID    ASA介面卡的ID編號。
+ * @param RegAdd   遠端讀寫暫存器(Register)的位址，mode 7~10 為 0~0x7E。
+ * @param Cnt      分段數量。
+ * @param Vec_p    分段描述表指標。
+ * @param WaitTick 位元組間延遲時間，單位為 1us。
+ * @return char    錯誤代碼：
+ *                  - 0：成功無誤。
+ *                  - 4：mode 7~10 時參數 RegAdd 超過 0x7E。
+ *                  - 5：模式選擇錯誤。
+ *
+ * 第一筆依 mode 決定，與 ASA_SPIM_rec 相同(mode 7、8 為 [R | RegAdd]，
+ * mode 9、10 為 [(RegAdd<<1) | R])。之後依序處理每一段：Flags 含
+ * SPIMV_TX 的段落傳送資料(如命令、位址)，其餘段落送出 0x00 並將交換回來
+ * 的資料直接存入該段資料區。
+ */
+char ASA_SPIM_recv(char mode, char ASAID, char RegAdd, char Cnt,
+                   const SpimVecStr_t* Vec_p, uint16_t WaitTick);
+
+/**
+ * @brief ASA SPI Master 批次寫入多個暫存器。
+ *
+ * @ingroup asaspi_func
+ * @param mode     SPI通訊模式，只支援帶 R/W 位元的 7~10。
+ * @param ASAID    ASA介面卡的ID編號。
+ * @param Num      列表項數，1~REMOSLAVE_BULK_MAX。
+ * @param List_p   暫存器列表。
+ * @param Data_p   依列表順序連續存放的待送資料。
+ * @param WaitTick 位元組間延遲時間，單位為 1us。
+ * @return char    錯誤代碼：
+ *                  - 0：成功無誤。
+ *                  - 4：參數 Num 錯誤。
+ *                  - 5：模式選擇錯誤。
+ *
+ * 在同一個片選區間內送出 [W 與 REMOSLAVE_BULK_REG]、[Num]、Num 組
+ * [RegAdd][Bytes] 與所有資料，每個暫存器的位元組順序同 ASA_SPIM_trm 的
+ * mode(偶數為由高到低)。Slave 端由 RemoSlave SPI mode 7~10 處理，列表
+ * 與暫存器不符時全部不寫入；SPI 模式沒有回應，Master 無法得知結果。
+ */
+char ASA_SPIM_trmb(char mode, char ASAID, char Num,
+                   const SpimBulkStr_t* List_p, void* Data_p,
+                   uint16_t WaitTick);
+
+/**
+ * @brief ASA SPI Master 批次讀取多個暫存器。
+ *
+ * @ingroup asaspi_func
+ * @param Data_p 依列表順序連續存放接收資料。
+ *
+ * 其餘參數與回傳值同 ASA_SPIM_trmb。送出 [R 與 REMOSLAVE_BULK_REG]、
+ * [Num] 與列表後，接著送出 0x00 並依列表順序收回所有資料。
+ *
+ * SPI 的單一暫存器讀寫沒有 checksum 與回應，批次封包只省下每個暫存器的
+ * 片選與 RegAdd，列表卻多出 2 位元組，通訊線上的位元組數反而較多；
+ * 暫存器數量多且每次片選的額外時間長時才較快。
+ */
+char ASA_SPIM_recb(char mode, char ASAID, char Num,
+                   const SpimBulkStr_t* List_p, void* Data_p,
+                   uint16_t WaitTick);
+
+#endif  // ASASPI_VEC_H
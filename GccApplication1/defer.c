@@ -0,0 +1,87 @@
+/**
+ * @file defer.c
+ * @brief 延後執行排程器實作。
+ */
+
+#include "defer.h"
+
+#define DEFER_MASK (DEFER_QUEUE_SZ - 1)
+
+void Defer_net(DeferStr_t* Str_p) {
+    for (uint8_t i = 0; i < DEFER_PRI_NUM; i++) {
+        Str_p->Queue[i].Head = 0;
+        Str_p->Queue[i].Tail = 0;
+        Str_p->Queue[i].Lost = 0;
+    }
+}
+
+uint8_t Defer_post(DeferStr_t* Str_p, uint8_t Pri, Func_t Func_p,
+                   void* FuncPara_p) {
+    DeferQueueStr_t* q_p;
+    uint8_t head;
+    uint8_t sreg;
+    uint8_t res = 0;
+
+    if (Pri >= DEFER_PRI_NUM) {
+        return 1;
+    }
+    q_p = &Str_p->Queue[Pri];
+
+    /* 多個發送端(主程式與各中斷)共用寫入端，寫入事件與更新 Head 不可被打斷 */
+    sreg = SREG;
+    cli();
+    head = q_p->Head;
+    if ((uint8_t)(head - q_p->Tail) >= DEFER_QUEUE_SZ) {
+        q_p->Lost++;
+        res = 2;
+    }
+    else {
+        q_p->Evt[head & DEFER_MASK].Func_p     = Func_p;
+        q_p->Evt[head & DEFER_MASK].FuncPara_p = FuncPara_p;
+        q_p->Head                              = head + 1;
+    }
+    SREG = sreg;
+    return res;
+}
+
+uint8_t Defer_dispatch(DeferStr_t* Str_p) {
+    for (uint8_t i = 0; i < DEFER_PRI_NUM; i++) {
+        DeferQueueStr_t* q_p = &Str_p->Queue[i];
+        uint8_t tail         = q_p->Tail;
+
+        if (tail != q_p->Head) {
+            DeferEvtStr_t evt = q_p->Evt[tail & DEFER_MASK];
+            /* 先釋放格子再執行，事件本身可以再次放入同一佇列 */
+            q_p->Tail = tail + 1;
+            evt.Func_p(evt.FuncPara_p);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+uint8_t Defer_run(DeferStr_t* Str_p) {
+    uint8_t count = 0;
+
+    while (Defer_dispatch(Str_p)) {
+        if (count != 255) {
+            count++;
+        }
+    }
+    return count;
+}
+
+void* Defer_link(DeferFbStr_t* Fb_p, DeferStr_t* Defer_p, Func_t Func_p,
+                 void* FuncPara_p, uint8_t Pri) {
+    Fb_p->Defer_p    = Defer_p;
+    Fb_p->Func_p     = Func_p;
+    Fb_p->FuncPara_p = FuncPara_p;
+    Fb_p->Pri        = Pri;
+    return Fb_p;
+}
+
+void Defer_step(void* void_p) {
+    DeferFbStr_t* Fb_p = (DeferFbStr_t*)void_p;
+
+    Defer_post(Fb_p->Defer_p, Fb_p->Pri, Fb_p->Func_p, Fb_p->FuncPara_p);
+}
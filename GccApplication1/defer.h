@@ -0,0 +1,138 @@
+/**
+ * @file defer.h
+ * @brief 延後執行(deferred work)排程器。
+ *
+ * 以 TimInt_reg、ExtInt_reg 或 IntFreqDiv_reg 註冊的函式都在中斷中執行，
+ * 較長的工作會拉長其他中斷的延遲。Defer 讓中斷只把事件(執行函式與傳參)
+ * 放入對應優先權的佇列，再由主迴圈呼叫 Defer_run 依優先權取出執行，
+ * 每個事件執行完畢後都會重新從最高優先權檢查。
+ *
+ * 要讓 IFD 工作延後執行，將 Defer_step 作為執行函式註冊，並以
+ * Defer_link 設定的 DeferFbStr_t 作為傳參：
+ *
+ *   DeferStr_t Defer_str;
+ *   DeferFbStr_t Log_defer;
+ *   Defer_net(&Defer_str);
+ *   IntFreqDiv_reg(&IFD_str, Defer_step,
+ *                  Defer_link(&Log_defer, &Defer_str, Log_step, &Log_str, 2),
+ *                  100, 0);
+ *   while (1) {
+ *       Defer_run(&Defer_str);
+ *   }
+ */
+
+#ifndef DEFER_H
+#define DEFER_H
+
+#include "c4mlib.h"
+
+#if DEFER_QUEUE_SZ < 2 || DEFER_QUEUE_SZ > 128 || \
+    (DEFER_QUEUE_SZ & (DEFER_QUEUE_SZ - 1))
+#    error "DEFER_QUEUE_SZ must be a power of two between 2 and 128"
+#endif
+
+/**
+ * @brief 延後執行事件
+ * @ingroup defer_struct
+ */
+typedef struct {
+    Func_t Func_p;     ///< 執行函式。
+    void* FuncPara_p;  ///< 執行函式之傳參。
+} DeferEvtStr_t;
+
+/**
+ * @brief 單一優先權的事件佇列
+ * @ingroup defer_struct
+ */
+typedef struct {
+    DeferEvtStr_t Evt[DEFER_QUEUE_SZ];  ///< 事件緩衝區。
+    volatile uint8_t Head;              ///< 寫入計數，由發送端更新。
+    volatile uint8_t Tail;              ///< 讀取計數，由 Defer_run 更新。
+    volatile uint8_t Lost;              ///< 佇列已滿而遺失的事件數。
+} DeferQueueStr_t;
+
+/**
+ * @brief 延後執行排程器結構
+ * @ingroup defer_struct
+ */
+typedef struct {
+    DeferQueueStr_t Queue[DEFER_PRI_NUM];  ///< 各優先權佇列，0 為最高優先權。
+} DeferStr_t;
+
+/**
+ * @brief 延後執行的註冊函式結構，作為 Defer_step 的傳參
+ * @ingroup defer_struct
+ */
+typedef struct {
+    DeferStr_t* Defer_p;  ///< 要放入的排程器。
+    Func_t Func_p;        ///< 延後執行的函式。
+    void* FuncPara_p;     ///< 延後執行函式之傳參。
+    uint8_t Pri;          ///< 優先權。
+} DeferFbStr_t;
+
+/**
+ * @brief 初始化排程器，清空所有佇列。
+ * @ingroup defer_func
+ */
+void Defer_net(DeferStr_t* Str_p);
+
+/**
+ * @brief 放入一個事件。
+ *
+ * @ingroup defer_func
+ * @param Str_p      排程器結構指標。
+ * @param Pri        優先權，0~DEFER_PRI_NUM-1。
+ * @param Func_p     執行函式。
+ * @param FuncPara_p 執行函式之傳參。
+ * @return uint8_t 錯誤代碼：
+ *   - 0：成功無誤。
+ *   - 1：優先權超出範圍。
+ *   - 2：佇列已滿，事件遺失並累計於 Lost。
+ *
+ * 可在中斷或主程式中呼叫，只在更新寫入計數時短暫關閉中斷。
+ */
+uint8_t Defer_post(DeferStr_t* Str_p, uint8_t Pri, Func_t Func_p,
+                   void* FuncPara_p);
+
+/**
+ * @brief 執行一個最高優先權的事件。
+ *
+ * @ingroup defer_func
+ * @param Str_p 排程器結構指標。
+ * @return uint8_t 1：已執行一個事件，0：所有佇列皆為空。
+ *
+ * 只可在主程式中呼叫。
+ */
+uint8_t Defer_dispatch(DeferStr_t* Str_p);
+
+/**
+ * @brief 依優先權執行所有事件直到佇列皆為空。
+ *
+ * @ingroup defer_func
+ * @param Str_p 排程器結構指標。
+ * @return uint8_t 本次執行的事件數，超過255時回傳255。
+ */
+uint8_t Defer_run(DeferStr_t* Str_p);
+
+/**
+ * @brief 設定延後執行的註冊函式結構，並回傳其指標作為 Defer_step 的傳參。
+ *
+ * @ingroup defer_func
+ * @param Fb_p       延後執行的註冊函式結構指標。
+ * @param Defer_p    要放入的排程器。
+ * @param Func_p     延後執行的函式。
+ * @param FuncPara_p 延後執行函式之傳參。
+ * @param Pri        優先權。
+ */
+void* Defer_link(DeferFbStr_t* Fb_p, DeferStr_t* Defer_p, Func_t Func_p,
+                 void* FuncPara_p, uint8_t Pri);
+
+/**
+ * @brief 將註冊函式放入排程器，取代原函式註冊到中斷或 IFD 中。
+ *
+ * @ingroup defer_func
+ * @param Fb_p 延後執行的註冊函式結構指標(DeferFbStr_t*)。
+ */
+void Defer_step(void* Fb_p);
+
+#endif  // DEFER_H
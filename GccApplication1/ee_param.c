@@ -0,0 +1,254 @@
+/**
+ * @file ee_param.c
+ * @brief EEPROM 日誌式參數儲存實作。
+ */
+
+#include "ee_param.h"
+
+#define HEAD_SZ 2  // [Gen][~Gen]
+#define REC_SZ(LEN) ((uint16_t)(LEN) + 3)
+#define CAPACITY (EEPARAM_BANK_SZ - HEAD_SZ - 1)
+
+static uint16_t EeParam_base(uint8_t Bank) {
+    return EEPARAM_BASE + (Bank ? EEPARAM_BANK_SZ : 0);
+}
+
+/* 組成 [Key][Len][Data][Chk]，回傳紀錄長度 */
+static uint8_t EeParam_pack(uint8_t* Rec_p, uint8_t Key, const uint8_t* Data_p,
+                            uint8_t Bytes) {
+    uint8_t chksum = Key + Bytes;
+
+    Rec_p[0] = Key;
+    Rec_p[1] = Bytes;
+    for (uint8_t i = 0; i < Bytes; i++) {
+        Rec_p[2 + i] = Data_p[i];
+        chksum += Data_p[i];
+    }
+    Rec_p[2 + Bytes] = chksum;
+    return REC_SZ(Bytes);
+}
+
+static void EeParam_index(EeParamStr_t* Str_p, uint8_t Key, uint16_t Addr,
+                          uint8_t Bytes) {
+    if (Str_p->Addr[Key] != EEPARAM_NONE) {
+        Str_p->Live -= REC_SZ(Str_p->Len[Key]);
+    }
+    Str_p->Addr[Key] = Addr;
+    Str_p->Len[Key]  = Bytes;
+    Str_p->Live += REC_SZ(Bytes);
+}
+
+/* 掃描 bank 中的紀錄，回傳日誌結尾位址 */
+static uint16_t EeParam_scan(EeParamStr_t* Str_p, uint16_t Base) {
+    uint16_t addr = Base + HEAD_SZ;
+    uint16_t end  = Base + EEPARAM_BANK_SZ;
+    uint8_t rec[REC_SZ(EEPARAM_MAX_LEN)];
+    uint8_t chksum;
+    uint8_t len;
+
+    for (;;) {
+        EeQueue_get(Str_p->Queue_p, addr, 2, rec);
+        len = rec[1];
+        if (rec[0] >= EEPARAM_KEY_NUM || len == 0 || len > EEPARAM_MAX_LEN ||
+            addr + REC_SZ(len) >= end) {
+            break;
+        }
+        EeQueue_get(Str_p->Queue_p, addr + 2, len + 1, &rec[2]);
+        chksum = rec[0] + len;
+        for (uint8_t i = 0; i < len; i++) {
+            chksum += rec[2 + i];
+        }
+        if (chksum != rec[2 + len]) {
+            break;
+        }
+        EeParam_index(Str_p, rec[0], addr, len);
+        addr += REC_SZ(len);
+    }
+    return addr;
+}
+
+uint8_t EeParam_net(EeParamStr_t* Str_p, EeQueueStr_t* Queue_p) {
+    uint8_t head[2][HEAD_SZ];
+    uint8_t valid[2];
+    uint8_t data[HEAD_SZ];
+
+    Str_p->Queue_p = Queue_p;
+    Str_p->Live    = 0;
+    Str_p->State   = EEPARAM_ST_IDLE;
+    for (uint8_t i = 0; i < EEPARAM_KEY_NUM; i++) {
+        Str_p->Addr[i] = EEPARAM_NONE;
+    }
+
+    for (uint8_t b = 0; b < 2; b++) {
+        EeQueue_get(Queue_p, EeParam_base(b), HEAD_SZ, head[b]);
+        valid[b] = ((uint8_t)(head[b][0] ^ head[b][1]) == 0xFF);
+    }
+
+    if (!valid[0] && !valid[1]) {
+        Str_p->Bank = 0;
+        Str_p->Gen  = 0;
+        Str_p->Tail = EeParam_base(0) + HEAD_SZ;
+        data[0]     = 0xFF;
+        EeQueue_set(Queue_p, Str_p->Tail, 1, data, NULL, NULL);
+        data[0] = 0;
+        data[1] = 0xFF;
+        EeQueue_set(Queue_p, EeParam_base(0), HEAD_SZ, data, NULL, NULL);
+        return 1;
+    }
+
+    if (valid[0] && valid[1]) {
+        Str_p->Bank = ((int8_t)(head[1][0] - head[0][0]) > 0) ? 1 : 0;
+    }
+    else {
+        Str_p->Bank = valid[1];
+    }
+    Str_p->Gen  = head[Str_p->Bank][0];
+    Str_p->Tail = EeParam_scan(Str_p, EeParam_base(Str_p->Bank));
+    return 0;
+}
+
+uint8_t EeParam_set(EeParamStr_t* Str_p, uint8_t Key, const void* Data_p,
+                    uint8_t Bytes, Func_t Func_p, void* FuncPara_p) {
+    uint8_t rec[REC_SZ(EEPARAM_MAX_LEN) + 1];
+    uint16_t live;
+    uint16_t tail = Str_p->Tail;
+
+    if (Key >= EEPARAM_KEY_NUM) {
+        return 1;
+    }
+    if (Bytes == 0 || Bytes > EEPARAM_MAX_LEN) {
+        return 4;
+    }
+    if (Str_p->State != EEPARAM_ST_IDLE) {
+        return 3;
+    }
+    live = Str_p->Live + REC_SZ(Bytes);
+    if (Str_p->Addr[Key] != EEPARAM_NONE) {
+        live -= REC_SZ(Str_p->Len[Key]);
+    }
+    if (live > CAPACITY) {
+        return 5;
+    }
+
+    /* 日誌已滿，暫存這一筆並開始壓縮 */
+    if (tail + REC_SZ(Bytes) >= EeParam_base(Str_p->Bank) + EEPARAM_BANK_SZ) {
+        for (uint8_t i = 0; i < Bytes; i++) {
+            Str_p->Pend[i] = ((const uint8_t*)Data_p)[i];
+        }
+        Str_p->PendKey        = Key;
+        Str_p->PendLen        = Bytes;
+        Str_p->PendFunc_p     = Func_p;
+        Str_p->PendFuncPara_p = FuncPara_p;
+        Str_p->CopyKey        = 0;
+        Str_p->NewTail        = EeParam_base(Str_p->Bank ^ 1) + HEAD_SZ;
+        Str_p->State          = EEPARAM_ST_COPY;
+        return 0;
+    }
+
+    if (!EeQueue_hasSpace(Str_p->Queue_p, 2, REC_SZ(Bytes) + 1)) {
+        return 2;
+    }
+    /* 先寫 Key 以外的部分與新的結尾，最後才寫 Key */
+    EeParam_pack(rec, Key, (const uint8_t*)Data_p, Bytes);
+    rec[REC_SZ(Bytes)] = 0xFF;
+    EeQueue_set(Str_p->Queue_p, tail + 1, REC_SZ(Bytes), &rec[1], NULL, NULL);
+    EeQueue_set(Str_p->Queue_p, tail, 1, &rec[0], Func_p, FuncPara_p);
+    EeParam_index(Str_p, Key, tail, Bytes);
+    Str_p->Tail = tail + REC_SZ(Bytes);
+    return 0;
+}
+
+uint8_t EeParam_get(EeParamStr_t* Str_p, uint8_t Key, void* Data_p,
+                    uint8_t Bytes) {
+    if (Key >= EEPARAM_KEY_NUM) {
+        return 1;
+    }
+    /* 觸發壓縮的這一筆尚未複製前只在 Pend 中 */
+    if (Str_p->State == EEPARAM_ST_COPY && Key == Str_p->PendKey &&
+        Str_p->CopyKey <= Key) {
+        if (Bytes != Str_p->PendLen) {
+            return 4;
+        }
+        for (uint8_t i = 0; i < Bytes; i++) {
+            ((uint8_t*)Data_p)[i] = Str_p->Pend[i];
+        }
+        return 0;
+    }
+    if (Str_p->Addr[Key] == EEPARAM_NONE) {
+        return 2;
+    }
+    if (Bytes != Str_p->Len[Key]) {
+        return 4;
+    }
+    EeQueue_get(Str_p->Queue_p, Str_p->Addr[Key] + 2, Bytes, Data_p);
+    return 0;
+}
+
+void EeParam_run(EeParamStr_t* Str_p) {
+    uint8_t rec[REC_SZ(EEPARAM_MAX_LEN)];
+    uint8_t data[HEAD_SZ];
+    uint8_t key;
+    uint8_t len;
+    uint8_t size;
+
+    if (Str_p->State == EEPARAM_ST_IDLE) {
+        return;
+    }
+    /* 讀取舊 bank 須等待寫入結束，留到下次呼叫 */
+    if (EECR & (1 << EEWE)) {
+        return;
+    }
+
+    while (Str_p->State == EEPARAM_ST_COPY) {
+        key = Str_p->CopyKey;
+        if (key == EEPARAM_KEY_NUM) {
+            Str_p->State = EEPARAM_ST_TERM;
+            break;
+        }
+        if (key == Str_p->PendKey) {
+            len = Str_p->PendLen;
+            if (!EeQueue_hasSpace(Str_p->Queue_p, 1, REC_SZ(len))) {
+                return;
+            }
+            size = EeParam_pack(rec, key, Str_p->Pend, len);
+        }
+        else if (Str_p->Addr[key] != EEPARAM_NONE) {
+            len = Str_p->Len[key];
+            if (!EeQueue_hasSpace(Str_p->Queue_p, 1, REC_SZ(len))) {
+                return;
+            }
+            EeQueue_get(Str_p->Queue_p, Str_p->Addr[key], REC_SZ(len), rec);
+            size = REC_SZ(len);
+        }
+        else {
+            Str_p->CopyKey++;
+            continue;
+        }
+        EeQueue_set(Str_p->Queue_p, Str_p->NewTail, size, rec, NULL, NULL);
+        EeParam_index(Str_p, key, Str_p->NewTail, len);
+        Str_p->NewTail += size;
+        Str_p->CopyKey++;
+    }
+
+    if (Str_p->State == EEPARAM_ST_TERM) {
+        data[0] = 0xFF;
+        if (EeQueue_set(Str_p->Queue_p, Str_p->NewTail, 1, data, NULL, NULL)) {
+            return;
+        }
+        Str_p->State = EEPARAM_ST_HEAD;
+    }
+
+    if (Str_p->State == EEPARAM_ST_HEAD) {
+        data[0] = Str_p->Gen + 1;
+        data[1] = ~data[0];
+        if (EeQueue_set(Str_p->Queue_p, EeParam_base(Str_p->Bank ^ 1), HEAD_SZ,
+                        data, Str_p->PendFunc_p, Str_p->PendFuncPara_p)) {
+            return;
+        }
+        /* 之後的附加排在新 Gen 之後，斷電時與新 bank 一起生效或一起捨棄 */
+        Str_p->Bank ^= 1;
+        Str_p->Gen++;
+        Str_p->Tail  = Str_p->NewTail;
+        Str_p->State = EEPARAM_ST_IDLE;
+    }
+}
@@ -0,0 +1,145 @@
+/**
+ * @file ee_param.h
+ * @brief EEPROM 日誌式(log-structured)參數儲存。
+ *
+ * 以 EEPROM_set 依固定位址覆寫整個結構，每次都寫同一批位元，寫入也慢。
+ * EeParam 將參數以 key 區分，每次更新都附加一筆紀錄在日誌尾端，不在原地
+ * 覆寫；開機時掃描一次日誌在 RAM 中建立索引，之後讀取不需搜尋。
+ *
+ * EEPROM 中使用兩個各 EEPARAM_BANK_SZ 位元組的 bank，同時只有一個有效：
+ *
+ *   bank：[Gen][~Gen] 紀錄 ... [0xFF]
+ *   紀錄：[Key][Len][Data × Len][Chk]，Chk 為 Key、Len、Data 的總和
+ *
+ * 日誌寫滿時由 EeParam_run 在背景把每個 key 的最新紀錄複製到另一個
+ * bank，最後寫入較新的 Gen，開機時以 Gen 較新且 [Gen][~Gen] 相符的
+ * bank 為準。
+ *
+ * 斷電保護：附加紀錄時先寫入 Key 以外的部分與其後的結尾 0xFF，最後才
+ * 寫入原本為 0xFF 的 Key，Key 寫入前中斷則紀錄不存在；Key 寫入中斷時
+ * 只有這一個位元組可能錯誤，Chk 必定不符。壓縮時 Gen 在所有紀錄之後
+ * 寫入，中斷時仍以舊 bank 為準。
+ *
+ * 寫入經由 EeQueue 排入，不會阻塞主迴圈，完成時執行函式於 EE_READY
+ * 中斷中執行，此時紀錄已不受斷電影響。
+ */
+
+#ifndef EE_PARAM_H
+#define EE_PARAM_H
+
+#include "c4mlib.h"
+#include "ee_queue.h"
+
+#if EEPARAM_BASE + 2 * EEPARAM_BANK_SZ > E2END + 1
+#    error "EEPARAM bank exceeds EEPROM size"
+#endif
+
+#if EEPARAM_KEY_NUM < 1 || EEPARAM_KEY_NUM > 255
+#    error "EEPARAM_KEY_NUM must be between 1 and 255"
+#endif
+
+/* 附加一筆紀錄需要 EEPARAM_MAX_LEN + 3 位元組再加上結尾的 0xFF */
+#if EEPARAM_MAX_LEN < 1 || EEPARAM_MAX_LEN + 4 > EEQUEUE_DATA_SZ
+#    error "EEPARAM_MAX_LEN + 4 must fit in EEQUEUE_DATA_SZ"
+#endif
+
+#define EEPARAM_NONE 0xFFFF  ///< 索引中尚未儲存的 key @ingroup eeparam_macro
+
+#define EEPARAM_ST_IDLE 0  ///< 沒有進行壓縮 @ingroup eeparam_macro
+#define EEPARAM_ST_COPY 1  ///< 正在複製紀錄 @ingroup eeparam_macro
+#define EEPARAM_ST_TERM 2  ///< 正在寫入結尾 @ingroup eeparam_macro
+#define EEPARAM_ST_HEAD 3  ///< 正在寫入 bank 標頭 @ingroup eeparam_macro
+
+/**
+ * @brief EeParam 結構原型
+ * @ingroup eeparam_struct
+ *
+ * Addr、Len 為 RAM 索引，Addr 指向 key 最新紀錄的起始位址。壓縮期間
+ * 觸發壓縮的那一筆參數暫存於 Pend，複製到新 bank 時才寫入。
+ */
+typedef struct {
+    EeQueueStr_t* Queue_p;            ///< 寫入使用的 EeQueue。
+    uint16_t Addr[EEPARAM_KEY_NUM];   ///< 各 key 最新紀錄位址。
+    uint8_t Len[EEPARAM_KEY_NUM];     ///< 各 key 資料長度。
+    uint16_t Tail;                    ///< 下一筆紀錄的位址。
+    uint16_t Live;                    ///< 有效紀錄的總位元組數。
+    uint8_t Bank;                     ///< 目前有效的 bank 編號。
+    uint8_t Gen;                      ///< 目前有效 bank 的世代。
+    uint8_t State;                    ///< 壓縮狀態。
+    uint8_t CopyKey;                  ///< 下一個要複製的 key。
+    uint16_t NewTail;                 ///< 新 bank 的下一筆紀錄位址。
+    uint8_t PendKey;                  ///< 觸發壓縮的參數 key。
+    uint8_t PendLen;                  ///< 觸發壓縮的參數長度。
+    uint8_t Pend[EEPARAM_MAX_LEN];    ///< 觸發壓縮的參數資料。
+    Func_t PendFunc_p;                ///< 觸發壓縮的參數完成時執行函式。
+    void* PendFuncPara_p;             ///< 完成時執行函式之傳參。
+} EeParamStr_t;
+
+/**
+ * @brief 掃描 EEPROM 建立索引。
+ *
+ * @ingroup eeparam_func
+ * @param Str_p   EeParam 結構指標。
+ * @param Queue_p 已初始化的 EeQueue 結構指標。
+ * @return uint8_t 錯誤代碼：
+ *   - 0：成功無誤。
+ *   - 1：沒有有效的 bank，已排入格式化。
+ *
+ * 開機時呼叫一次，最多讀取 4 + EEPARAM_BANK_SZ 個位元組。掃描至結尾
+ * 0xFF 或第一筆格式、Chk 不符的紀錄為止，之後的附加會從該處開始。
+ */
+uint8_t EeParam_net(EeParamStr_t* Str_p, EeQueueStr_t* Queue_p);
+
+/**
+ * @brief 附加一筆參數紀錄。
+ *
+ * @ingroup eeparam_func
+ * @param Str_p      EeParam 結構指標。
+ * @param Key        參數 key。
+ * @param Data_p     資料指標，呼叫返回後即可重複使用。
+ * @param Bytes      資料大小。
+ * @param Func_p     紀錄寫入完成時執行函式，於中斷中執行，可為 NULL。
+ * @param FuncPara_p 完成時執行函式之傳參。
+ * @return uint8_t 錯誤代碼：
+ *   - 0：成功無誤。
+ *   - 1：參數 Key 超出範圍。
+ *   - 2：EeQueue 空間不足，請稍後再試。
+ *   - 3：正在壓縮，請稍後再試。
+ *   - 4：參數 Bytes 為0或大於 EEPARAM_MAX_LEN。
+ *   - 5：所有參數的最新紀錄已超過一個 bank 的容量。
+ *
+ * 日誌空間不足時開始壓縮並回傳 0，這一筆會隨壓縮寫入新 bank。
+ */
+uint8_t EeParam_set(EeParamStr_t* Str_p, uint8_t Key, const void* Data_p,
+                    uint8_t Bytes, Func_t Func_p, void* FuncPara_p);
+
+/**
+ * @brief 讀取參數。
+ *
+ * @ingroup eeparam_func
+ * @param Str_p  EeParam 結構指標。
+ * @param Key    參數 key。
+ * @param Data_p 資料指標。
+ * @param Bytes  資料大小，須與儲存時相同。
+ * @return uint8_t 錯誤代碼：
+ *   - 0：成功無誤。
+ *   - 1：參數 Key 超出範圍。
+ *   - 2：參數尚未儲存。
+ *   - 4：參數 Bytes 與儲存的長度不符。
+ *
+ * 經由 EeQueue_get 讀取，尚未寫入 EEPROM 的紀錄也能讀到最新值。
+ */
+uint8_t EeParam_get(EeParamStr_t* Str_p, uint8_t Key, void* Data_p,
+                    uint8_t Bytes);
+
+/**
+ * @brief 執行背景壓縮，請在主迴圈中持續呼叫。
+ *
+ * @ingroup eeparam_func
+ *
+ * 沒有進行壓縮或 EEPROM 正在寫入時立即返回，否則在 EeQueue 還有空間時
+ * 持續把紀錄複製到新 bank，全部排入後切換至新 bank。
+ */
+void EeParam_run(EeParamStr_t* Str_p);
+
+#endif  // EE_PARAM_H
@@ -0,0 +1,167 @@
+/**
+ * @file ee_queue.c
+ * @brief EEPROM 非同步寫入佇列實作。
+ */
+
+#include "ee_queue.h"
+
+#define REQ_MASK  (EEQUEUE_REQ_SZ - 1)
+#define DATA_MASK (EEQUEUE_DATA_SZ - 1)
+
+/* 填寫請求欄位並排入佇列，資料須已放入 Data 緩衝區 */
+static void EeQueue_queue(EeQueueStr_t* Str_p, uint16_t Address,
+                          uint8_t Bytes, Func_t Func_p, void* FuncPara_p) {
+    EeQueueReqStr_t* req_p = &Str_p->Req[Str_p->ReqHead & REQ_MASK];
+    uint8_t sreg;
+
+    req_p->Address    = Address;
+    req_p->Bytes      = Bytes;
+    req_p->Offset     = Str_p->DataHead;
+    req_p->Func_p     = Func_p;
+    req_p->FuncPara_p = FuncPara_p;
+
+    sreg = SREG;
+    cli();
+    Str_p->DataHead += Bytes;
+    Str_p->ReqHead++;
+    EECR |= (1 << EERIE);
+    SREG = sreg;
+}
+
+void EeQueue_net(EeQueueStr_t* Str_p) {
+    EECR &= ~(1 << EERIE);
+    Str_p->ReqHead  = 0;
+    Str_p->ReqTail  = 0;
+    Str_p->DataHead = 0;
+    Str_p->DataTail = 0;
+    Str_p->Index    = 0;
+    Str_p->Written  = 0;
+    Str_p->Skipped  = 0;
+}
+
+uint8_t EeQueue_set(EeQueueStr_t* Str_p, uint16_t Address, uint8_t Bytes,
+                    const void* Data_p, Func_t Func_p, void* FuncPara_p) {
+    uint8_t head = Str_p->DataHead;
+
+    if (Bytes == 0 || Bytes > EEQUEUE_DATA_SZ ||
+        (uint32_t)Address + Bytes > (uint32_t)E2END + 1) {
+        return 4;
+    }
+    if ((uint8_t)(Str_p->ReqHead - Str_p->ReqTail) >= EEQUEUE_REQ_SZ) {
+        return 2;
+    }
+    if (Bytes > EEQUEUE_DATA_SZ - (uint8_t)(head - Str_p->DataTail)) {
+        return 3;
+    }
+
+    for (uint8_t i = 0; i < Bytes; i++) {
+        Str_p->Data[(uint8_t)(head + i) & DATA_MASK] =
+            ((const uint8_t*)Data_p)[i];
+    }
+    EeQueue_queue(Str_p, Address, Bytes, Func_p, FuncPara_p);
+    return 0;
+}
+
+uint8_t EeQueue_barrier(EeQueueStr_t* Str_p, Func_t Func_p, void* FuncPara_p) {
+    if ((uint8_t)(Str_p->ReqHead - Str_p->ReqTail) >= EEQUEUE_REQ_SZ) {
+        return 2;
+    }
+    EeQueue_queue(Str_p, 0, 0, Func_p, FuncPara_p);
+    return 0;
+}
+
+uint8_t EeQueue_hasSpace(EeQueueStr_t* Str_p, uint8_t ReqNum,
+                         uint16_t Bytes) {
+    uint8_t reqs  = Str_p->ReqHead - Str_p->ReqTail;
+    uint8_t bytes = Str_p->DataHead - Str_p->DataTail;
+
+    return ReqNum <= EEQUEUE_REQ_SZ - reqs && Bytes <= EEQUEUE_DATA_SZ - bytes;
+}
+
+uint8_t EeQueue_isIdle(EeQueueStr_t* Str_p) {
+    return Str_p->ReqTail == Str_p->ReqHead && !(EECR & (1 << EEWE));
+}
+
+void EeQueue_flush(EeQueueStr_t* Str_p) {
+    while (!EeQueue_isIdle(Str_p)) {
+    }
+}
+
+void EeQueue_get(EeQueueStr_t* Str_p, uint16_t Address, uint8_t Bytes,
+                 void* Data_p) {
+    uint8_t* data_p = (uint8_t*)Data_p;
+    EeQueueReqStr_t* req_p;
+    uint16_t first;
+    uint16_t last;
+    uint8_t sreg;
+
+    /* 寫入進行中無法讀取，開著中斷等待，以免延遲其他中斷 */
+    for (;;) {
+        sreg = SREG;
+        cli();
+        if (!(EECR & (1 << EEWE))) {
+            break;
+        }
+        SREG = sreg;
+    }
+
+    for (uint8_t i = 0; i < Bytes; i++) {
+        EEAR = Address + i;
+        EECR |= (1 << EERE);
+        data_p[i] = EEDR;
+    }
+
+    /* 依排入順序覆蓋，較晚的請求優先 */
+    for (uint8_t r = Str_p->ReqTail; r != Str_p->ReqHead; r++) {
+        req_p = &Str_p->Req[r & REQ_MASK];
+        first = (req_p->Address > Address) ? req_p->Address : Address;
+        last  = req_p->Address + req_p->Bytes;
+        if (last > Address + Bytes) {
+            last = Address + Bytes;
+        }
+        for (uint16_t a = first; a < last; a++) {
+            data_p[a - Address] =
+                Str_p->Data[(uint8_t)(req_p->Offset + (a - req_p->Address)) &
+                            DATA_MASK];
+        }
+    }
+    SREG = sreg;
+}
+
+void EeQueue_step(void* void_p) {
+    EeQueueStr_t* Str_p = (EeQueueStr_t*)void_p;
+    EeQueueReqStr_t* req_p;
+    Func_t func_p;
+    void* para_p;
+    uint8_t data;
+
+    while (Str_p->ReqTail != Str_p->ReqHead) {
+        req_p = &Str_p->Req[Str_p->ReqTail & REQ_MASK];
+        while (Str_p->Index < req_p->Bytes) {
+            data = Str_p->Data[(uint8_t)(req_p->Offset + Str_p->Index) &
+                               DATA_MASK];
+            EEAR = req_p->Address + Str_p->Index;
+            Str_p->Index++;
+            EECR |= (1 << EERE);
+            if (EEDR != data) {
+                EEDR = data;
+                EECR |= (1 << EEMWE);
+                EECR |= (1 << EEWE);
+                Str_p->Written++;
+                return;
+            }
+            Str_p->Skipped++;
+        }
+
+        /* 最後一個位元組已寫入完成，先釋放請求再呼叫執行函式 */
+        func_p = req_p->Func_p;
+        para_p = req_p->FuncPara_p;
+        Str_p->Index = 0;
+        Str_p->DataTail += req_p->Bytes;
+        Str_p->ReqTail++;
+        if (func_p != NULL) {
+            func_p(para_p);
+        }
+    }
+    EECR &= ~(1 << EERIE);
+}
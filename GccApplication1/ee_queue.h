@@ -0,0 +1,162 @@
+/**
+ * @file ee_queue.h
+ * @brief EEPROM 非同步寫入佇列。
+ *
+ * EEPROM_set 逐位元組同步寫入，每個位元組約 8.5 ms，寫入 32 位元組的
+ * 校正資料會讓主迴圈停頓約 0.27 秒。EeQueue 將寫入請求複製到佇列後立即
+ * 返回，由 EE_READY 中斷逐位元組寫入；寫入前先讀出原內容，相同的位元組
+ * 直接略過，不消耗時間也不增加 EEPROM 損耗。
+ *
+ * EE_READY 沒有對應的 *IntStr_t，請在 ISR 中直接呼叫 EeQueue_step：
+ *
+ *   EeQueueStr_t EeQueue_str;
+ *   ISR(EE_READY_vect) {
+ *       EeQueue_step(&EeQueue_str);
+ *   }
+ *
+ * 或在 interrupt.cfg 中定義
+ * EE_READY_STATIC_FB(FB) FB(EeQueue_step, &EeQueue_str) 交由 static_isr.h
+ * 產生。使用佇列期間不可再呼叫 EEPROM_set，讀取請改用 EeQueue_get，
+ * 才能取得尚未寫入的資料。
+ */
+
+#ifndef EE_QUEUE_H
+#define EE_QUEUE_H
+
+#include "c4mlib.h"
+
+#if EEQUEUE_REQ_SZ < 2 || EEQUEUE_REQ_SZ > 128 || \
+    (EEQUEUE_REQ_SZ & (EEQUEUE_REQ_SZ - 1))
+#    error "EEQUEUE_REQ_SZ must be a power of two between 2 and 128"
+#endif
+
+#if EEQUEUE_DATA_SZ < 2 || EEQUEUE_DATA_SZ > 128 || \
+    (EEQUEUE_DATA_SZ & (EEQUEUE_DATA_SZ - 1))
+#    error "EEQUEUE_DATA_SZ must be a power of two between 2 and 128"
+#endif
+
+/**
+ * @brief EEPROM 寫入請求
+ * @ingroup eequeue_struct
+ */
+typedef struct {
+    uint16_t Address;  ///< EEPROM 起始位址。
+    uint8_t Bytes;     ///< 位元組數，0 為 EeQueue_barrier 的屏障請求。
+    uint8_t Offset;    ///< 資料在 Data 緩衝區中的起始計數。
+    Func_t Func_p;     ///< 寫入完成時執行函式，可為 NULL。
+    void* FuncPara_p;  ///< 寫入完成時執行函式之傳參。
+} EeQueueReqStr_t;
+
+/**
+ * @brief EeQueue 結構原型
+ * @ingroup eequeue_struct
+ *
+ * ReqHead、DataHead 由主程式更新，ReqTail、DataTail、Index 由中斷更新，
+ * 皆為自由計數，以遮罩取得陣列索引。
+ */
+typedef struct {
+    EeQueueReqStr_t Req[EEQUEUE_REQ_SZ];  ///< 寫入請求佇列。
+    uint8_t Data[EEQUEUE_DATA_SZ];        ///< 待寫入資料緩衝區。
+    volatile uint8_t ReqHead;             ///< 請求寫入計數。
+    volatile uint8_t ReqTail;             ///< 請求完成計數。
+    volatile uint8_t DataHead;            ///< 資料寫入計數。
+    volatile uint8_t DataTail;            ///< 資料釋放計數。
+    volatile uint8_t Index;               ///< 目前請求已處理的位元組數。
+    volatile uint16_t Written;            ///< 實際寫入的位元組數。
+    volatile uint16_t Skipped;            ///< 內容相同而略過的位元組數。
+} EeQueueStr_t;
+
+/**
+ * @brief 初始化 EeQueue，清空佇列並關閉 EE_READY 中斷。
+ * @ingroup eequeue_func
+ */
+void EeQueue_net(EeQueueStr_t* Str_p);
+
+/**
+ * @brief 排入一筆 EEPROM 寫入。
+ *
+ * @ingroup eequeue_func
+ * @param Str_p      EeQueue 結構指標。
+ * @param Address    要寫入的 EEPROM 位址。
+ * @param Bytes      資料大小。
+ * @param Data_p     資料指標，資料會被複製，呼叫返回後即可重複使用。
+ * @param Func_p     全部位元組寫入完成時執行函式，於中斷中執行，可為 NULL。
+ * @param FuncPara_p 完成時執行函式之傳參。
+ * @return uint8_t 錯誤代碼：
+ *   - 0：成功無誤。
+ *   - 2：請求佇列已滿。
+ *   - 3：資料緩衝區空間不足。
+ *   - 4：參數 Bytes 為0或大於 EEQUEUE_DATA_SZ，或位址超出 EEPROM 範圍。
+ *
+ * 只能由主程式呼叫。同一位址的多筆寫入依排入順序完成。
+ */
+uint8_t EeQueue_set(EeQueueStr_t* Str_p, uint16_t Address, uint8_t Bytes,
+                    const void* Data_p, Func_t Func_p, void* FuncPara_p);
+
+/**
+ * @brief 查詢佇列是否還能排入指定數量的請求與資料。
+ *
+ * @ingroup eequeue_func
+ * @param Str_p  EeQueue 結構指標。
+ * @param ReqNum 請求數。
+ * @param Bytes  資料位元組總數。
+ * @return uint8_t 1 表示空間足夠。
+ */
+uint8_t EeQueue_hasSpace(EeQueueStr_t* Str_p, uint8_t ReqNum,
+                         uint16_t Bytes);
+
+/**
+ * @brief 排入屏障，先前排入的寫入全部完成後執行 Func_p。
+ *
+ * @ingroup eequeue_func
+ * @return uint8_t 錯誤代碼：
+ *   - 0：成功無誤。
+ *   - 2：請求佇列已滿。
+ */
+uint8_t EeQueue_barrier(EeQueueStr_t* Str_p, Func_t Func_p, void* FuncPara_p);
+
+/**
+ * @brief 等待佇列中所有寫入完成。
+ *
+ * @ingroup eequeue_func
+ *
+ * 會阻塞至最後一個位元組寫入結束，不可在中斷中或關閉中斷時呼叫。
+ */
+void EeQueue_flush(EeQueueStr_t* Str_p);
+
+/**
+ * @brief 查詢佇列是否已全部寫入完成。
+ *
+ * @ingroup eequeue_func
+ * @return uint8_t 1 表示已無待寫入資料。
+ */
+uint8_t EeQueue_isIdle(EeQueueStr_t* Str_p);
+
+/**
+ * @brief 讀取 EEPROM，尚在佇列中的資料以佇列內容為準。
+ *
+ * @ingroup eequeue_func
+ * @param Str_p   EeQueue 結構指標。
+ * @param Address 要讀取的EEPROM位址。
+ * @param Bytes   資料大小。
+ * @param Data_p  資料指標。
+ *
+ * 等待目前的位元組寫入結束後，在關閉中斷下讀出 EEPROM 並依排入順序
+ * 覆蓋佇列中的待寫入資料，結果與全部寫入完成後再讀取相同。
+ */
+void EeQueue_get(EeQueueStr_t* Str_p, uint16_t Address, uint8_t Bytes,
+                 void* Data_p);
+
+/**
+ * @brief 寫入下一個內容不同的位元組，須在 EE_READY 中斷中執行。
+ *
+ * @ingroup eequeue_func
+ * @param void_p EeQueue 結構指標。
+ *
+ * 每次中斷最多啟動一個位元組的寫入，內容相同的位元組只讀取不寫入。
+ * 請求的最後一個位元組寫入完成後釋放其資料並呼叫 Func_p，佇列清空時
+ * 關閉 EE_READY 中斷。
+ */
+void EeQueue_step(void* void_p);
+
+#endif  // EE_QUEUE_H
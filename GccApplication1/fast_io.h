@@ -0,0 +1,356 @@
+/**
+ * @file fast_io.h
+ * @brief 編譯期展開的 DIO / EXT / ADC 旗標讀寫。
+ *
+ * DIO_fpt、DIO_fgt 等函式於執行期依 LSByte 查表，再對暫存器做讀改寫，
+ * 一次設定單一位元需數十個週期。本檔提供同參數的巨集 DIO_FPT、DIO_FGT、
+ * EXT_FPT、EXT_FGT、ADC_FPT、ADC_FGT：當 LSByte、Mask、Shift 皆為編譯期
+ * 常數時直接展開為暫存器存取，否則呼叫原本的函式。
+ *
+ * 常數展開時：
+ *   - 單一位元遮罩對 I/O 位址 0x00~0x1F 的暫存器(PORTA~E、DDRA~E、
+ *     PINA~E)展開為 SBI / CBI，讀取展開為 SBIS / SBIC。
+ *   - Mask 為 0xFF 且 Shift 為 0 時展開為一次 OUT / IN。
+ *   - 其他情形展開為一次讀改寫(IN、ANDI、ORI、OUT)。
+ *
+ * 常數展開不檢查輸出入方向，不會回傳錯誤代碼 6。ADC_FPT 的 LSByte
+ * 200~202 為 ADMUX、ADCSRA、DDRF，其中 DDRF 位於延伸 I/O 位址，單一位元
+ * 也展開為讀改寫(LDS、STS)；ADC_FGT 同 ADC_fgt 只接受 201(ADCSRA)。
+ *
+ * 其他沒有 LSByte 對照的暫存器，可以 REGFPT_FAST、REGFGT_FAST 直接傳入
+ * 暫存器名稱。
+ */
+
+#ifndef FAST_IO_H
+#define FAST_IO_H
+
+#include "c4mlib.h"
+
+/**
+ * @def FASTIO_IS_CONST(LSByte, Mask, Shift)
+ * @ingroup fastio_macro
+ * @brief 判斷三個參數是否皆為編譯期常數。
+ */
+#define FASTIO_IS_CONST(LSByte, Mask, Shift)                   \
+    (__builtin_constant_p(LSByte) && __builtin_constant_p(Mask) && \
+     __builtin_constant_p(Shift))
+
+/**
+ * @brief 依照 Mask、Shift 寫入暫存器，單一位元時展開為 SBI / CBI。
+ *
+ * @ingroup fastio_func
+ * @param Reg_p 暫存器指標，須為常數位址。
+ * @param Mask  遮罩。
+ * @param Shift 向左位移。
+ * @param Data  寫入資料。
+ */
+static inline __attribute__((always_inline)) void RegFast_fpt(
+    volatile uint8_t* Reg_p, uint8_t Mask, uint8_t Shift, uint8_t Data) {
+    if (Mask == 0xFF && Shift == 0) {
+        *Reg_p = Data;
+    }
+    else if ((Mask & (Mask - 1)) == 0) {
+        if ((uint8_t)(Data << Shift) & Mask) {
+            *Reg_p |= Mask;
+        }
+        else {
+            *Reg_p &= (uint8_t)~Mask;
+        }
+    }
+    else {
+        *Reg_p = (*Reg_p & (uint8_t)~Mask) | ((uint8_t)(Data << Shift) & Mask);
+    }
+}
+
+/**
+ * @brief 依照 Mask、Shift 讀取暫存器。
+ *
+ * @ingroup fastio_func
+ * @param Reg_p  暫存器指標，須為常數位址。
+ * @param Mask   遮罩。
+ * @param Shift  向右位移。
+ * @param Data_p 資料指標。
+ */
+static inline __attribute__((always_inline)) void RegFast_fgt(
+    volatile uint8_t* Reg_p, uint8_t Mask, uint8_t Shift, void* Data_p) {
+    if (Mask == 0xFF && Shift == 0) {
+        *(uint8_t*)Data_p = *Reg_p;
+    }
+    else if ((Mask & (Mask - 1)) == 0) {
+        *(uint8_t*)Data_p = (*Reg_p & Mask) ? (Mask >> Shift) : 0;
+    }
+    else {
+        *(uint8_t*)Data_p = (*Reg_p & Mask) >> Shift;
+    }
+}
+
+/**
+ * @def REGFPT_FAST(ADDRESS, MASK, SHIFT, DATA)
+ * @ingroup fastio_macro
+ * @brief 同 REGFPT，單一位元時展開為 SBI / CBI。
+ */
+#define REGFPT_FAST(ADDRESS, MASK, SHIFT, DATA) \
+    RegFast_fpt(&(ADDRESS), MASK, SHIFT, DATA)
+
+/**
+ * @def REGFGT_FAST(ADDRESS, MASK, SHIFT, DATA_P)
+ * @ingroup fastio_macro
+ * @brief 同 REGFGT，單一位元時展開為 SBIS / SBIC。
+ */
+#define REGFGT_FAST(ADDRESS, MASK, SHIFT, DATA_P) \
+    RegFast_fgt(&(ADDRESS), MASK, SHIFT, DATA_P)
+
+/**
+ * @brief 取得 DIO_fpt / EXT_fpt 的 LSByte 對應的暫存器。
+ *
+ * @ingroup fastio_func
+ * @param LSByte 暫存器編號。
+ * @return volatile uint8_t* 暫存器指標，LSByte 錯誤時為 NULL。
+ *
+ * LSByte 0~6 為 PORTA~G，200~206 為 DDRA~G，210~213 為 EIMSK、EICRA、
+ * EICRB、EIFR，與函式庫相同。
+ */
+static inline __attribute__((always_inline)) volatile uint8_t* DioFast_putReg(
+    uint8_t LSByte) {
+    switch (LSByte) {
+        case 0: return &PORTA;
+        case 1: return &PORTB;
+        case 2: return &PORTC;
+        case 3: return &PORTD;
+        case 4: return &PORTE;
+        case 5: return &PORTF;
+        case 6: return &PORTG;
+        case 200: return &DDRA;
+        case 201: return &DDRB;
+        case 202: return &DDRC;
+        case 203: return &DDRD;
+        case 204: return &DDRE;
+        case 205: return &DDRF;
+        case 206: return &DDRG;
+        case 210: return &EIMSK;
+        case 211: return &EICRA;
+        case 212: return &EICRB;
+        case 213: return &EIFR;
+        default: return NULL;
+    }
+}
+
+/**
+ * @brief 取得 DIO_fgt / EXT_fgt 的 LSByte 對應的暫存器。
+ *
+ * @ingroup fastio_func
+ * @param LSByte 暫存器編號。
+ * @return volatile uint8_t* 暫存器指標，LSByte 錯誤時為 NULL。
+ *
+ * LSByte 100~106 為 PINA~G，210~213 同 DioFast_putReg。
+ */
+static inline __attribute__((always_inline)) volatile uint8_t* DioFast_getReg(
+    uint8_t LSByte) {
+    switch (LSByte) {
+        case 100: return &PINA;
+        case 101: return &PINB;
+        case 102: return &PINC;
+        case 103: return &PIND;
+        case 104: return &PINE;
+        case 105: return &PINF;
+        case 106: return &PING;
+        case 210: return &EIMSK;
+        case 211: return &EICRA;
+        case 212: return &EICRB;
+        case 213: return &EIFR;
+        default: return NULL;
+    }
+}
+
+/**
+ * @brief 常數參數的 dio flag put。
+ *
+ * @ingroup fastio_func
+ * @return char 錯誤代碼：
+ *   - 0：成功無誤。
+ *   - 2：參數 LSByte 錯誤。
+ *   - 5：參數 Shift 超出範圍。
+ *
+ * 參數同 DIO_fpt，一般請經由 DIO_FPT 使用。
+ */
+static inline __attribute__((always_inline)) char DioFast_fpt(uint8_t LSByte,
+                                                              uint8_t Mask,
+                                                              uint8_t Shift,
+                                                              uint8_t Data) {
+    volatile uint8_t* reg_p = DioFast_putReg(LSByte);
+
+    if (reg_p == NULL) {
+        return 2;
+    }
+    if (Shift > 7) {
+        return 5;
+    }
+    RegFast_fpt(reg_p, Mask, Shift, Data);
+    return 0;
+}
+
+/**
+ * @brief 常數參數的 dio flag get。
+ *
+ * @ingroup fastio_func
+ * @return char 同 DioFast_fpt。
+ *
+ * 參數同 DIO_fgt，一般請經由 DIO_FGT 使用。
+ */
+static inline __attribute__((always_inline)) char DioFast_fgt(uint8_t LSByte,
+                                                              uint8_t Mask,
+                                                              uint8_t Shift,
+                                                              void* Data_p) {
+    volatile uint8_t* reg_p = DioFast_getReg(LSByte);
+
+    if (reg_p == NULL) {
+        return 2;
+    }
+    if (Shift > 7) {
+        return 5;
+    }
+    RegFast_fgt(reg_p, Mask, Shift, Data_p);
+    return 0;
+}
+
+/**
+ * @def DIO_FPT(LSByte, Mask, Shift, Data)
+ * @ingroup fastio_macro
+ * @brief 參數皆為常數時展開為暫存器存取，否則呼叫 DIO_fpt。
+ */
+#define DIO_FPT(LSByte, Mask, Shift, Data)              \
+    (FASTIO_IS_CONST(LSByte, Mask, Shift)               \
+         ? DioFast_fpt(LSByte, Mask, Shift, Data)       \
+         : DIO_fpt(LSByte, Mask, Shift, Data))
+
+/**
+ * @def DIO_FGT(LSByte, Mask, Shift, Data_p)
+ * @ingroup fastio_macro
+ * @brief 參數皆為常數時展開為暫存器存取，否則呼叫 DIO_fgt。
+ */
+#define DIO_FGT(LSByte, Mask, Shift, Data_p)            \
+    (FASTIO_IS_CONST(LSByte, Mask, Shift)               \
+         ? DioFast_fgt(LSByte, Mask, Shift, Data_p)     \
+         : DIO_fgt(LSByte, Mask, Shift, Data_p))
+
+/**
+ * @brief 取得 ADC_fpt 的 LSByte 對應的暫存器。
+ *
+ * @ingroup fastio_func
+ * @param LSByte 暫存器編號。
+ * @return volatile uint8_t* 暫存器指標，LSByte 錯誤時為 NULL。
+ *
+ * LSByte 200~202 為 ADMUX、ADCSRA、DDRF，與 ADC_fpt 相同。
+ */
+static inline __attribute__((always_inline)) volatile uint8_t* AdcFast_putReg(
+    uint8_t LSByte) {
+    switch (LSByte) {
+        case 200: return &ADMUX;
+        case 201: return &ADCSRA;
+        case 202: return &DDRF;
+        default: return NULL;
+    }
+}
+
+/**
+ * @brief 取得 ADC_fgt 的 LSByte 對應的暫存器。
+ *
+ * @ingroup fastio_func
+ * @param LSByte 暫存器編號。
+ * @return volatile uint8_t* 暫存器指標，LSByte 錯誤時為 NULL。
+ *
+ * ADC_fgt 只接受 LSByte 201(ADCSRA)，200、202 回傳錯誤代碼 2，此處
+ * 保持相同，常數展開與呼叫函式的結果才會一致。
+ */
+static inline __attribute__((always_inline)) volatile uint8_t* AdcFast_getReg(
+    uint8_t LSByte) {
+    return (LSByte == 201) ? &ADCSRA : NULL;
+}
+
+/**
+ * @brief 常數參數的 adc flag put。
+ *
+ * @ingroup fastio_func
+ * @return char 錯誤代碼：
+ *   - 0：成功無誤。
+ *   - 2：參數 LSByte 錯誤。
+ *   - 5：參數 Shift 超出範圍。
+ *
+ * 參數同 ADC_fpt，一般請經由 ADC_FPT 使用。
+ */
+static inline __attribute__((always_inline)) char AdcFast_fpt(uint8_t LSByte,
+                                                              uint8_t Mask,
+                                                              uint8_t Shift,
+                                                              uint8_t Data) {
+    volatile uint8_t* reg_p = AdcFast_putReg(LSByte);
+
+    if (reg_p == NULL) {
+        return 2;
+    }
+    if (Shift > 7) {
+        return 5;
+    }
+    RegFast_fpt(reg_p, Mask, Shift, Data);
+    return 0;
+}
+
+/**
+ * @brief 常數參數的 adc flag get。
+ *
+ * @ingroup fastio_func
+ * @return char 同 AdcFast_fpt。
+ *
+ * 參數同 ADC_fgt，一般請經由 ADC_FGT 使用。
+ */
+static inline __attribute__((always_inline)) char AdcFast_fgt(uint8_t LSByte,
+                                                              uint8_t Mask,
+                                                              uint8_t Shift,
+                                                              void* Data_p) {
+    volatile uint8_t* reg_p = AdcFast_getReg(LSByte);
+
+    if (reg_p == NULL) {
+        return 2;
+    }
+    if (Shift > 7) {
+        return 5;
+    }
+    RegFast_fgt(reg_p, Mask, Shift, Data_p);
+    return 0;
+}
+
+/**
+ * @def ADC_FPT(LSByte, Mask, Shift, Data)
+ * @ingroup fastio_macro
+ * @brief 參數皆為常數時展開為暫存器存取，否則呼叫 ADC_fpt。
+ */
+#define ADC_FPT(LSByte, Mask, Shift, Data)              \
+    (FASTIO_IS_CONST(LSByte, Mask, Shift)               \
+         ? AdcFast_fpt(LSByte, Mask, Shift, Data)       \
+         : ADC_fpt(LSByte, Mask, Shift, Data))
+
+/**
+ * @def ADC_FGT(LSByte, Mask, Shift, Data_p)
+ * @ingroup fastio_macro
+ * @brief 參數皆為常數時展開為暫存器存取，否則呼叫 ADC_fgt。
+ */
+#define ADC_FGT(LSByte, Mask, Shift, Data_p)            \
+    (FASTIO_IS_CONST(LSByte, Mask, Shift)               \
+         ? AdcFast_fgt(LSByte, Mask, Shift, Data_p)     \
+         : ADC_fgt(LSByte, Mask, Shift, Data_p))
+
+/**
+ * @def EXT_FPT(LSByte, Mask, Shift, Data)
+ * @ingroup fastio_macro
+ * @brief 與 DIO_FPT 相同。
+ */
+#define EXT_FPT(LSByte, Mask, Shift, Data) DIO_FPT(LSByte, Mask, Shift, Data)
+
+/**
+ * @def EXT_FGT(LSByte, Mask, Shift, Data_p)
+ * @ingroup fastio_macro
+ * @brief 與 DIO_FGT 相同。
+ */
+#define EXT_FGT(LSByte, Mask, Shift, Data_p) \
+    DIO_FGT(LSByte, Mask, Shift, Data_p)
+
+#endif  // FAST_IO_H
@@ -0,0 +1,157 @@
+/**
+ * @file intfreqwheel.c
+ * @brief 雜湊時間輪式中斷除頻器實作。
+ */
+
+#include "intfreqwheel.h"
+
+#define WHEEL_MASK (IFDW_WHEEL_SZ - 1)
+
+/* 將工作掛到 now + Delay 的格子，Delay 需大於0，須在關閉中斷時呼叫 */
+static void IntFreqWheel_link(IntFreqWheelStr_t* Str_p, uint8_t Id,
+                              uint16_t Delay) {
+    IntFreqWheelISR_t* fb_p = &Str_p->fb[Id];
+    uint8_t slot            = (Str_p->now + Delay) & WHEEL_MASK;
+
+    fb_p->rounds    = (Delay - 1) >> IFDW_WHEEL_BITS;
+    fb_p->slot      = slot;
+    fb_p->next      = Str_p->head[slot];
+    Str_p->head[slot] = Id;
+}
+
+static void IntFreqWheel_unlink(IntFreqWheelStr_t* Str_p, uint8_t Id) {
+    uint8_t slot = Str_p->fb[Id].slot;
+    uint8_t i    = Str_p->head[slot];
+
+    if (i == Id) {
+        Str_p->head[slot] = Str_p->fb[Id].next;
+        return;
+    }
+    while (i != IFDW_NONE) {
+        if (Str_p->fb[i].next == Id) {
+            Str_p->fb[i].next = Str_p->fb[Id].next;
+            return;
+        }
+        i = Str_p->fb[i].next;
+    }
+}
+
+/* 依 Enable 掛上或移除工作，須在關閉中斷且不在走訪中時呼叫 */
+static void IntFreqWheel_apply(IntFreqWheelStr_t* Str_p, uint8_t Id,
+                               uint8_t Enable) {
+    IntFreqWheelISR_t* fb_p = &Str_p->fb[Id];
+
+    if (fb_p->enable == Enable) {
+        return;
+    }
+    if (Enable) {
+        IntFreqWheel_link(Str_p, Id, fb_p->phase ? fb_p->phase : fb_p->cycle);
+    }
+    else {
+        IntFreqWheel_unlink(Str_p, Id);
+    }
+    fb_p->enable = Enable;
+}
+
+void IntFreqWheel_net(IntFreqWheelStr_t* Str_p) {
+    Str_p->total = 0;
+    Str_p->now   = 0;
+    Str_p->busy  = 0;
+    Str_p->pend  = IFDW_NONE;
+    for (uint8_t i = 0; i < IFDW_WHEEL_SZ; i++) {
+        Str_p->head[i] = IFDW_NONE;
+    }
+}
+
+uint8_t IntFreqWheel_reg(IntFreqWheelStr_t* Str_p, Func_t FbFunc_p,
+                         void* FbPara_p, uint16_t cycle, uint16_t phase) {
+    uint8_t id = Str_p->total;
+
+    if (id >= MAX_IFDW_FUNCNUM || cycle == 0 || phase >= cycle) {
+        return IFDW_NONE;
+    }
+    Str_p->fb[id].cycle      = cycle;
+    Str_p->fb[id].phase      = phase;
+    Str_p->fb[id].enable     = 0;
+    Str_p->fb[id].req        = IFDW_REQ_NONE;
+    Str_p->fb[id].func_p     = FbFunc_p;
+    Str_p->fb[id].funcPara_p = FbPara_p;
+    Str_p->fb[id].next       = IFDW_NONE;
+    Str_p->total             = id + 1;
+    return id;
+}
+
+void IntFreqWheel_en(IntFreqWheelStr_t* Str_p, uint8_t Fb_Id, uint8_t enable) {
+    IntFreqWheelISR_t* fb_p;
+    uint8_t sreg;
+
+    if (Fb_Id >= Str_p->total) {
+        return;
+    }
+    fb_p = &Str_p->fb[Fb_Id];
+    enable = enable ? 1 : 0;
+
+    sreg = SREG;
+    cli();
+    if (Str_p->busy) {
+        /* 由工作函式呼叫，記下要求待走訪結束後處理 */
+        if (fb_p->req == IFDW_REQ_NONE) {
+            fb_p->pendNext = Str_p->pend;
+            Str_p->pend    = Fb_Id;
+        }
+        fb_p->req = enable;
+    }
+    else {
+        IntFreqWheel_apply(Str_p, Fb_Id, enable);
+    }
+    SREG = sreg;
+}
+
+void IntFreqWheel_step(IntFreqWheelStr_t* Str_p) {
+    uint8_t slot = (++Str_p->now) & WHEEL_MASK;
+    uint8_t prev = IFDW_NONE;
+    uint8_t i    = Str_p->head[slot];
+
+    Str_p->busy = 1;
+    while (i != IFDW_NONE) {
+        IntFreqWheelISR_t* fb_p = &Str_p->fb[i];
+        uint8_t next            = fb_p->next;
+
+        if (fb_p->rounds) {
+            fb_p->rounds--;
+            prev = i;
+        }
+        else if ((fb_p->cycle & WHEEL_MASK) == 0) {
+            /* 下次到期仍在同一格，原地更新圈數即可 */
+            fb_p->rounds = (fb_p->cycle - 1) >> IFDW_WHEEL_BITS;
+            prev         = i;
+            if (fb_p->req != 0) {
+                fb_p->func_p(fb_p->funcPara_p);
+            }
+        }
+        else {
+            if (prev == IFDW_NONE) {
+                Str_p->head[slot] = next;
+            }
+            else {
+                Str_p->fb[prev].next = next;
+            }
+            IntFreqWheel_link(Str_p, i, fb_p->cycle);
+            if (fb_p->req != 0) {
+                fb_p->func_p(fb_p->funcPara_p);
+            }
+        }
+        i = next;
+    }
+    Str_p->busy = 0;
+
+    /* 處理工作函式中的啟用/關閉要求 */
+    while (Str_p->pend != IFDW_NONE) {
+        IntFreqWheelISR_t* fb_p = &Str_p->fb[Str_p->pend];
+
+        i           = Str_p->pend;
+        Str_p->pend = fb_p->pendNext;
+        IntFreqWheel_apply(Str_p, i, fb_p->req);
+        fb_p->req = IFDW_REQ_NONE;
+    }
+}
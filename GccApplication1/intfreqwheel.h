@@ -0,0 +1,103 @@
+/**
+ * @file intfreqwheel.h
+ * @brief 雜湊時間輪(hashed timing wheel)式中斷除頻器。
+ *
+ * IntFreqDiv_step 每次計數都會走訪全部 MAX_IFD_FUNCNUM 項工作，中斷時間
+ * 隨註冊數量成長。IntFreqWheel 將工作依到期時間掛在 2^IFDW_WHEEL_BITS 格
+ * 的時間輪上，每次計數只走訪當格的工作，週期不大於時間輪格數時當格內
+ * 全為到期工作。函式參數與 IntFreqDiv_net / _reg / _en / _step 相同，
+ * 可直接替換。
+ */
+
+#ifndef INTFREQWHEEL_H
+#define INTFREQWHEEL_H
+
+#include "c4mlib.h"
+
+#define IFDW_WHEEL_SZ (1 << IFDW_WHEEL_BITS)  ///< 時間輪格數 @ingroup interrupt_macro
+#define IFDW_NONE 0xFF                        ///< 無效工作編號 @ingroup interrupt_macro
+#define IFDW_REQ_NONE 0xFF                    ///< 沒有延後的啟用/關閉要求 @ingroup interrupt_macro
+
+#if MAX_IFDW_FUNCNUM > 254
+#    error "MAX_IFDW_FUNCNUM must not exceed 254"
+#endif
+
+/**
+ * @brief 時間輪IFD工作結構
+ * @ingroup interrupt_struct
+ */
+typedef struct {
+    uint16_t cycle;           ///< 計數觸發週期。
+    uint16_t phase;           ///< 計數觸發相位。
+    uint16_t rounds;          ///< 到期前尚需經過的時間輪圈數。
+    uint8_t next;             ///< 同一格中的下一項工作編號。
+    uint8_t slot;             ///< 目前所在的時間輪格。
+    volatile uint8_t enable;  ///< 禁致能控制。
+    uint8_t req;              ///< 走訪中收到的啟用/關閉要求，IFDW_REQ_NONE 為無。
+    uint8_t pendNext;         ///< 延後要求串列中的下一項工作編號。
+    Func_t func_p;            ///< 執行函式指標。
+    void* funcPara_p;         ///< 執行函式之傳參。
+} IntFreqWheelISR_t;
+
+/**
+ * @brief 時間輪IFD管理器結構
+ * @ingroup interrupt_struct
+ */
+typedef struct {
+    uint8_t total;                         ///< 已註冊工作數量。
+    volatile uint16_t now;                 ///< 目前計數值。
+    uint8_t busy;                          ///< IntFreqWheel_step 正在走訪時間輪。
+    uint8_t pend;                          ///< 延後要求串列的第一項工作編號。
+    uint8_t head[IFDW_WHEEL_SZ];           ///< 每一格的第一項工作編號。
+    IntFreqWheelISR_t fb[MAX_IFDW_FUNCNUM];  ///< 所有已註冊工作。
+} IntFreqWheelStr_t;
+
+/**
+ * @brief 初始化時間輪IFD管理器。
+ * @ingroup interrupt_func
+ */
+void IntFreqWheel_net(IntFreqWheelStr_t* Str_p);
+
+/**
+ * @brief 註冊一項工作到時間輪IFD管理器中。
+ *
+ * @ingroup interrupt_func
+ * @param Str_p    時間輪IFD管理器的指標。
+ * @param FbFunc_p 要註冊的函式。
+ * @param FbPara_p 要註冊函式的傳參。
+ * @param cycle    循環週期，需大於0。
+ * @param phase    觸發相位，0~cycle-1。
+ * @return uint8_t 工作編號，註冊已滿或參數錯誤時回傳 IFDW_NONE。
+ *
+ * 工作預設為關閉，以 IntFreqWheel_en 開啟。開啟後第 k 次計數滿足
+ * k % cycle == phase 時觸發(phase 為0時第一次觸發在第 cycle 次計數)。
+ */
+uint8_t IntFreqWheel_reg(IntFreqWheelStr_t* Str_p, Func_t FbFunc_p,
+                         void* FbPara_p, uint16_t cycle, uint16_t phase);
+
+/**
+ * @brief 啟用/關閉指定的工作。
+ *
+ * @ingroup interrupt_func
+ * @param Str_p  時間輪IFD管理器的指標。
+ * @param Fb_Id  工作編號。
+ * @param enable 1:啟用、0:關閉。
+ *
+ * 啟用時由目前計數重新開始計算相位。若編號還沒有被註冊，將不會有任何動作。
+ * 在工作函式中呼叫時，要求延到本次 IntFreqWheel_step 走訪結束後才生效，
+ * 以免改動正在走訪的串列；被關閉的工作在本次計數中即不再執行。
+ */
+void IntFreqWheel_en(IntFreqWheelStr_t* Str_p, uint8_t Fb_Id, uint8_t enable);
+
+/**
+ * @brief 計數一次並執行到期工作。
+ *
+ * @ingroup interrupt_func
+ * @param Str_p 時間輪IFD管理器的指標。
+ *
+ * 可註冊到硬體中斷中。每次只走訪時間輪當格中的工作，
+ * 到期工作會先重新排入下一次到期的格子再執行。
+ */
+void IntFreqWheel_step(IntFreqWheelStr_t* Str_p);
+
+#endif  // INTFREQWHEEL_H
@@ -0,0 +1,92 @@
+/**
+ * @file isr_prof.c
+ * @brief 中斷執行時間量測實作，ISRPROF_EN 為0時不編譯任何內容。
+ */
+
+#include "isr_prof.h"
+
+#if ISRPROF_EN
+
+#define ISRPROF_STR(X) #X
+#define ISRPROF_XSTR(X) ISRPROF_STR(X)
+#define ISRPROF_FIELD "ui16x" ISRPROF_XSTR(ISRPROF_MAX_NUM)
+
+IsrProfStatStr_t IsrProf_table[ISRPROF_MAX_NUM];
+
+void IsrProf_clear(void) {
+    uint8_t sreg = SREG;
+    cli();
+    for (uint8_t i = 0; i < ISRPROF_MAX_NUM; i++) {
+        IsrProf_table[i].Min   = 0xFFFF;
+        IsrProf_table[i].Max   = 0;
+        IsrProf_table[i].Sum   = 0;
+        IsrProf_table[i].Count = 0;
+    }
+    SREG = sreg;
+}
+
+void IsrProf_init(void) {
+#    if ISRPROF_TIMER == 1
+    TCCR1A = 0;
+    TCCR1B = 1;
+#    else
+    TCCR3A = 0;
+    TCCR3B = 1;
+#    endif
+    IsrProf_clear();
+}
+
+void IsrProf_record(uint8_t Id, uint16_t Ticks) {
+    IsrProfStatStr_t* stat_p = &IsrProf_table[Id];
+
+    if (stat_p->Count == 0xFFFF) {
+        return;
+    }
+    if (Ticks < stat_p->Min) {
+        stat_p->Min = Ticks;
+    }
+    if (Ticks > stat_p->Max) {
+        stat_p->Max = Ticks;
+    }
+    stat_p->Sum += Ticks;
+    stat_p->Count++;
+}
+
+char IsrProf_put(void) {
+    IsrProfDumpStr_t dump;
+    uint8_t sreg;
+
+    for (uint8_t i = 0; i < ISRPROF_MAX_NUM; i++) {
+        IsrProfStatStr_t stat;
+        sreg = SREG;
+        cli();
+        stat = IsrProf_table[i];
+        SREG = sreg;
+
+        dump.Min[i]   = stat.Count ? stat.Min : 0;
+        dump.Max[i]   = stat.Max;
+        dump.Avg[i]   = stat.Count ? (uint16_t)(stat.Sum / stat.Count) : 0;
+        dump.Count[i] = stat.Count;
+    }
+    return HMI_put_struct(ISRPROF_FIELD "," ISRPROF_FIELD "," ISRPROF_FIELD
+                                        "," ISRPROF_FIELD,
+                          sizeof(dump), &dump);
+}
+
+void* IsrProf_link(IsrProfFbStr_t* Fb_p, Func_t Func_p, void* FuncPara_p,
+                   uint8_t Id) {
+    Fb_p->Func_p     = Func_p;
+    Fb_p->FuncPara_p = FuncPara_p;
+    Fb_p->Id         = Id;
+    return Fb_p;
+}
+
+void IsrProf_step(void* void_p) {
+    IsrProfFbStr_t* Fb_p = (IsrProfFbStr_t*)void_p;
+    uint16_t start       = ISRPROF_TCNT;
+
+    Fb_p->Func_p(Fb_p->FuncPara_p);
+    IsrProf_record(Fb_p->Id, (uint16_t)(ISRPROF_TCNT - start));
+}
+
+#endif  // ISRPROF_EN
@@ -0,0 +1,134 @@
+/**
+ * @file isr_prof.h
+ * @brief 中斷分派器與執行函式的執行時間量測。
+ *
+ * 以自由計數的16位元計時器(Timer1 或 Timer3，不除頻)記錄進入與離開時間，
+ * 每個量測項目保留最小、最大、累計時間與次數，可透過 HMI_put_struct
+ * 發送給PC端繪圖。interrupt.cfg 中 ISRPROF_EN 為0時，所有量測巨集
+ * 皆展開為空或原本的函式與傳參，不產生任何程式碼。
+ *
+ * 量測分派器時，在自訂 ISR 中包住對應的 *_step：
+ *
+ *   ISR(TIMER2_COMP_vect) {
+ *       ISRPROF_BEGIN(0);
+ *       TimInt_step(&TimInt2_str);
+ *       ISRPROF_END(0);
+ *   }
+ *
+ * 量測單一註冊函式時，以 ISRPROF_FUNC / ISRPROF_PARA 包住註冊參數：
+ *
+ *   ISRPROF_FB_DECL(Led_prof);
+ *   TimInt_reg(&TimInt2_str, ISRPROF_FUNC(Led_step),
+ *              ISRPROF_PARA(&Led_prof, Led_step, &Led_str, 1));
+ */
+
+#ifndef ISR_PROF_H
+#define ISR_PROF_H
+
+#include "c4mlib.h"
+
+#if ISRPROF_TIMER == 1
+#    define ISRPROF_TCNT TCNT1  ///< 時間基準計數器 @ingroup isrprof_macro
+#elif ISRPROF_TIMER == 3
+#    define ISRPROF_TCNT TCNT3  ///< 時間基準計數器 @ingroup isrprof_macro
+#else
+#    error "ISRPROF_TIMER must be 1 or 3"
+#endif
+
+/**
+ * @brief 量測項目統計結構
+ * @ingroup isrprof_struct
+ */
+typedef struct {
+    uint16_t Min;    ///< 最短執行時間，單位為 CPU 週期。
+    uint16_t Max;    ///< 最長執行時間。
+    uint32_t Sum;    ///< 累計執行時間。
+    uint16_t Count;  ///< 量測次數，達 0xFFFF 後停止累計。
+} IsrProfStatStr_t;
+
+/**
+ * @brief 發送給 HMI 的量測結果結構
+ * @ingroup isrprof_struct
+ */
+typedef struct {
+    uint16_t Min[ISRPROF_MAX_NUM];
+    uint16_t Max[ISRPROF_MAX_NUM];
+    uint16_t Avg[ISRPROF_MAX_NUM];
+    uint16_t Count[ISRPROF_MAX_NUM];
+} IsrProfDumpStr_t;
+
+/**
+ * @brief 被量測的註冊函式結構
+ * @ingroup isrprof_struct
+ */
+typedef struct {
+    Func_t Func_p;     ///< 原本的執行函式。
+    void* FuncPara_p;  ///< 原本的傳參。
+    uint8_t Id;        ///< 量測項目編號。
+} IsrProfFbStr_t;
+
+#if ISRPROF_EN
+
+extern IsrProfStatStr_t IsrProf_table[ISRPROF_MAX_NUM];
+
+/**
+ * @brief 初始化計時器與統計表。
+ * @ingroup isrprof_func
+ */
+void IsrProf_init(void);
+
+/**
+ * @brief 記錄一次量測結果。
+ * @ingroup isrprof_func
+ */
+void IsrProf_record(uint8_t Id, uint16_t Ticks);
+
+/**
+ * @brief 清除統計表。
+ * @ingroup isrprof_func
+ */
+void IsrProf_clear(void);
+
+/**
+ * @brief 將統計表換算平均值後以 HMI_put_struct 發送。
+ *
+ * @ingroup isrprof_func
+ * @return char 同 HMI_put_struct 錯誤代碼。
+ */
+char IsrProf_put(void);
+
+/**
+ * @brief 設定被量測的註冊函式結構，並回傳其指標作為註冊傳參。
+ * @ingroup isrprof_func
+ */
+void* IsrProf_link(IsrProfFbStr_t* Fb_p, Func_t Func_p, void* FuncPara_p,
+                   uint8_t Id);
+
+/**
+ * @brief 量測並執行原本的註冊函式，由 ISRPROF_FUNC 取代原函式註冊。
+ * @ingroup isrprof_func
+ */
+void IsrProf_step(void* Fb_p);
+
+#    define ISRPROF_BEGIN(ID) uint16_t isrprof_t_##ID = ISRPROF_TCNT
+#    define ISRPROF_END(ID) \
+        IsrProf_record(ID, (uint16_t)(ISRPROF_TCNT - isrprof_t_##ID))
+#    define ISRPROF_FB_DECL(NAME) IsrProfFbStr_t NAME
+#    define ISRPROF_FUNC(FUNC) IsrProf_step
+#    define ISRPROF_PARA(FB_P, FUNC, PARA, ID) \
+        IsrProf_link(FB_P, (Func_t)(FUNC), PARA, ID)
+
+#else
+
+#    define IsrProf_init()
+#    define IsrProf_clear()
+#    define IsrProf_put() 0
+#    define ISRPROF_BEGIN(ID)
+#    define ISRPROF_END(ID)
+#    define ISRPROF_FB_DECL(NAME)
+#    define ISRPROF_FUNC(FUNC) (FUNC)
+#    define ISRPROF_PARA(FB_P, FUNC, PARA, ID) (PARA)
+
+#endif  // ISRPROF_EN
+
+#endif  // ISR_PROF_H
@@ -0,0 +1,197 @@
+/**
+ * @file reg_shadow.c
+ * @brief 遠端暫存器影子快取實作。
+ */
+
+#include "reg_shadow.h"
+
+static char RegShadow_read(RegShadowStr_t* Str_p, RegShadowEntryStr_t* e_p) {
+    uint8_t data;
+    char res;
+
+    switch (e_p->Bus) {
+        case REGSHADOW_BUS_TWI:
+            res = TWIM_rec(e_p->Mode, e_p->Id, e_p->RRegAdd, 1, &data,
+                           Str_p->WaitTick);
+            break;
+        case REGSHADOW_BUS_UART:
+            res = UARTM_rec(e_p->Mode, e_p->Id, e_p->RRegAdd, 1, &data,
+                            Str_p->WaitTick);
+            break;
+        default:
+            res = ASA_SPIM_rec(e_p->Mode, e_p->Id, e_p->RRegAdd, 1, &data,
+                               Str_p->WaitTick);
+            break;
+    }
+    if (res == 0) {
+        e_p->Value = data;
+        e_p->Flags = REGSHADOW_VALID;
+    }
+    return res;
+}
+
+static char RegShadow_write(RegShadowStr_t* Str_p, RegShadowEntryStr_t* e_p) {
+    uint8_t data = e_p->Value;
+    char res;
+
+    switch (e_p->Bus) {
+        case REGSHADOW_BUS_TWI:
+            res = TWIM_trm(e_p->Mode, e_p->Id, e_p->WRegAdd, 1, &data,
+                           Str_p->WaitTick);
+            break;
+        case REGSHADOW_BUS_UART:
+            res = UARTM_trm(e_p->Mode, e_p->Id, e_p->WRegAdd, 1, &data,
+                            Str_p->WaitTick);
+            break;
+        default:
+            res = ASA_SPIM_trm(e_p->Mode, e_p->Id, e_p->WRegAdd, 1, &data,
+                               Str_p->WaitTick);
+            break;
+    }
+    if (res == 0) {
+        e_p->Flags &= ~REGSHADOW_DIRTY;
+    }
+    return res;
+}
+
+static RegShadowEntryStr_t* RegShadow_find(RegShadowStr_t* Str_p, uint8_t Bus,
+                                           uint8_t Id, uint8_t RRegAdd) {
+    for (uint8_t i = 0; i < Str_p->Count; i++) {
+        RegShadowEntryStr_t* e_p = &Str_p->Entry_p[i];
+        if (e_p->Bus == Bus && e_p->Id == Id && e_p->RRegAdd == RRegAdd) {
+            return e_p;
+        }
+    }
+    return NULL;
+}
+
+/* 找出或新增影子暫存器並確保影子值有效 */
+static char RegShadow_get(RegShadowStr_t* Str_p, uint8_t Bus, uint8_t Mode,
+                          uint8_t Id, uint8_t RRegAdd,
+                          RegShadowEntryStr_t** e_pp) {
+    RegShadowEntryStr_t* e_p;
+
+    if (Bus > REGSHADOW_BUS_SPI) {
+        return 5;
+    }
+    e_p = RegShadow_find(Str_p, Bus, Id, RRegAdd);
+    if (e_p == NULL) {
+        if (Str_p->Count >= Str_p->Total) {
+            return 6;
+        }
+        e_p          = &Str_p->Entry_p[Str_p->Count++];
+        e_p->Bus     = Bus;
+        e_p->Id      = Id;
+        e_p->RRegAdd = RRegAdd;
+        e_p->WRegAdd = RRegAdd;
+        e_p->Flags   = 0;
+    }
+    e_p->Mode = Mode;
+    *e_pp     = e_p;
+    if (e_p->Flags & REGSHADOW_VALID) {
+        return 0;
+    }
+    return RegShadow_read(Str_p, e_p);
+}
+
+void RegShadow_net(RegShadowStr_t* Str_p, RegShadowEntryStr_t* Entry_p,
+                   uint8_t Total, uint16_t WaitTick) {
+    Str_p->Entry_p  = Entry_p;
+    Str_p->Total    = Total;
+    Str_p->Count    = 0;
+    Str_p->Batch    = 0;
+    Str_p->WaitTick = WaitTick;
+}
+
+char RegShadow_ftm(RegShadowStr_t* Str_p, uint8_t Bus, uint8_t Mode,
+                   uint8_t Id, uint8_t RRegAdd, uint8_t WRegAdd, uint8_t Mask,
+                   uint8_t Shift, void* Data_p) {
+    RegShadowEntryStr_t* e_p;
+    char res = RegShadow_get(Str_p, Bus, Mode, Id, RRegAdd, &e_p);
+
+    if (res) {
+        return res;
+    }
+    e_p->WRegAdd = WRegAdd;
+    e_p->Value   = (e_p->Value & ~Mask) | ((*(uint8_t*)Data_p << Shift) & Mask);
+    e_p->Flags |= REGSHADOW_DIRTY;
+    if (Str_p->Batch) {
+        return 0;
+    }
+    return RegShadow_write(Str_p, e_p);
+}
+
+char RegShadow_frc(RegShadowStr_t* Str_p, uint8_t Bus, uint8_t Mode,
+                   uint8_t Id, uint8_t RRegAdd, uint8_t Mask, uint8_t Shift,
+                   void* Data_p) {
+    RegShadowEntryStr_t* e_p;
+    char res = RegShadow_get(Str_p, Bus, Mode, Id, RRegAdd, &e_p);
+
+    if (res) {
+        return res;
+    }
+    *(uint8_t*)Data_p = (e_p->Value & Mask) >> Shift;
+    return 0;
+}
+
+char RegShadow_refresh(RegShadowStr_t* Str_p, uint8_t Bus, uint8_t Mode,
+                       uint8_t Id, uint8_t RRegAdd) {
+    RegShadowEntryStr_t* e_p;
+    char res = RegShadow_invalidate(Str_p, Bus, Id, RRegAdd);
+
+    if (res) {
+        return res;
+    }
+    return RegShadow_get(Str_p, Bus, Mode, Id, RRegAdd, &e_p);
+}
+
+char RegShadow_invalidate(RegShadowStr_t* Str_p, uint8_t Bus, uint8_t Id,
+                          uint8_t RRegAdd) {
+    char first = 0;
+
+    for (uint8_t i = 0; i < Str_p->Count; i++) {
+        RegShadowEntryStr_t* e_p = &Str_p->Entry_p[i];
+        if (e_p->Bus != Bus || e_p->Id != Id ||
+            (RRegAdd != 0xFF && e_p->RRegAdd != RRegAdd)) {
+            continue;
+        }
+        /* 待寫內容先寫出，寫入失敗時保留影子值 */
+        if (e_p->Flags & REGSHADOW_DIRTY) {
+            char res = RegShadow_write(Str_p, e_p);
+            if (res) {
+                if (first == 0) {
+                    first = res;
+                }
+                continue;
+            }
+        }
+        e_p->Flags = 0;
+    }
+    return first;
+}
+
+void RegShadow_begin(RegShadowStr_t* Str_p) {
+    Str_p->Batch++;
+}
+
+char RegShadow_end(RegShadowStr_t* Str_p) {
+    if (Str_p->Batch == 0 || --Str_p->Batch) {
+        return 0;
+    }
+    return RegShadow_flush(Str_p);
+}
+
+char RegShadow_flush(RegShadowStr_t* Str_p) {
+    char first = 0;
+
+    for (uint8_t i = 0; i < Str_p->Count; i++) {
+        RegShadowEntryStr_t* e_p = &Str_p->Entry_p[i];
+        if (e_p->Flags & REGSHADOW_DIRTY) {
+            char res = RegShadow_write(Str_p, e_p);
+            if (res && first == 0) {
+                first = res;
+            }
+        }
+    }
+    return first;
+}
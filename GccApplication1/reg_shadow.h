@@ -0,0 +1,153 @@
+/**
+ * @file reg_shadow.h
+ * @brief 遠端暫存器影子快取，供旗標式讀寫使用。
+ *
+ * TWIM_ftm、UARTM_ftm、ASA_SPIM_ftm 每次寫入旗標都先以 *_rec 讀回整個
+ * 暫存器再以 *_trm 寫出，一個位元的變更就需要兩次通訊。RegShadow 以
+ * (匯流排, ID, RegAdd) 為鍵保存遠端暫存器的影子值：第一次使用時讀回一次，
+ * 之後的旗標寫入只更新影子值並送出寫入。在 RegShadow_begin 與
+ * RegShadow_end 之間的旗標寫入只標記為待寫，結束時每個暫存器合併為一次寫入。
+ *
+ * 遠端會自行改變的暫存器(狀態旗標等)需以 RegShadow_invalidate 或
+ * RegShadow_refresh 重新讀取，或直接使用原本的 *_frc 函式。
+ */
+
+#ifndef REG_SHADOW_H
+#define REG_SHADOW_H
+
+#include "c4mlib.h"
+
+#define REGSHADOW_BUS_TWI  0  ///< TWIM_trm / TWIM_rec @ingroup regshadow_macro
+#define REGSHADOW_BUS_UART 1  ///< UARTM_trm / UARTM_rec @ingroup regshadow_macro
+#define REGSHADOW_BUS_SPI  2  ///< ASA_SPIM_trm / ASA_SPIM_rec @ingroup regshadow_macro
+
+#define REGSHADOW_VALID 0x01  ///< 影子值有效 @ingroup regshadow_macro
+#define REGSHADOW_DIRTY 0x02  ///< 影子值尚未寫出 @ingroup regshadow_macro
+
+/**
+ * @brief 影子暫存器結構
+ * @ingroup regshadow_struct
+ */
+typedef struct {
+    uint8_t Bus;      ///< 匯流排種類，REGSHADOW_BUS_*。
+    uint8_t Mode;     ///< 讀寫時使用的通訊模式。
+    uint8_t Id;       ///< 遠端裝置 ID(SLA、UartID 或 ASAID)。
+    uint8_t RRegAdd;  ///< 讀取用暫存器位址，亦為查表的鍵。
+    uint8_t WRegAdd;  ///< 寫入用暫存器位址。
+    uint8_t Value;    ///< 影子值。
+    uint8_t Flags;    ///< REGSHADOW_VALID、REGSHADOW_DIRTY。
+} RegShadowEntryStr_t;
+
+/**
+ * @brief 影子快取管理結構
+ * @ingroup regshadow_struct
+ */
+typedef struct {
+    RegShadowEntryStr_t* Entry_p;  ///< 影子暫存器陣列。
+    uint8_t Total;                 ///< 陣列大小。
+    uint8_t Count;                 ///< 已使用數量。
+    uint8_t Batch;                 ///< RegShadow_begin 巢狀層數。
+    uint16_t WaitTick;             ///< 傳給 *_trm / *_rec 的位元組間延遲。
+} RegShadowStr_t;
+
+/**
+ * @brief 鏈結影子快取與影子暫存器陣列。
+ *
+ * @ingroup regshadow_func
+ * @param Str_p    影子快取管理結構指標。
+ * @param Entry_p  影子暫存器陣列。
+ * @param Total    陣列大小。
+ * @param WaitTick 位元組間延遲時間，單位為 1us。
+ */
+void RegShadow_net(RegShadowStr_t* Str_p, RegShadowEntryStr_t* Entry_p,
+                   uint8_t Total, uint16_t WaitTick);
+
+/**
+ * @brief 經影子快取的旗標式傳送。
+ *
+ * @ingroup regshadow_func
+ * @param Str_p   影子快取管理結構指標。
+ * @param Bus     匯流排種類，REGSHADOW_BUS_*。
+ * @param Mode    通訊模式，與對應的 *_trm / *_rec 相同。
+ * @param Id      遠端裝置 ID。
+ * @param RRegAdd 讀取用暫存器位址。
+ * @param WRegAdd 寫入用暫存器位址，TWI、UART 與 RRegAdd 相同。
+ * @param Mask    位元組遮罩。
+ * @param Shift   待送旗標向左位移。
+ * @param Data_p  待送資料指標。
+ * @return char 錯誤代碼：
+ *   - 0：成功無誤。
+ *   - 5：Bus 錯誤。
+ *   - 6：影子暫存器陣列已滿。
+ *   - 其他：*_trm / *_rec 回傳的錯誤代碼。
+ *
+ * 影子值無效時先讀回一次。批次區間內只標記待寫，否則立即寫出。
+ */
+char RegShadow_ftm(RegShadowStr_t* Str_p, uint8_t Bus, uint8_t Mode,
+                   uint8_t Id, uint8_t RRegAdd, uint8_t WRegAdd, uint8_t Mask,
+                   uint8_t Shift, void* Data_p);
+
+/**
+ * @brief 經影子快取的旗標式接收。
+ *
+ * @ingroup regshadow_func
+ * @param Shift  接收旗標向右位移。
+ * @param Data_p 待收資料指標。
+ *
+ * 其餘參數與回傳值同 RegShadow_ftm。影子值有效時不進行通訊。
+ */
+char RegShadow_frc(RegShadowStr_t* Str_p, uint8_t Bus, uint8_t Mode,
+                   uint8_t Id, uint8_t RRegAdd, uint8_t Mask, uint8_t Shift,
+                   void* Data_p);
+
+/**
+ * @brief 重新讀取遠端暫存器並更新影子值。
+ *
+ * @ingroup regshadow_func
+ * @return char 同 RegShadow_ftm。
+ *
+ * 影子值尚有待寫內容時，先寫出待寫內容再讀回。
+ */
+char RegShadow_refresh(RegShadowStr_t* Str_p, uint8_t Bus, uint8_t Mode,
+                       uint8_t Id, uint8_t RRegAdd);
+
+/**
+ * @brief 使影子值失效，下次使用時重新讀取。
+ *
+ * @ingroup regshadow_func
+ * @param Str_p   影子快取管理結構指標。
+ * @param Bus     匯流排種類。
+ * @param Id      遠端裝置 ID。
+ * @param RRegAdd 讀取用暫存器位址，為 0xFF 時使該裝置所有影子值失效。
+ * @return char 第一個寫入錯誤的錯誤代碼，0 為成功無誤。
+ *
+ * 批次區間中尚未寫出的影子值會先立即寫出再失效，不會遺失已做的旗標
+ * 寫入；寫入失敗的影子值保持有效與待寫狀態。
+ */
+char RegShadow_invalidate(RegShadowStr_t* Str_p, uint8_t Bus, uint8_t Id,
+                          uint8_t RRegAdd);
+
+/**
+ * @brief 開始批次區間，可巢狀呼叫。
+ * @ingroup regshadow_func
+ */
+void RegShadow_begin(RegShadowStr_t* Str_p);
+
+/**
+ * @brief 結束批次區間，最外層結束時寫出所有待寫的影子值。
+ *
+ * @ingroup regshadow_func
+ * @return char 第一個寫入錯誤的錯誤代碼，0 為成功無誤。
+ */
+char RegShadow_end(RegShadowStr_t* Str_p);
+
+/**
+ * @brief 立即寫出所有待寫的影子值。
+ *
+ * @ingroup regshadow_func
+ * @return char 第一個寫入錯誤的錯誤代碼，0 為成功無誤。寫入失敗的
+ * 影子值保持待寫狀態。
+ */
+char RegShadow_flush(RegShadowStr_t* Str_p);
+
+#endif  // REG_SHADOW_H
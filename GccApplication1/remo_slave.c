@@ -0,0 +1,710 @@
+/**
+ * @file remo_slave.c
+ * @brief 查表式遠端暫存器 Slave 協定引擎實作。
+ */
+
+#include "remo_slave.h"
+
+#include <avr/pgmspace.h>
+#include <string.h>
+
+#define ST_HEADER 0  // 等待封包頭
+#define ST_UID    1  // 等待 UID
+#define ST_ADD    2  // 等待 RegAdd
+#define ST_DATA   3  // 接收寫入資料
+#define ST_CHK    4  // 等待 checksum
+#define ST_TX     5  // 送出回應中
+#define ST_IDLE   6  // 等待 RemoSlave_start
+#define ST_BNUM   7  // 等待批次暫存器數量
+#define ST_BLIST  8  // 接收批次 (RegAdd, Bytes) 列表
+#define ST_BDATA  9  // 接收批次寫入資料
+
+#define TWCR_ACK ((1 << TWINT) | (1 << TWEA) | (1 << TWEN) | (1 << TWIE))
+
+#define F_UID  REMOSLAVE_F_UID
+#define F_CHK  REMOSLAVE_F_CHK
+#define F_MSB  REMOSLAVE_F_MSB
+#define F_RSP  REMOSLAVE_F_RSP
+#define F_ECHO REMOSLAVE_F_ECHO
+
+#define DESC_INVALID \
+    { 0, REMOSLAVE_ADD_INVALID, 0, 0 }
+
+/* 與 UARTM_trm / UARTM_rec Mode 0~10 對應 */
+static const RemoSlaveDescStr_t RemoSlave_uartDesc[11] PROGMEM = {
+    {REMOSLAVE_CMD_HEADER, REMOSLAVE_ADD_WHIGH, F_UID | F_CHK | F_RSP, 0},
+    {0, REMOSLAVE_ADD_CF, 0, 2},
+    {0, REMOSLAVE_ADD_CF, F_MSB, 2},
+    {0, REMOSLAVE_ADD_NONE, 0, 2},
+    {0, REMOSLAVE_ADD_NONE, F_MSB, 2},
+    {0, REMOSLAVE_ADD_PLAIN, 0, 0},
+    {0, REMOSLAVE_ADD_PLAIN, F_MSB, 0},
+    {0, REMOSLAVE_ADD_WHIGH, 0, 0},
+    {0, REMOSLAVE_ADD_WHIGH, F_MSB, 0},
+    {0, REMOSLAVE_ADD_WLOW, 0, 0},
+    {0, REMOSLAVE_ADD_WLOW, F_MSB, 0},
+};
+
+/* 與 ASA_SPIM_trm / ASA_SPIM_rec mode 0~10 對應 */
+static const RemoSlaveDescStr_t RemoSlave_spiDesc[11] PROGMEM = {
+    {0, REMOSLAVE_ADD_WHIGH, F_ECHO, 0},
+    {0, REMOSLAVE_ADD_CF, 0, 2},
+    {0, REMOSLAVE_ADD_CF, F_MSB, 2},
+    {0, REMOSLAVE_ADD_NONE, 0, 2},
+    {0, REMOSLAVE_ADD_NONE, F_MSB, 2},
+    {0, REMOSLAVE_ADD_PLAIN, 0, 0},
+    {0, REMOSLAVE_ADD_PLAIN, F_MSB, 0},
+    {0, REMOSLAVE_ADD_WHIGH, 0, 0},
+    {0, REMOSLAVE_ADD_WHIGH, F_MSB, 0},
+    {0, REMOSLAVE_ADD_WLOW, 0, 0},
+    {0, REMOSLAVE_ADD_WLOW, F_MSB, 0},
+};
+
+/* 與 TWIM_trm / TWIM_rec mode 1~6 對應 */
+static const RemoSlaveDescStr_t RemoSlave_twiDesc[7] PROGMEM = {
+    DESC_INVALID,
+    {0, REMOSLAVE_ADD_CF, F_MSB, 2},
+    {0, REMOSLAVE_ADD_CF, 0, 2},
+    {0, REMOSLAVE_ADD_NONE, F_MSB, 2},
+    {0, REMOSLAVE_ADD_NONE, 0, 2},
+    {0, REMOSLAVE_ADD_PLAIN, F_MSB, 0},
+    {0, REMOSLAVE_ADD_PLAIN, 0, 0},
+};
+
+static uint8_t RemoSlave_open(RemoSlaveStr_t* Str_p, uint8_t RegAdd,
+                              uint8_t Rw);
+
+/* 回到封包開頭，方向使用 Str_p->Rw */
+static void RemoSlave_reset(RemoSlaveStr_t* Str_p) {
+    Str_p->Count = 0;
+    Str_p->Sum   = 0;
+    Str_p->Bulk  = 0;
+    if (Str_p->Desc.Header) {
+        Str_p->State = ST_HEADER;
+    }
+    else if (Str_p->Desc.Flags & F_UID) {
+        Str_p->State = ST_UID;
+    }
+    else if (Str_p->Desc.AddForm != REMOSLAVE_ADD_NONE) {
+        Str_p->State = ST_ADD;
+    }
+    else if (Str_p->Rw == REMOSLAVE_R && Str_p->Bus == SERIAL_TYPE_UART) {
+        Str_p->State = ST_IDLE;
+    }
+    else {
+        RemoSlave_open(Str_p, Str_p->Desc.DefReg, Str_p->Rw);
+    }
+}
+
+static uint8_t RemoSlave_txPending(RemoSlaveStr_t* Str_p) {
+    return Str_p->TxHeader || Str_p->TxLeft || Str_p->TxChk;
+}
+
+/* 載入批次列表中第 BulkIdx 個暫存器，開始傳送或接收其資料 */
+static void RemoSlave_bulkEntry(RemoSlaveStr_t* Str_p) {
+    uint8_t reg_add          = Str_p->BulkAdd[Str_p->BulkIdx];
+    RemoSlaveRegStr_t* reg_p = &Str_p->Reg_p[reg_add];
+
+    Str_p->RegAdd = reg_add;
+    Str_p->Bytes  = reg_p->Bytes;
+    Str_p->Count  = 0;
+    if (Str_p->Rw == REMOSLAVE_R) {
+        Str_p->Buf_p   = reg_p->Data_p;
+        Str_p->TxLeft  = reg_p->Bytes;
+        Str_p->TxIndex = (Str_p->Desc.Flags & F_MSB) ? reg_p->Bytes - 1 : 0;
+    }
+    else if (reg_p->Back_p != NULL) {
+        Str_p->Buf_p = reg_p->Back_p;
+    }
+    else {
+        Str_p->Buf_p = Str_p->Temp + Str_p->BulkTemp;
+        Str_p->BulkTemp += reg_p->Bytes;
+    }
+}
+
+/* 封包結束，準備回應內容，沒有回應時回到封包開頭 */
+static void RemoSlave_respond(RemoSlaveStr_t* Str_p, uint8_t Res) {
+    uint8_t flags = Str_p->Desc.Flags;
+
+    Str_p->Result   = Res;
+    Str_p->Packets++;
+    Str_p->TxHeader = 0;
+    Str_p->TxLeft   = 0;
+    Str_p->TxChk    = 0;
+    Str_p->TxSum    = 0;
+    if (flags & F_RSP) {
+        Str_p->TxHeader =
+            (Res == REMOSLAVE_RES_OK) ? REMOSLAVE_RSP_HEADER : REMOSLAVE_RSP_ERR;
+    }
+    if (Res == REMOSLAVE_RES_OK && Str_p->Rw == REMOSLAVE_R) {
+        if (Str_p->Bulk) {
+            Str_p->BulkIdx = 0;
+            RemoSlave_bulkEntry(Str_p);
+        }
+        else {
+            Str_p->TxLeft  = Str_p->Bytes;
+            Str_p->TxIndex = (flags & F_MSB) ? Str_p->Bytes - 1 : 0;
+        }
+        Str_p->TxChk = flags & F_CHK;
+    }
+    if (!RemoSlave_txPending(Str_p)) {
+        Str_p->Rw = Str_p->Dir;
+        RemoSlave_reset(Str_p);
+        return;
+    }
+    Str_p->State = ST_TX;
+    if (Str_p->Bus == SERIAL_TYPE_UART && !Str_p->TxActive) {
+        Str_p->TxActive = 1;
+        *Str_p->Dr_p    = RemoSlave_tx(Str_p);
+    }
+}
+
+/* 選定暫存器並進入資料或 checksum 階段，RegAdd 錯誤時回傳 1 */
+static uint8_t RemoSlave_open(RemoSlaveStr_t* Str_p, uint8_t RegAdd,
+                              uint8_t Rw) {
+    RemoSlaveRegStr_t* reg_p;
+
+    Str_p->Rw = Rw;
+    if (RegAdd >= Str_p->RegTotal || Str_p->Reg_p[RegAdd].Data_p == NULL) {
+        RemoSlave_respond(Str_p, REMOSLAVE_RES_REGADD);
+        return 1;
+    }
+    reg_p = &Str_p->Reg_p[RegAdd];
+    if (Rw == REMOSLAVE_R) {
+        Str_p->Buf_p = reg_p->Data_p;
+    }
+    else if (reg_p->Back_p != NULL) {
+        Str_p->Buf_p = reg_p->Back_p;
+    }
+    else if (reg_p->Bytes <= BUFF_MAX_SZ) {
+        Str_p->Buf_p = Str_p->Temp;
+    }
+    else {
+        RemoSlave_respond(Str_p, REMOSLAVE_RES_BYTES);
+        return 1;
+    }
+    Str_p->RegAdd = RegAdd;
+    Str_p->Bytes  = reg_p->Bytes;
+    Str_p->Count  = 0;
+    if (Rw == REMOSLAVE_W) {
+        Str_p->State = ST_DATA;
+    }
+    else if (Str_p->Desc.Flags & F_CHK) {
+        Str_p->State = ST_CHK;
+    }
+    else {
+        RemoSlave_respond(Str_p, REMOSLAVE_RES_OK);
+    }
+    return 0;
+}
+
+/* 使寫入生效，Src_p 為 Temp 中的資料，雙緩衝暫存器則交換緩衝區 */
+static void RemoSlave_publish(RemoSlaveRegStr_t* reg_p, uint8_t* Src_p) {
+    void* data_p;
+
+    reg_p->Seq++;
+    if (reg_p->Back_p != NULL) {
+        data_p        = reg_p->Data_p;
+        reg_p->Data_p = reg_p->Back_p;
+        reg_p->Back_p = data_p;
+    }
+    else {
+        memcpy(reg_p->Data_p, Src_p, reg_p->Bytes);
+    }
+    reg_p->Seq++;
+}
+
+static void RemoSlave_commit(RemoSlaveStr_t* Str_p) {
+    uint8_t* src_p = Str_p->Temp;
+
+    if (!Str_p->Bulk) {
+        RemoSlave_publish(&Str_p->Reg_p[Str_p->RegAdd], src_p);
+    }
+    else {
+        for (uint8_t i = 0; i < Str_p->BulkNum; i++) {
+            RemoSlaveRegStr_t* reg_p = &Str_p->Reg_p[Str_p->BulkAdd[i]];
+            RemoSlave_publish(reg_p, src_p);
+            if (reg_p->Back_p == NULL) {
+                src_p += reg_p->Bytes;
+            }
+        }
+    }
+    RemoSlave_respond(Str_p, REMOSLAVE_RES_OK);
+}
+
+/* 檢查批次列表中的一項，錯誤時記錄於 BulkErr 但繼續接收以維持封包同步 */
+static void RemoSlave_bulkAdd(RemoSlaveStr_t* Str_p, uint8_t RegAdd,
+                              uint8_t Bytes) {
+    RemoSlaveRegStr_t* reg_p = &Str_p->Reg_p[RegAdd];
+    uint8_t idx              = Str_p->BulkIdx;
+
+    Str_p->BulkLeft += Bytes;
+    if (Str_p->BulkErr) {
+        return;
+    }
+    if (RegAdd >= Str_p->RegTotal || reg_p->Data_p == NULL) {
+        Str_p->BulkErr = REMOSLAVE_RES_REGADD;
+        return;
+    }
+    if (Bytes == 0 || Bytes != reg_p->Bytes) {
+        Str_p->BulkErr = REMOSLAVE_RES_BYTES;
+        return;
+    }
+    if (Str_p->Rw == REMOSLAVE_W) {
+        for (uint8_t i = 0; i < idx; i++) {
+            if (Str_p->BulkAdd[i] == RegAdd) {
+                Str_p->BulkErr = REMOSLAVE_RES_REGADD;
+                return;
+            }
+        }
+        if (reg_p->Back_p == NULL) {
+            if (Bytes > BUFF_MAX_SZ - Str_p->BulkTemp) {
+                Str_p->BulkErr = REMOSLAVE_RES_BYTES;
+                return;
+            }
+            Str_p->BulkTemp += Bytes;
+        }
+    }
+    Str_p->BulkAdd[idx] = RegAdd;
+}
+
+/* 批次列表或資料接收完畢 */
+static void RemoSlave_bulkEnd(RemoSlaveStr_t* Str_p) {
+    if (Str_p->Desc.Flags & F_CHK) {
+        Str_p->State = ST_CHK;
+    }
+    else if (Str_p->BulkErr) {
+        RemoSlave_respond(Str_p, Str_p->BulkErr);
+    }
+    else if (Str_p->Rw == REMOSLAVE_W) {
+        RemoSlave_commit(Str_p);
+    }
+    else {
+        RemoSlave_respond(Str_p, REMOSLAVE_RES_OK);
+    }
+}
+
+static void RemoSlave_store(RemoSlaveStr_t* Str_p, uint8_t Data) {
+    uint8_t index = Str_p->Count;
+
+    if (Str_p->Desc.Flags & F_MSB) {
+        index = Str_p->Bytes - 1 - index;
+    }
+    Str_p->Buf_p[index] = Data;
+    if (++Str_p->Count < Str_p->Bytes) {
+        return;
+    }
+    if (Str_p->Desc.Flags & F_CHK) {
+        Str_p->State = ST_CHK;
+    }
+    else {
+        RemoSlave_commit(Str_p);
+    }
+}
+
+/* RegAdd 為 REMOSLAVE_BULK_REG 時進入批次傳輸 */
+static void RemoSlave_bulk(RemoSlaveStr_t* Str_p, uint8_t Rw) {
+    Str_p->Rw       = Rw;
+    Str_p->Bulk     = 1;
+    Str_p->BulkErr  = 0;
+    Str_p->BulkLeft = 0;
+    Str_p->BulkTemp = 0;
+    Str_p->BulkIdx  = 0;
+    Str_p->Count    = 0;
+    Str_p->State    = ST_BNUM;
+}
+
+static void RemoSlave_decode(RemoSlaveStr_t* Str_p, uint8_t Data) {
+    if ((Str_p->Desc.AddForm == REMOSLAVE_ADD_WHIGH &&
+         (Data & 0x7F) == REMOSLAVE_BULK_REG) ||
+        (Str_p->Desc.AddForm == REMOSLAVE_ADD_WLOW &&
+         (Data >> 1) == REMOSLAVE_BULK_REG)) {
+        RemoSlave_bulk(Str_p, (Str_p->Desc.AddForm == REMOSLAVE_ADD_WHIGH)
+                                  ? Data >> 7
+                                  : Data & 0x01);
+        return;
+    }
+    switch (Str_p->Desc.AddForm) {
+        case REMOSLAVE_ADD_PLAIN:
+            RemoSlave_open(Str_p, Data, Str_p->Rw);
+            break;
+        case REMOSLAVE_ADD_WHIGH:
+            RemoSlave_open(Str_p, Data & 0x7F, Data >> 7);
+            break;
+        case REMOSLAVE_ADD_WLOW:
+            RemoSlave_open(Str_p, Data >> 1, Data & 0x01);
+            break;
+        case REMOSLAVE_ADD_CF:
+            Str_p->Cf = Data & CF_MASK;
+            if (RemoSlave_open(Str_p, Str_p->Desc.DefReg, REMOSLAVE_W) == 0) {
+                RemoSlave_store(Str_p, Data & ~CF_MASK);
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+uint8_t RemoSlave_net(RemoSlaveStr_t* Str_p, uint8_t Bus, uint8_t Num,
+                      uint8_t Mode, uint8_t Id, RemoSlaveRegStr_t* Reg_p,
+                      uint8_t RegTotal) {
+    const RemoSlaveDescStr_t* desc_p;
+
+    switch (Bus) {
+        case SERIAL_TYPE_UART:
+            if (Num > 1) {
+                return 1;
+            }
+            if (Mode > 10) {
+                return 5;
+            }
+            Str_p->Dr_p = Num ? &UDR1 : &UDR0;
+            desc_p      = &RemoSlave_uartDesc[Mode];
+            break;
+        case SERIAL_TYPE_SPI:
+            if (Mode > 10) {
+                return 5;
+            }
+            Str_p->Dr_p = &SPDR;
+            desc_p      = &RemoSlave_spiDesc[Mode];
+            break;
+        case SERIAL_TYPE_TWI:
+            if (Mode > 6) {
+                return 5;
+            }
+            Str_p->Dr_p = &TWDR;
+            desc_p      = &RemoSlave_twiDesc[Mode];
+            break;
+        default:
+            return 1;
+    }
+    memcpy_P(&Str_p->Desc, desc_p, sizeof(RemoSlaveDescStr_t));
+    if (Str_p->Desc.AddForm == REMOSLAVE_ADD_INVALID) {
+        return 5;
+    }
+    /* 帶 R/W 位元的模式中 REMOSLAVE_BULK_REG 會被當成批次封包，無法存取 */
+    if ((Str_p->Desc.AddForm == REMOSLAVE_ADD_WHIGH ||
+         Str_p->Desc.AddForm == REMOSLAVE_ADD_WLOW) &&
+        RegTotal > REMOSLAVE_BULK_REG &&
+        Reg_p[REMOSLAVE_BULK_REG].Data_p != NULL) {
+        return 3;
+    }
+    Str_p->Bus      = Bus;
+    Str_p->Id       = Id;
+    Str_p->Reg_p    = Reg_p;
+    Str_p->RegTotal = RegTotal;
+    Str_p->Dir      = REMOSLAVE_W;
+    Str_p->Rw       = REMOSLAVE_W;
+    Str_p->Echo     = 0;
+    Str_p->TxHeader = 0;
+    Str_p->TxLeft   = 0;
+    Str_p->TxChk    = 0;
+    Str_p->TxActive = 0;
+    Str_p->Cf       = 0;
+    Str_p->Result   = REMOSLAVE_RES_OK;
+    Str_p->Packets  = 0;
+    RemoSlave_reset(Str_p);
+    return 0;
+}
+
+void RemoSlave_setDir(RemoSlaveStr_t* Str_p, uint8_t Dir) {
+    uint8_t sreg;
+
+    sreg = SREG;
+    cli();
+    Str_p->Dir = Dir;
+    if (Str_p->State != ST_TX) {
+        Str_p->Rw = Dir;
+        RemoSlave_reset(Str_p);
+        if (Str_p->State == ST_IDLE) {
+            RemoSlave_open(Str_p, Str_p->Desc.DefReg, REMOSLAVE_R);
+        }
+    }
+    SREG = sreg;
+}
+
+void RemoSlave_start(RemoSlaveStr_t* Str_p, uint8_t Rw) {
+    /* TWI 先寫入 RegAdd 再以重複 START 讀取 */
+    if (Rw == REMOSLAVE_R && Str_p->State == ST_DATA && Str_p->Count == 0) {
+        RemoSlave_open(Str_p, Str_p->RegAdd, REMOSLAVE_R);
+        return;
+    }
+    Str_p->Rw = Rw;
+    RemoSlave_reset(Str_p);
+    if (Rw == REMOSLAVE_R && Str_p->State == ST_ADD &&
+        Str_p->Desc.AddForm == REMOSLAVE_ADD_CF) {
+        RemoSlave_open(Str_p, Str_p->Desc.DefReg, REMOSLAVE_R);
+    }
+}
+
+void RemoSlave_rx(RemoSlaveStr_t* Str_p, uint8_t Data) {
+    switch (Str_p->State) {
+        case ST_HEADER:
+            if (Data == Str_p->Desc.Header) {
+                Str_p->Sum   = 0;
+                Str_p->State = (Str_p->Desc.Flags & F_UID) ? ST_UID : ST_ADD;
+            }
+            break;
+        case ST_UID:
+            Str_p->Sum += Data;
+            if (Data == Str_p->Id) {
+                Str_p->State = ST_ADD;
+            }
+            else {
+                RemoSlave_reset(Str_p);
+            }
+            break;
+        case ST_ADD:
+            Str_p->Sum += Data;
+            RemoSlave_decode(Str_p, Data);
+            break;
+        case ST_DATA:
+            Str_p->Sum += Data;
+            RemoSlave_store(Str_p, Data);
+            break;
+        case ST_BNUM:
+            Str_p->Sum += Data;
+            Str_p->BulkNum = Data;
+            if (Data == 0 || Data > REMOSLAVE_BULK_MAX) {
+                Str_p->BulkErr = REMOSLAVE_RES_BYTES;
+            }
+            if (Data == 0) {
+                RemoSlave_bulkEnd(Str_p);
+            }
+            else {
+                Str_p->State = ST_BLIST;
+            }
+            break;
+        case ST_BLIST:
+            Str_p->Sum += Data;
+            if (Str_p->Count == 0) {
+                Str_p->RegAdd = Data;
+                Str_p->Count  = 1;
+                break;
+            }
+            RemoSlave_bulkAdd(Str_p, Str_p->RegAdd, Data);
+            Str_p->Count = 0;
+            if (++Str_p->BulkIdx < Str_p->BulkNum) {
+                break;
+            }
+            if (Str_p->Rw == REMOSLAVE_W && Str_p->BulkLeft) {
+                Str_p->State    = ST_BDATA;
+                Str_p->BulkIdx  = 0;
+                Str_p->BulkTemp = 0;
+                if (!Str_p->BulkErr) {
+                    RemoSlave_bulkEntry(Str_p);
+                }
+            }
+            else {
+                RemoSlave_bulkEnd(Str_p);
+            }
+            break;
+        case ST_BDATA:
+            Str_p->Sum += Data;
+            if (!Str_p->BulkErr) {
+                uint8_t index = Str_p->Count;
+                if (Str_p->Desc.Flags & F_MSB) {
+                    index = Str_p->Bytes - 1 - index;
+                }
+                Str_p->Buf_p[index] = Data;
+                if (++Str_p->Count == Str_p->Bytes &&
+                    ++Str_p->BulkIdx < Str_p->BulkNum) {
+                    RemoSlave_bulkEntry(Str_p);
+                }
+            }
+            if (--Str_p->BulkLeft == 0) {
+                RemoSlave_bulkEnd(Str_p);
+            }
+            break;
+        case ST_CHK:
+            if (Data != Str_p->Sum) {
+                RemoSlave_respond(Str_p, REMOSLAVE_RES_CHKSUM);
+            }
+            else if (Str_p->Bulk && Str_p->BulkErr) {
+                RemoSlave_respond(Str_p, Str_p->BulkErr);
+            }
+            else if (Str_p->Rw == REMOSLAVE_W) {
+                RemoSlave_commit(Str_p);
+            }
+            else {
+                RemoSlave_respond(Str_p, REMOSLAVE_RES_OK);
+            }
+            break;
+        default:
+            break;
+    }
+    Str_p->Echo = Data;
+}
+
+uint8_t RemoSlave_tx(RemoSlaveStr_t* Str_p) {
+    uint8_t data;
+
+    if (Str_p->State != ST_TX) {
+        return (Str_p->Desc.Flags & F_ECHO) ? Str_p->Echo : 0;
+    }
+    if (Str_p->TxHeader) {
+        data            = Str_p->TxHeader;
+        Str_p->TxHeader = 0;
+    }
+    else if (Str_p->TxLeft) {
+        data = Str_p->Buf_p[Str_p->TxIndex];
+        if (Str_p->Desc.Flags & F_MSB) {
+            Str_p->TxIndex--;
+        }
+        else {
+            Str_p->TxIndex++;
+        }
+        Str_p->TxSum += data;
+        if (--Str_p->TxLeft == 0 && Str_p->Bulk &&
+            ++Str_p->BulkIdx < Str_p->BulkNum) {
+            RemoSlave_bulkEntry(Str_p);
+        }
+    }
+    else if (Str_p->TxChk) {
+        data         = Str_p->TxSum;
+        Str_p->TxChk = 0;
+    }
+    else {
+        Str_p->Rw = Str_p->Dir;
+        RemoSlave_reset(Str_p);
+        return 0;
+    }
+    return data;
+}
+
+void RemoSlave_stop(RemoSlaveStr_t* Str_p) {
+    /* 只收到 RegAdd，可能接著以重複 START 讀取 */
+    if (Str_p->State == ST_DATA && Str_p->Count == 0) {
+        return;
+    }
+    Str_p->Rw = Str_p->Dir;
+    RemoSlave_reset(Str_p);
+}
+
+void* RemoSlave_regData(RemoSlaveStr_t* Str_p, uint8_t RegAdd) {
+    void* data_p;
+    uint8_t sreg;
+
+    if (RegAdd >= Str_p->RegTotal) {
+        return NULL;
+    }
+    sreg = SREG;
+    cli();
+    data_p = Str_p->Reg_p[RegAdd].Data_p;
+    SREG = sreg;
+    return data_p;
+}
+
+uint8_t RemoSlave_regRead(RemoSlaveStr_t* Str_p, uint8_t RegAdd, void* Data_p,
+                          uint8_t* Seq_p) {
+    RemoSlaveRegStr_t* reg_p;
+    uint8_t seq;
+
+    if (RegAdd >= Str_p->RegTotal || Str_p->Reg_p[RegAdd].Data_p == NULL) {
+        return 2;
+    }
+    reg_p = &Str_p->Reg_p[RegAdd];
+    do {
+        seq = reg_p->Seq;
+        memcpy(Data_p, RemoSlave_regData(Str_p, RegAdd), reg_p->Bytes);
+    } while ((seq & 0x01) || seq != reg_p->Seq);
+    if (Seq_p != NULL) {
+        *Seq_p = seq;
+    }
+    return 0;
+}
+
+uint8_t RemoSlave_regChanged(RemoSlaveStr_t* Str_p, uint8_t RegAdd,
+                             uint8_t Seq) {
+    if (RegAdd >= Str_p->RegTotal) {
+        return 0;
+    }
+    return Str_p->Reg_p[RegAdd].Seq != Seq;
+}
+
+void RemoSlave_uartReg(RemoSlaveStr_t* Str_p, UartIntStr_t* UartIntStr_p) {
+    Str_p->TxFb_Id = UartTxInt_reg(UartIntStr_p, RemoSlave_uartTxStep, Str_p);
+    Str_p->Fb_Id   = UartRxInt_reg(UartIntStr_p, RemoSlave_uartRxStep, Str_p);
+    UartTxInt_en(UartIntStr_p, Str_p->TxFb_Id, ENABLE);
+    UartRxInt_en(UartIntStr_p, Str_p->Fb_Id, ENABLE);
+}
+
+void RemoSlave_spiReg(RemoSlaveStr_t* Str_p, SpiIntStr_t* SpiIntStr_p) {
+    Str_p->Fb_Id = SpiInt_reg(SpiIntStr_p, RemoSlave_spiStep, Str_p);
+    SpiInt_en(SpiIntStr_p, Str_p->Fb_Id, ENABLE);
+    SPDR = RemoSlave_tx(Str_p);
+}
+
+void RemoSlave_twiReg(RemoSlaveStr_t* Str_p, TwiIntStr_t* TwiIntStr_p) {
+    Str_p->Fb_Id = TwiInt_reg(TwiIntStr_p, RemoSlave_twiStep, Str_p);
+    TwiInt_en(TwiIntStr_p, Str_p->Fb_Id, ENABLE);
+    TWCR = TWCR_ACK;
+}
+
+void RemoSlave_uartRxStep(void* void_p) {
+    RemoSlaveStr_t* Str_p = (RemoSlaveStr_t*)void_p;
+
+    RemoSlave_rx(Str_p, *Str_p->Dr_p);
+}
+
+void RemoSlave_uartTxStep(void* void_p) {
+    RemoSlaveStr_t* Str_p = (RemoSlaveStr_t*)void_p;
+
+    if (RemoSlave_txPending(Str_p)) {
+        *Str_p->Dr_p = RemoSlave_tx(Str_p);
+        return;
+    }
+    Str_p->TxActive = 0;
+    if (Str_p->State == ST_TX) {
+        RemoSlave_tx(Str_p);
+    }
+}
+
+void RemoSlave_spiStep(void* void_p) {
+    RemoSlaveStr_t* Str_p = (RemoSlaveStr_t*)void_p;
+
+    RemoSlave_rx(Str_p, SPDR);
+    SPDR = RemoSlave_tx(Str_p);
+}
+
+void RemoSlave_csStep(void* void_p) {
+    RemoSlaveStr_t* Str_p = (RemoSlaveStr_t*)void_p;
+
+    RemoSlave_start(Str_p, Str_p->Dir);
+    SPDR = RemoSlave_tx(Str_p);
+}
+
+void RemoSlave_twiStep(void* void_p) {
+    RemoSlaveStr_t* Str_p = (RemoSlaveStr_t*)void_p;
+
+    switch (TWSR & 0xF8) {
+        case 0x60:  // SLA+W
+        case 0x68:
+        case 0x70:  // General call
+        case 0x78:
+            RemoSlave_start(Str_p, REMOSLAVE_W);
+            break;
+        case 0x80:  // Data received, ACK
+        case 0x90:
+            RemoSlave_rx(Str_p, TWDR);
+            break;
+        case 0xA8:  // SLA+R
+        case 0xB0:
+            RemoSlave_start(Str_p, REMOSLAVE_R);
+            TWDR = RemoSlave_tx(Str_p);
+            break;
+        case 0xB8:  // Data transmitted, ACK
+            TWDR = RemoSlave_tx(Str_p);
+            break;
+        case 0xA0:  // STOP or repeated START
+        case 0xC0:  // Data transmitted, NACK
+        case 0xC8:
+        case 0x88:
+        case 0x98:
+            RemoSlave_stop(Str_p);
+            break;
+        default:
+            return;
+    }
+    TWCR = TWCR_ACK;
+}
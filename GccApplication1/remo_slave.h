@@ -0,0 +1,316 @@
+/**
+ * @file remo_slave.h
+ * @brief 查表式遠端暫存器 Slave 協定引擎，UART、SPI、TWI 共用。
+ *
+ * 函式庫中 ASA_UARTS0~10、ASA_SPIS0~10、ASA_TWIS1~6 各自是一個獨立的
+ * 狀態機，使用兩種模式就要連結兩份幾乎相同的程式。RemoSlave 將各模式的
+ * 差異整理成 4 位元組的描述(存於 PROGMEM)：
+ *  - Header：命令封包頭，0 為無封包頭。
+ *  - AddForm：RegAdd 編碼方式，REMOSLAVE_ADD_*。
+ *  - Flags：是否帶 UID、checksum、回應封包頭，資料由高至低或由低至高。
+ *  - DefReg：封包中沒有 RegAdd 時使用的暫存器。
+ * 三種匯流排共用同一個逐位元組狀態機 RemoSlave_rx / RemoSlave_tx，
+ * 匯流排之間的差異只在 RemoSlave_uartRxStep、RemoSlave_spiStep、
+ * RemoSlave_twiStep 等中斷執行片段。
+ *
+ * 暫存器以 RegAdd 為索引放在 RemoSlaveRegStr_t 陣列中，查表只需一次索引，
+ * 暫存器數量不受 REG_MAX_COUNT 限制。Data_p 為 NULL 的位址視為未註冊。
+ * 寫入資料整筆收完(且 checksum 正確)後才生效：
+ *  - Back_p 為 NULL：先收到 Temp，完成後複製到 Data_p，大小受 BUFF_MAX_SZ
+ *    限制。
+ *  - Back_p 不為 NULL(雙緩衝)：直接收到 Back_p，完成後交換 Data_p 與
+ *    Back_p，中斷中不需複製，大小不受限制。前景請以 RemoSlave_regData
+ *    取得目前的 Data_p。
+ *
+ * 每次寫入生效時暫存器的 Seq 在寫入前後各加1。前景以 RemoSlave_regRead
+ * 複製多位元組暫存器時，若複製期間 Seq 改變即重新複製，不需關閉中斷；
+ * RemoSlave_regChanged 可查詢暫存器自上次讀取後是否被寫入。
+ *
+ * 封包中沒有 R/W 位元的模式(ADD_NONE、ADD_PLAIN、ADD_CF)，TWI 依 SLA+R/W
+ * 決定方向，UART、SPI 依 RemoSlave_setDir 設定的方向。
+ *
+ * 帶 R/W 位元的模式(ADD_WHIGH、ADD_WLOW)中 RegAdd 為 REMOSLAVE_BULK_REG 時
+ * 為批次傳輸，一個封包讀寫多個暫存器：
+ *  - 命令：[RegAdd 欄位]、[N]、N 組 [RegAdd][Bytes]，寫入時接著依列表順序
+ *    的所有資料，帶 checksum 的模式最後為 [checksum]。
+ *  - 讀取回應：依列表順序的所有資料，帶 checksum 的模式最後為一個
+ *    [checksum]。
+ * Bytes 須與暫存器大小相同，N 最大為 REMOSLAVE_BULK_MAX。寫入時所有
+ * 暫存器在 checksum 確認後一起生效，列表中任一項錯誤則全部不寫入。
+ * 這些模式中 REMOSLAVE_BULK_REG 不能作為一般暫存器，RemoSlave_net 會拒絕
+ * 在該位址放有資料的暫存器表。
+ */
+
+#ifndef REMO_SLAVE_H
+#define REMO_SLAVE_H
+
+#include "c4mlib.h"
+
+#define REMOSLAVE_ADD_NONE    0     ///< 無 RegAdd，使用 DefReg @ingroup remoslave_macro
+#define REMOSLAVE_ADD_PLAIN   1     ///< [RegAdd] @ingroup remoslave_macro
+#define REMOSLAVE_ADD_WHIGH   2     ///< [R/W(bit7) | RegAdd(7bit)] @ingroup remoslave_macro
+#define REMOSLAVE_ADD_WLOW    3     ///< [RegAdd(7bit) << 1 | R/W(bit0)] @ingroup remoslave_macro
+#define REMOSLAVE_ADD_CF      4     ///< [CF | Data]，CF 為 CF_MASK 位元 @ingroup remoslave_macro
+#define REMOSLAVE_ADD_INVALID 0xFF  ///< 不支援的模式 @ingroup remoslave_macro
+
+#define REMOSLAVE_F_UID 0x01  ///< 封包頭後帶 UID @ingroup remoslave_macro
+#define REMOSLAVE_F_CHK 0x02  ///< 封包尾帶 checksum @ingroup remoslave_macro
+#define REMOSLAVE_F_MSB 0x04  ///< 資料由高至低傳輸 @ingroup remoslave_macro
+#define REMOSLAVE_F_RSP 0x08  ///< 回應前先送 RSP_HEADER 或 RSP_ERR @ingroup remoslave_macro
+#define REMOSLAVE_F_ECHO 0x10 ///< 寫入時回傳上一個收到的位元組 @ingroup remoslave_macro
+
+#define REMOSLAVE_CMD_HEADER 0xAA  ///< ASAUART_CMD_HEADER @ingroup remoslave_macro
+#define REMOSLAVE_RSP_HEADER 0xAB  ///< ASAUART_RSP_HEADER @ingroup remoslave_macro
+#define REMOSLAVE_RSP_ERR    0x06  ///< 錯誤回應 @ingroup remoslave_macro
+
+#define REMOSLAVE_BULK_REG 0x7F  ///< 批次傳輸使用的 RegAdd @ingroup remoslave_macro
+
+#define REMOSLAVE_W 0  ///< 寫入 Slave 暫存器 @ingroup remoslave_macro
+#define REMOSLAVE_R 1  ///< 讀取 Slave 暫存器 @ingroup remoslave_macro
+
+#define REMOSLAVE_RES_OK     0  ///< 成功 @ingroup remoslave_macro
+#define REMOSLAVE_RES_REGADD 2  ///< 沒有此暫存器 @ingroup remoslave_macro
+#define REMOSLAVE_RES_CHKSUM 3  ///< checksum 錯誤 @ingroup remoslave_macro
+#define REMOSLAVE_RES_BYTES  4  ///< 位元組數錯誤或超過 BUFF_MAX_SZ @ingroup remoslave_macro
+
+/**
+ * @brief 模式描述結構，存於 PROGMEM
+ * @ingroup remoslave_struct
+ */
+typedef struct {
+    uint8_t Header;   ///< 命令封包頭，0 為無封包頭。
+    uint8_t AddForm;  ///< RegAdd 編碼方式，REMOSLAVE_ADD_*。
+    uint8_t Flags;    ///< REMOSLAVE_F_*。
+    uint8_t DefReg;   ///< 封包中沒有 RegAdd 時使用的暫存器位址。
+} RemoSlaveDescStr_t;
+
+/**
+ * @brief 遠端暫存器描述結構
+ * @ingroup remoslave_struct
+ */
+typedef struct {
+    void* volatile Data_p;  ///< 暫存器資料指標，NULL 為未註冊。
+    void* Back_p;           ///< 雙緩衝的接收緩衝區，NULL 為不使用雙緩衝。
+    uint8_t Bytes;          ///< 暫存器位元組數。
+    volatile uint8_t Seq;   ///< 版本序號，每次寫入加2，寫入中為奇數。
+} RemoSlaveRegStr_t;
+
+/**
+ * @brief RemoSlave 管理結構
+ * @ingroup remoslave_struct
+ */
+typedef struct {
+    RemoSlaveDescStr_t Desc;     ///< 由 PROGMEM 複製的模式描述。
+    uint8_t Bus;                 ///< SERIAL_TYPE_UART、_SPI、_TWI。
+    uint8_t Id;                  ///< 本裝置的 UART ID。
+    volatile uint8_t* Dr_p;      ///< 資料暫存器指標(UDRn、SPDR、TWDR)。
+    uint8_t Fb_Id;               ///< 接收(或 SPI、TWI)中斷功能方塊編號。
+    uint8_t TxFb_Id;             ///< UART 傳送中斷功能方塊編號。
+    RemoSlaveRegStr_t* Reg_p;    ///< 暫存器描述陣列，以 RegAdd 為索引。
+    uint8_t RegTotal;            ///< 暫存器描述數量。
+    uint8_t Dir;                 ///< 封包無 R/W 位元時的方向。
+
+    uint8_t State;               ///< 接收狀態。
+    uint8_t Rw;                  ///< 目前封包方向。
+    uint8_t RegAdd;              ///< 目前封包暫存器位址。
+    uint8_t Bytes;               ///< 目前暫存器位元組數。
+    uint8_t Count;               ///< 已接收資料位元組數。
+    uint8_t Sum;                 ///< 接收 checksum。
+    uint8_t Echo;                ///< F_ECHO 時下一個回傳的位元組。
+    uint8_t* Buf_p;              ///< 目前封包的接收或傳送緩衝區。
+    uint8_t Temp[BUFF_MAX_SZ];   ///< 非雙緩衝暫存器 checksum 確認前的寫入資料。
+
+    uint8_t Bulk;                ///< 目前封包為批次傳輸。
+    uint8_t BulkNum;             ///< 批次列表項數。
+    uint8_t BulkIdx;             ///< 目前處理的列表項。
+    uint8_t BulkErr;             ///< 批次列表錯誤，REMOSLAVE_RES_*。
+    uint8_t BulkTemp;            ///< 批次寫入已使用的 Temp 位元組數。
+    uint16_t BulkLeft;           ///< 批次寫入尚未收到的資料位元組數。
+    uint8_t BulkAdd[REMOSLAVE_BULK_MAX];  ///< 批次列表中的 RegAdd。
+
+    uint8_t TxHeader;            ///< 回應封包頭，0 為不送。
+    uint8_t TxLeft;              ///< 尚未送出的資料位元組數。
+    uint8_t TxIndex;             ///< 下一個送出的資料位元組索引。
+    uint8_t TxChk;               ///< 資料後是否送出 checksum。
+    uint8_t TxSum;               ///< 傳送 checksum。
+    volatile uint8_t TxActive;   ///< UART 正在送出回應。
+
+    volatile uint8_t Cf;         ///< 最後收到的控制旗標(ADD_CF)。
+    volatile uint8_t Result;     ///< 最後一個封包的結果，REMOSLAVE_RES_*。
+    volatile uint8_t Packets;    ///< 已完成的封包數。
+} RemoSlaveStr_t;
+
+/**
+ * @brief 初始化 RemoSlave 並載入模式描述。
+ *
+ * @ingroup remoslave_func
+ * @param Str_p    RemoSlave 管理結構指標。
+ * @param Bus      SERIAL_TYPE_UART、SERIAL_TYPE_SPI 或 SERIAL_TYPE_TWI。
+ * @param Num      UART 硬體編號 0 或 1，SPI、TWI 不使用。
+ * @param Mode     通訊模式，與 Master 端 *_trm / *_rec 相同。
+ * @param Id       本裝置的 UART ID，只用於帶 UID 的模式。
+ * @param Reg_p    暫存器描述陣列，以 RegAdd 為索引。
+ * @param RegTotal 暫存器描述數量。
+ * @return uint8_t 錯誤代碼：
+ *   - 0：成功無誤。
+ *   - 1：參數 Bus 或 Num 錯誤。
+ *   - 3：Mode 帶 R/W 位元，但 Reg_p[REMOSLAVE_BULK_REG] 有資料指標；
+ *        該位址保留為批次標記，Master 無法存取。
+ *   - 5：參數 Mode 錯誤。
+ *
+ * 只設定狀態機，不註冊中斷，請再呼叫 RemoSlave_uartReg、
+ * RemoSlave_spiReg 或 RemoSlave_twiReg。
+ */
+uint8_t RemoSlave_net(RemoSlaveStr_t* Str_p, uint8_t Bus, uint8_t Num,
+                      uint8_t Mode, uint8_t Id, RemoSlaveRegStr_t* Reg_p,
+                      uint8_t RegTotal);
+
+/**
+ * @brief 設定封包中沒有 R/W 位元時 UART、SPI 的方向。
+ *
+ * @ingroup remoslave_func
+ * @param Str_p RemoSlave 管理結構指標。
+ * @param Dir   REMOSLAVE_W 或 REMOSLAVE_R。
+ *
+ * UART 無 RegAdd 的讀取模式沒有命令可觸發回應，設定為 REMOSLAVE_R 時
+ * 立即開始送出 DefReg 的內容。
+ */
+void RemoSlave_setDir(RemoSlaveStr_t* Str_p, uint8_t Dir);
+
+/**
+ * @brief 開始一個封包(SPI CS 拉低、TWI 位址相符)。
+ *
+ * @ingroup remoslave_func
+ * @param Str_p RemoSlave 管理結構指標。
+ * @param Rw    匯流排指示的方向，REMOSLAVE_W 或 REMOSLAVE_R。
+ */
+void RemoSlave_start(RemoSlaveStr_t* Str_p, uint8_t Rw);
+
+/**
+ * @brief 處理一個收到的位元組。
+ * @ingroup remoslave_func
+ */
+void RemoSlave_rx(RemoSlaveStr_t* Str_p, uint8_t Data);
+
+/**
+ * @brief 取得下一個要送出的位元組。
+ *
+ * @ingroup remoslave_func
+ * @return uint8_t 回應位元組，沒有回應時為 0。
+ */
+uint8_t RemoSlave_tx(RemoSlaveStr_t* Str_p);
+
+/**
+ * @brief 封包結束(SPI CS 拉高、TWI STOP)，捨棄未收完的寫入。
+ * @ingroup remoslave_func
+ */
+void RemoSlave_stop(RemoSlaveStr_t* Str_p);
+
+/**
+ * @brief 取得暫存器目前的資料指標。
+ *
+ * @ingroup remoslave_func
+ * @param Str_p  RemoSlave 管理結構指標。
+ * @param RegAdd 暫存器位址。
+ * @return void* 資料指標，RegAdd 錯誤時為 NULL。
+ *
+ * 雙緩衝暫存器的 Data_p 會在中斷中交換，前景須經由此函式讀取指標。
+ * 取得的緩衝區在下一筆寫入完成時成為接收緩衝區，需完整內容時請使用
+ * RemoSlave_regRead。
+ */
+void* RemoSlave_regData(RemoSlaveStr_t* Str_p, uint8_t RegAdd);
+
+/**
+ * @brief 不關閉中斷複製完整的暫存器內容。
+ *
+ * @ingroup remoslave_func
+ * @param Str_p  RemoSlave 管理結構指標。
+ * @param RegAdd 暫存器位址。
+ * @param Data_p 複製目的地，大小須為暫存器位元組數。
+ * @param Seq_p  回傳複製內容的版本序號，可為 NULL。
+ * @return uint8_t 錯誤代碼：
+ *   - 0：成功無誤。
+ *   - 2：RegAdd 錯誤。
+ *
+ * 複製前後讀取 Seq，兩者不同(複製期間中斷寫入了暫存器)時重新複製。
+ * 只有讀取資料指標的兩個位元組時關閉中斷。
+ */
+uint8_t RemoSlave_regRead(RemoSlaveStr_t* Str_p, uint8_t RegAdd, void* Data_p,
+                          uint8_t* Seq_p);
+
+/**
+ * @brief 查詢暫存器自指定版本後是否被寫入。
+ *
+ * @ingroup remoslave_func
+ * @param Str_p  RemoSlave 管理結構指標。
+ * @param RegAdd 暫存器位址。
+ * @param Seq    上次 RemoSlave_regRead 回傳的版本序號。
+ * @return uint8_t 1：已被寫入，0：未被寫入或 RegAdd 錯誤。
+ *
+ * Seq 為 8 位元，兩次查詢之間寫入超過 127 次時可能誤判為未寫入。
+ */
+uint8_t RemoSlave_regChanged(RemoSlaveStr_t* Str_p, uint8_t RegAdd,
+                             uint8_t Seq);
+
+/**
+ * @brief 註冊至 UART 傳送與接收中斷。
+ *
+ * @ingroup remoslave_func
+ * @param Str_p        RemoSlave 管理結構指標。
+ * @param UartIntStr_p 已完成 UartInt_net 的 UART 中斷結構指標。
+ */
+void RemoSlave_uartReg(RemoSlaveStr_t* Str_p, UartIntStr_t* UartIntStr_p);
+
+/**
+ * @brief 註冊至 SPI 中斷。
+ *
+ * @ingroup remoslave_func
+ * @param Str_p       RemoSlave 管理結構指標。
+ * @param SpiIntStr_p 已完成 SpiInt_net 的 SPI 中斷結構指標。
+ *
+ * CS 拉低的外部中斷可另以 ExtInt_reg 註冊 RemoSlave_csStep 重新同步。
+ */
+void RemoSlave_spiReg(RemoSlaveStr_t* Str_p, SpiIntStr_t* SpiIntStr_p);
+
+/**
+ * @brief 註冊至 TWI 中斷。
+ *
+ * @ingroup remoslave_func
+ * @param Str_p       RemoSlave 管理結構指標。
+ * @param TwiIntStr_p 已完成 TwiInt_net 的 TWI 中斷結構指標。
+ *
+ * TWAR 須由使用者依 SLA 設定。
+ */
+void RemoSlave_twiReg(RemoSlaveStr_t* Str_p, TwiIntStr_t* TwiIntStr_p);
+
+/**
+ * @brief UART 接收完成中斷執行片段，由 RemoSlave_uartReg 註冊。
+ * @ingroup remoslave_func
+ */
+void RemoSlave_uartRxStep(void* Str_p);
+
+/**
+ * @brief UART 傳送完成中斷執行片段，由 RemoSlave_uartReg 註冊。
+ * @ingroup remoslave_func
+ */
+void RemoSlave_uartTxStep(void* Str_p);
+
+/**
+ * @brief SPI 傳輸完成中斷執行片段，由 RemoSlave_spiReg 註冊。
+ * @ingroup remoslave_func
+ */
+void RemoSlave_spiStep(void* Str_p);
+
+/**
+ * @brief SPI CS 拉低外部中斷執行片段。
+ * @ingroup remoslave_func
+ */
+void RemoSlave_csStep(void* Str_p);
+
+/**
+ * @brief TWI 中斷執行片段，由 RemoSlave_twiReg 註冊。
+ * @ingroup remoslave_func
+ */
+void RemoSlave_twiStep(void* Str_p);
+
+#endif  // REMO_SLAVE_H
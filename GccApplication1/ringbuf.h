@@ -0,0 +1,103 @@
+/**
+ * @file ringbuf.h
+ * @brief 單一生產者、單一消費者(SPSC)的無鎖環狀緩衝區。
+ *
+ * 緩衝區大小必須為2的冪次，讀寫索引皆為自由上數的8位元計數器，
+ * 以遮罩取得實際位置。生產者只寫 Head、消費者只寫 Tail，
+ * 因此中斷與主程式間不需關閉中斷即可安全存取。
+ */
+
+#ifndef RINGBUF_H
+#define RINGBUF_H
+
+#include <stdint.h>
+
+#define RINGBUF_MAX_SZ 128  ///< 緩衝區最大大小 @ingroup ringbuf_macro
+
+/**
+ * @brief 環狀緩衝區結構
+ * @ingroup ringbuf_struct
+ */
+typedef struct {
+    uint8_t* Buf_p;         ///< 資料緩衝區指標。
+    uint8_t Mask;           ///< 大小減一，用以取得實際位置。
+    volatile uint8_t Head;  ///< 寫入計數，只由生產者修改。
+    volatile uint8_t Tail;  ///< 讀出計數，只由消費者修改。
+} RingBufStr_t;
+
+/**
+ * @brief 鏈結環狀緩衝區與資料空間。
+ *
+ * @ingroup ringbuf_func
+ * @param Str_p 環狀緩衝區結構指標。
+ * @param Buf_p 資料空間指標。
+ * @param Size  資料空間大小，須為2的冪次且介於2~RINGBUF_MAX_SZ。
+ * @return uint8_t 錯誤代碼：
+ *   - 0：成功無誤。
+ *   - 1：參數 Size 錯誤。
+ */
+static inline uint8_t RingBuf_net(RingBufStr_t* Str_p, uint8_t* Buf_p,
+                                  uint8_t Size) {
+    if (Size < 2 || Size > RINGBUF_MAX_SZ || (Size & (Size - 1))) {
+        return 1;
+    }
+    Str_p->Buf_p = Buf_p;
+    Str_p->Mask  = Size - 1;
+    Str_p->Head  = 0;
+    Str_p->Tail  = 0;
+    return 0;
+}
+
+/**
+ * @brief 取得緩衝區內資料筆數。
+ * @ingroup ringbuf_func
+ */
+static inline uint8_t RingBuf_count(RingBufStr_t* Str_p) {
+    return (uint8_t)(Str_p->Head - Str_p->Tail);
+}
+
+/**
+ * @brief 取得緩衝區剩餘空間。
+ * @ingroup ringbuf_func
+ */
+static inline uint8_t RingBuf_space(RingBufStr_t* Str_p) {
+    return (uint8_t)(Str_p->Mask + 1 - RingBuf_count(Str_p));
+}
+
+/**
+ * @brief 放入一筆資料，只能由生產者呼叫。
+ *
+ * @ingroup ringbuf_func
+ * @return uint8_t 錯誤代碼：
+ *   - 0：成功無誤。
+ *   - 1：緩衝區已滿。
+ */
+static inline uint8_t RingBuf_put(RingBufStr_t* Str_p, uint8_t Data) {
+    uint8_t head = Str_p->Head;
+    if ((uint8_t)(head - Str_p->Tail) > Str_p->Mask) {
+        return 1;
+    }
+    Str_p->Buf_p[head & Str_p->Mask] = Data;
+    Str_p->Head = head + 1;
+    return 0;
+}
+
+/**
+ * @brief 取出一筆資料，只能由消費者呼叫。
+ *
+ * @ingroup ringbuf_func
+ * @return uint8_t 錯誤代碼：
+ *   - 0：成功無誤。
+ *   - 1：緩衝區為空。
+ */
+static inline uint8_t RingBuf_get(RingBufStr_t* Str_p, uint8_t* Data_p) {
+    uint8_t tail = Str_p->Tail;
+    if (tail == Str_p->Head) {
+        return 1;
+    }
+    *Data_p = Str_p->Buf_p[tail & Str_p->Mask];
+    Str_p->Tail = tail + 1;
+    return 0;
+}
+
+#endif  // RINGBUF_H
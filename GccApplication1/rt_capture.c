@@ -0,0 +1,161 @@
+/**
+ * @file rt_capture.c
+ * @brief RealTimePort 邏輯分析儀式擷取實作。
+ */
+
+#include "rt_capture.h"
+
+#define PUT_CHUNK 254
+
+/* 記錄一個讀值，回傳是否開始了新的一筆 */
+static uint8_t RtCapture_push(RtCaptureStr_t* Str_p, uint8_t Sample,
+                              uint8_t New) {
+    uint16_t head = Str_p->Head;
+    uint8_t* last_p;
+
+    if (Str_p->Rle) {
+        if (!New && Str_p->Count) {
+            last_p = &Str_p->Buf_p[(head ? head : Str_p->Entries) * 2 - 2];
+            if (last_p[0] == Sample && last_p[1] != 0xFF) {
+                last_p[1]++;
+                return 0;
+            }
+        }
+        Str_p->Buf_p[head * 2]     = Sample;
+        Str_p->Buf_p[head * 2 + 1] = 1;
+    }
+    else {
+        Str_p->Buf_p[head] = Sample;
+    }
+    Str_p->Head = (head + 1 == Str_p->Entries) ? 0 : head + 1;
+    if (Str_p->Count < Str_p->Entries) {
+        Str_p->Count++;
+    }
+    return 1;
+}
+
+static void RtCapture_reverse(uint8_t* Buf_p, uint16_t Lo, uint16_t Hi) {
+    uint8_t temp;
+
+    while (Lo + 1 < Hi) {
+        Hi--;
+        temp      = Buf_p[Lo];
+        Buf_p[Lo] = Buf_p[Hi];
+        Buf_p[Hi] = temp;
+        Lo++;
+    }
+}
+
+uint8_t RtCapture_net(RtCaptureStr_t* Str_p, RealTimePortStr_t* Port_p,
+                      uint8_t* Buf_p, uint16_t Size, uint8_t Rle) {
+    if (Port_p->Bytes != 1) {
+        return 1;
+    }
+    if (Size < (Rle ? 4 : 2)) {
+        return 2;
+    }
+    Str_p->Port_p  = Port_p;
+    Str_p->Buf_p   = Buf_p;
+    Str_p->Rle     = Rle ? 1 : 0;
+    Str_p->Entries = Rle ? Size / 2 : Size;
+    Str_p->State   = RTCAPTURE_ST_IDLE;
+    return 0;
+}
+
+uint8_t RtCapture_arm(RtCaptureStr_t* Str_p, uint8_t Mode, uint8_t Mask,
+                      uint8_t Value, uint16_t Pre, uint16_t Post) {
+    uint8_t sreg;
+
+    if (Mode > RTCAPTURE_TRIG_EDGE) {
+        return 1;
+    }
+    if ((uint32_t)Pre + Post + 1 > Str_p->Entries) {
+        return 2;
+    }
+
+    sreg = SREG;
+    cli();
+    Str_p->Mode  = Mode;
+    Str_p->Mask  = Mask;
+    Str_p->Value = Value & Mask;
+    Str_p->Pre   = Pre;
+    Str_p->Post  = Post;
+    Str_p->Head  = 0;
+    Str_p->Count = 0;
+    Str_p->Prev  = *Str_p->Port_p->Reg_p;
+    Str_p->State = RTCAPTURE_ST_ARMED;
+    SREG         = sreg;
+    return 0;
+}
+
+uint8_t RtCapture_isDone(RtCaptureStr_t* Str_p) {
+    return Str_p->State == RTCAPTURE_ST_DONE;
+}
+
+uint8_t RtCapture_put(RtCaptureStr_t* Str_p) {
+    uint8_t size = Str_p->Rle ? 2 : 1;
+    uint16_t total;
+    uint16_t len;
+
+    if (Str_p->State != RTCAPTURE_ST_DONE) {
+        return 1;
+    }
+    /* 以三次反轉將 First 移到編號 0 */
+    if (Str_p->First) {
+        total = Str_p->Entries * size;
+        RtCapture_reverse(Str_p->Buf_p, 0, Str_p->First * size);
+        RtCapture_reverse(Str_p->Buf_p, Str_p->First * size, total);
+        RtCapture_reverse(Str_p->Buf_p, 0, total);
+        Str_p->First = 0;
+    }
+
+    total = Str_p->Num * size;
+    for (uint16_t i = 0; i < total; i += len) {
+        len = (total - i > PUT_CHUNK) ? PUT_CHUNK : total - i;
+        if (HMI_put_array(HMI_TYPE_UI8, len, &Str_p->Buf_p[i])) {
+            return 2;
+        }
+    }
+    return 0;
+}
+
+void RtCapture_step(void* void_p) {
+    RtCaptureStr_t* Str_p     = (RtCaptureStr_t*)void_p;
+    RealTimePortStr_t* port_p = Str_p->Port_p;
+    uint8_t sample            = *port_p->Reg_p;
+    uint8_t hit;
+
+    port_p->Buff[0] = sample;
+    port_p->TrigCount++;
+
+    if (Str_p->State == RTCAPTURE_ST_ARMED) {
+        hit = ((sample & Str_p->Mask) == Str_p->Value);
+        if (Str_p->Mode == RTCAPTURE_TRIG_NOW) {
+            hit = 1;
+        }
+        else if (Str_p->Mode == RTCAPTURE_TRIG_EDGE &&
+                 (Str_p->Prev & Str_p->Mask) == Str_p->Value) {
+            hit = 0;
+        }
+        Str_p->Prev = sample;
+        if (!hit) {
+            RtCapture_push(Str_p, sample, 0);
+            return;
+        }
+        /* 觸發的讀值一定開始新的一筆，TrigPos 才能指到觸發點 */
+        Str_p->TrigPos =
+            (Str_p->Count < Str_p->Pre) ? Str_p->Count : Str_p->Pre;
+        Str_p->First = (Str_p->Head >= Str_p->TrigPos)
+                           ? Str_p->Head - Str_p->TrigPos
+                           : Str_p->Head + Str_p->Entries - Str_p->TrigPos;
+        Str_p->Num   = Str_p->TrigPos + 1 + Str_p->Post;
+        Str_p->Left  = Str_p->Post;
+        RtCapture_push(Str_p, sample, 1);
+        Str_p->State = Str_p->Post ? RTCAPTURE_ST_TRIG : RTCAPTURE_ST_DONE;
+    }
+    else if (Str_p->State == RTCAPTURE_ST_TRIG) {
+        if (RtCapture_push(Str_p, sample, 0) && --Str_p->Left == 0) {
+            Str_p->State = RTCAPTURE_ST_DONE;
+        }
+    }
+}
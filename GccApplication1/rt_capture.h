@@ -0,0 +1,133 @@
+/**
+ * @file rt_capture.h
+ * @brief RealTimePort 邏輯分析儀式擷取。
+ *
+ * RealTimePortIn_step 每次只把讀值存入 Buff，下一次觸發即被覆蓋。
+ * RtCapture_step 讀取同一個 RealTimePortStr_t 的暫存器，更新 Buff 與
+ * TrigCount 後，再把讀值記錄到使用者提供的環形緩衝區，可直接取代
+ * RealTimePortIn_step 註冊在任一中斷上，取樣率即為該中斷的頻率。
+ *
+ * 觸發條件以 Mask、Value 比對讀值：
+ *   - RTCAPTURE_TRIG_NOW：立即觸發。
+ *   - RTCAPTURE_TRIG_PATTERN：(讀值 & Mask) == Value 時觸發。
+ *   - RTCAPTURE_TRIG_EDGE：讀值由不符合變為符合時觸發。
+ *
+ * 觸發前保留最多 Pre 筆、觸發後再記錄 Post 筆即停止。開啟 RLE 時每筆
+ * 紀錄為 [讀值][連續次數]，讀值不變只增加次數，次數滿 255 才開始新的
+ * 一筆；關閉時每筆為一個讀值。Pre、Post 皆以紀錄筆數計算。
+ */
+
+#ifndef RT_CAPTURE_H
+#define RT_CAPTURE_H
+
+#include "c4mlib.h"
+
+#define RTCAPTURE_TRIG_NOW     0  ///< 立即觸發 @ingroup rtcapture_macro
+#define RTCAPTURE_TRIG_PATTERN 1  ///< 符合樣式時觸發 @ingroup rtcapture_macro
+#define RTCAPTURE_TRIG_EDGE    2  ///< 變為符合樣式時觸發 @ingroup rtcapture_macro
+
+#define RTCAPTURE_ST_IDLE  0  ///< 尚未啟動 @ingroup rtcapture_macro
+#define RTCAPTURE_ST_ARMED 1  ///< 等待觸發 @ingroup rtcapture_macro
+#define RTCAPTURE_ST_TRIG  2  ///< 已觸發，記錄觸發後資料 @ingroup rtcapture_macro
+#define RTCAPTURE_ST_DONE  3  ///< 擷取完成 @ingroup rtcapture_macro
+
+/**
+ * @brief RtCapture 結構原型
+ * @ingroup rtcapture_struct
+ *
+ * 擷取完成後 First 為最早一筆紀錄的編號、Num 為紀錄筆數、TrigPos 為
+ * 觸發紀錄在其中的位置；RtCapture_put 會將緩衝區重新排列為由編號 0
+ * 開始。
+ */
+typedef struct {
+    RealTimePortStr_t* Port_p;  ///< 取樣的 RealTimePort 結構指標。
+    uint8_t* Buf_p;             ///< 紀錄緩衝區。
+    uint16_t Entries;           ///< 緩衝區可存放的紀錄筆數。
+    uint8_t Rle;                ///< 是否使用 RLE 壓縮。
+    uint8_t Mode;               ///< 觸發模式。
+    uint8_t Mask;               ///< 觸發比對遮罩。
+    uint8_t Value;              ///< 觸發比對值。
+    uint16_t Pre;               ///< 觸發前保留筆數。
+    uint16_t Post;              ///< 觸發後記錄筆數。
+    volatile uint8_t State;     ///< 擷取狀態。
+    uint8_t Prev;               ///< 上一次讀值，供邊緣觸發判斷。
+    uint16_t Head;              ///< 下一筆紀錄的編號。
+    uint16_t Count;             ///< 觸發前已記錄筆數，最多 Entries。
+    uint16_t Left;              ///< 觸發後尚需記錄筆數。
+    uint16_t First;             ///< 最早一筆紀錄的編號。
+    uint16_t Num;               ///< 紀錄筆數。
+    uint16_t TrigPos;           ///< 觸發紀錄相對於 First 的位置。
+} RtCaptureStr_t;
+
+/**
+ * @brief 鏈結結構實體、RealTimePort 與紀錄緩衝區。
+ *
+ * @ingroup rtcapture_func
+ * @param Str_p  RtCapture 結構指標。
+ * @param Port_p 已以 RealTimePort_net 鏈結的結構指標。
+ * @param Buf_p  紀錄緩衝區。
+ * @param Size   緩衝區位元組數。
+ * @param Rle    1 使用 RLE 壓縮，0 不使用。
+ * @return uint8_t 錯誤代碼：
+ *   - 0：成功無誤。
+ *   - 1：Port_p 的暫存器不是 1 byte。
+ *   - 2：參數 Size 不足兩筆紀錄。
+ */
+uint8_t RtCapture_net(RtCaptureStr_t* Str_p, RealTimePortStr_t* Port_p,
+                      uint8_t* Buf_p, uint16_t Size, uint8_t Rle);
+
+/**
+ * @brief 設定觸發條件並開始擷取。
+ *
+ * @ingroup rtcapture_func
+ * @param Str_p RtCapture 結構指標。
+ * @param Mode  觸發模式。
+ * @param Mask  觸發比對遮罩。
+ * @param Value 觸發比對值。
+ * @param Pre   觸發前保留筆數。
+ * @param Post  觸發後記錄筆數。
+ * @return uint8_t 錯誤代碼：
+ *   - 0：成功無誤。
+ *   - 1：參數 Mode 錯誤。
+ *   - 2：Pre + Post + 1 超過緩衝區筆數。
+ *
+ * 觸發前記錄不足 Pre 筆時只保留已記錄的部分。
+ */
+uint8_t RtCapture_arm(RtCaptureStr_t* Str_p, uint8_t Mode, uint8_t Mask,
+                      uint8_t Value, uint16_t Pre, uint16_t Post);
+
+/**
+ * @brief 查詢擷取是否完成。
+ *
+ * @ingroup rtcapture_func
+ * @return uint8_t 1 表示擷取完成。
+ */
+uint8_t RtCapture_isDone(RtCaptureStr_t* Str_p);
+
+/**
+ * @brief 將擷取結果透過 HMI_put_array 送出。
+ *
+ * @ingroup rtcapture_func
+ * @param Str_p RtCapture 結構指標。
+ * @return uint8_t 錯誤代碼：
+ *   - 0：成功無誤。
+ *   - 1：擷取尚未完成。
+ *   - 2：HMI_put_array 錯誤。
+ *
+ * 先將緩衝區重新排列為由最早一筆開始，再以 HMI_TYPE_UI8 陣列分段送出，
+ * 每段最多 254 位元組，RLE 時每兩個位元組為一筆 [讀值][連續次數]。
+ */
+uint8_t RtCapture_put(RtCaptureStr_t* Str_p);
+
+/**
+ * @brief 讀取一次暫存器並記錄，可登錄在中斷服務常式中執行。
+ *
+ * @ingroup rtcapture_func
+ * @param void_p RtCapture 結構指標。
+ *
+ * 與 RealTimePortIn_step 相同地更新 Buff[0] 與 TrigCount，擷取進行中
+ * 時再依觸發條件記錄讀值。
+ */
+void RtCapture_step(void* void_p);
+
+#endif  // RT_CAPTURE_H
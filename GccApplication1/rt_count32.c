@@ -0,0 +1,70 @@
+/**
+ * @file rt_count32.c
+ * @brief 32 位元觸發計數與速率估計實作。
+ */
+
+#include "rt_count32.h"
+
+#define HIST_MASK (RTUPCOUNT32_WINDOW - 1)
+
+uint8_t RtUpCount32_net(RtUpCount32Str_t* Str_p, uint16_t Hz) {
+    uint8_t sreg = SREG;
+    cli();
+    Str_p->Count   = 0;
+    Str_p->Hz      = Hz;
+    Str_p->HistIdx = 0;
+    Str_p->HistNum = 0;
+    Str_p->Rate    = 0;
+    SREG           = sreg;
+    return 0;
+}
+
+void RtUpCount32_step(void* void_p) {
+    ((RtUpCount32Str_t*)void_p)->Count++;
+}
+
+uint32_t RtUpCount32_get(RtUpCount32Str_t* Str_p) {
+    uint32_t count;
+
+    /* 兩次讀值相同表示中途沒有被加1，讀到的四個位元組屬於同一個值 */
+    do {
+        count = Str_p->Count;
+    } while (count != Str_p->Count);
+    return count;
+}
+
+void RtUpCount32_snapshot(RtUpCount32Str_t** Str_pp, uint8_t Num,
+                          uint32_t* Data_p) {
+    uint8_t sreg = SREG;
+    cli();
+    for (uint8_t i = 0; i < Num; i++) {
+        Data_p[i] = Str_pp[i]->Count;
+    }
+    SREG = sreg;
+}
+
+void RtUpCount32_rate(void* void_p) {
+    RtUpCount32Str_t* Str_p = (RtUpCount32Str_t*)void_p;
+    uint32_t count          = Str_p->Count;
+    uint8_t idx             = Str_p->HistIdx;
+
+    /* Hist[idx] 為 RTUPCOUNT32_WINDOW 週期前的計數值 */
+    if (Str_p->HistNum == RTUPCOUNT32_WINDOW) {
+        Str_p->Rate =
+            (count - Str_p->Hist[idx]) * Str_p->Hz / RTUPCOUNT32_WINDOW;
+    }
+    else {
+        Str_p->HistNum++;
+    }
+    Str_p->Hist[idx] = count;
+    Str_p->HistIdx   = (idx + 1) & HIST_MASK;
+}
+
+uint32_t RtUpCount32_getRate(RtUpCount32Str_t* Str_p) {
+    uint32_t rate;
+    uint8_t sreg = SREG;
+    cli();
+    rate = Str_p->Rate;
+    SREG = sreg;
+    return rate;
+}
@@ -0,0 +1,103 @@
+/**
+ * @file rt_count32.h
+ * @brief 32 位元觸發計數與速率估計。
+ *
+ * RealTimeUpCountStr_t 的 TrigCount 只有 8 位元，每 256 次就溢位，也無法
+ * 與其他計數在同一時刻讀取，不適合量測編碼器等事件速率。
+ *
+ * RtUpCount32_step 在中斷中將 32 位元 Count 加1，只有一次載入、加法與
+ * 存回，不關中斷。主程式以 RtUpCount32_get 無鎖讀取：連續兩次讀值相同
+ * 才採用，讀取中途被計數中斷打斷時重讀。
+ *
+ * 將 RtUpCount32_rate 以 IntFreqDiv_reg 註冊為每秒 Hz 次，每次以最近
+ * RTUPCOUNT32_WINDOW 個週期的計數差換算為每秒事件數。
+ */
+
+#ifndef RT_COUNT32_H
+#define RT_COUNT32_H
+
+#include "c4mlib.h"
+
+#if RTUPCOUNT32_WINDOW < 1 || RTUPCOUNT32_WINDOW > 128 || \
+    (RTUPCOUNT32_WINDOW & (RTUPCOUNT32_WINDOW - 1))
+#    error "RTUPCOUNT32_WINDOW must be a power of two between 1 and 128"
+#endif
+
+/**
+ * @brief RtUpCount32 結構原型
+ * @ingroup rtcount32_struct
+ *
+ * Hist 存放最近 RTUPCOUNT32_WINDOW 次 RtUpCount32_rate 時的計數值。
+ * Rate 在視窗填滿前為 0。
+ */
+typedef struct {
+    uint8_t Fb_Id;                     ///< 中斷中功能方塊名單編號。
+    volatile uint32_t Count;           ///< 觸發次數計數值。
+    uint16_t Hz;                       ///< RtUpCount32_rate 每秒執行次數。
+    uint8_t HistIdx;                   ///< 下一個寫入的 Hist 位置。
+    uint8_t HistNum;                   ///< Hist 已填入的數量。
+    uint32_t Hist[RTUPCOUNT32_WINDOW]; ///< 歷史計數值。
+    volatile uint32_t Rate;            ///< 每秒事件數。
+} RtUpCount32Str_t;
+
+/**
+ * @brief 初始化結構，清除計數與速率。
+ *
+ * @ingroup rtcount32_func
+ * @param Str_p RtUpCount32 結構指標。
+ * @param Hz    RtUpCount32_rate 每秒執行次數，不使用速率估計時填 0。
+ * @return uint8_t 錯誤代碼：
+ *   - 0：成功無誤。
+ */
+uint8_t RtUpCount32_net(RtUpCount32Str_t* Str_p, uint16_t Hz);
+
+/**
+ * @brief 將觸發計數+1，可登錄在中斷服務常式中執行。
+ * @ingroup rtcount32_func
+ */
+void RtUpCount32_step(void* void_p);
+
+/**
+ * @brief 無鎖讀取計數值。
+ *
+ * @ingroup rtcount32_func
+ * @return uint32_t 計數值。
+ *
+ * 只能在主程式或比計數中斷優先權低的地方呼叫。
+ */
+uint32_t RtUpCount32_get(RtUpCount32Str_t* Str_p);
+
+/**
+ * @brief 在同一時刻讀取多個計數值。
+ *
+ * @ingroup rtcount32_func
+ * @param Str_pp 計數結構指標列表。
+ * @param Num    計數數量。
+ * @param Data_p 存放計數值的陣列，至少 Num 個。
+ *
+ * 關閉中斷期間一次複製所有計數值，每個計數約 8 個週期。
+ */
+void RtUpCount32_snapshot(RtUpCount32Str_t** Str_pp, uint8_t Num,
+                          uint32_t* Data_p);
+
+/**
+ * @brief 更新速率估計，須以每秒 Hz 次的頻率執行。
+ *
+ * @ingroup rtcount32_func
+ * @param void_p RtUpCount32 結構指標。
+ *
+ * Rate = (Count - RTUPCOUNT32_WINDOW 週期前的 Count) × Hz
+ * / RTUPCOUNT32_WINDOW。須在中斷中或關閉中斷時執行，窗內計數差乘以 Hz
+ * 不可超過 32 位元。
+ */
+void RtUpCount32_rate(void* void_p);
+
+/**
+ * @brief 讀取每秒事件數。
+ *
+ * @ingroup rtcount32_func
+ * @return uint32_t 每秒事件數，視窗填滿前為 0。
+ */
+uint32_t RtUpCount32_getRate(RtUpCount32Str_t* Str_p);
+
+#endif  // RT_COUNT32_H
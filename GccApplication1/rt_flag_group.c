@@ -0,0 +1,87 @@
+/**
+ * @file rt_flag_group.c
+ * @brief RealTimeFlag 群組取樣與輸出實作。
+ */
+
+#include "rt_flag_group.h"
+
+uint8_t RtFlagGroup_net(RtFlagGroupStr_t* Str_p, RealTimeFlagStr_t** Flag_pp,
+                        uint8_t Num) {
+    RtFlagGroupMemStr_t* mem_p = Str_p->Mem;
+    RtFlagGroupRegStr_t* reg_p = NULL;
+    RealTimeFlagStr_t* flag_p;
+    uint8_t j;
+
+    if (Num == 0 || Num > RTFLAGGROUP_MAX_FLAG) {
+        return 1;
+    }
+
+    /* 插入排序，成員數少且只在 net 時執行一次 */
+    for (uint8_t i = 0; i < Num; i++) {
+        flag_p = Flag_pp[i];
+        for (j = i; j > 0 && mem_p[j - 1].Flag_p->Reg_p > flag_p->Reg_p; j--) {
+            mem_p[j] = mem_p[j - 1];
+        }
+        mem_p[j].Flag_p = flag_p;
+        mem_p[j].Mask   = flag_p->Mask;
+        mem_p[j].Up     = 1 << flag_p->Shift;
+        mem_p[j].Down   = 1 << (8 - flag_p->Shift);
+    }
+
+    Str_p->RegNum = 0;
+    for (uint8_t i = 0; i < Num; i++) {
+        flag_p = mem_p[i].Flag_p;
+        if (reg_p == NULL || reg_p->Reg_p != flag_p->Reg_p) {
+            if (Str_p->RegNum == RTFLAGGROUP_MAX_REG) {
+                return 2;
+            }
+            reg_p        = &Str_p->Reg[Str_p->RegNum++];
+            reg_p->Reg_p = flag_p->Reg_p;
+            reg_p->First = i;
+            reg_p->Num   = 0;
+            reg_p->Mask  = 0;
+        }
+        reg_p->Num++;
+        reg_p->Mask |= mem_p[i].Mask;
+    }
+    Str_p->Num       = Num;
+    Str_p->TrigCount = 0;
+    return 0;
+}
+
+void RtFlagGroupIn_step(void* void_p) {
+    RtFlagGroupStr_t* Str_p = (RtFlagGroupStr_t*)void_p;
+    RtFlagGroupRegStr_t* reg_p;
+    RtFlagGroupMemStr_t* mem_p;
+    uint8_t value;
+
+    for (uint8_t r = 0; r < Str_p->RegNum; r++) {
+        reg_p = &Str_p->Reg[r];
+        value = *reg_p->Reg_p;
+        mem_p = &Str_p->Mem[reg_p->First];
+        for (uint8_t i = 0; i < reg_p->Num; i++, mem_p++) {
+            mem_p->Flag_p->FlagsValue =
+                ((uint16_t)(value & mem_p->Mask) * mem_p->Down) >> 8;
+        }
+    }
+    Str_p->TrigCount++;
+}
+
+void RtFlagGroupOut_step(void* void_p) {
+    RtFlagGroupStr_t* Str_p = (RtFlagGroupStr_t*)void_p;
+    RtFlagGroupRegStr_t* reg_p;
+    RtFlagGroupMemStr_t* mem_p;
+    uint8_t value;
+
+    for (uint8_t r = 0; r < Str_p->RegNum; r++) {
+        reg_p = &Str_p->Reg[r];
+        value = 0;
+        mem_p = &Str_p->Mem[reg_p->First];
+        for (uint8_t i = 0; i < reg_p->Num; i++, mem_p++) {
+            value |= (uint8_t)(mem_p->Flag_p->FlagsValue * mem_p->Up) &
+                     mem_p->Mask;
+        }
+        *reg_p->Reg_p = (*reg_p->Reg_p & ~reg_p->Mask) | value;
+    }
+    Str_p->TrigCount++;
+}
@@ -0,0 +1,97 @@
+/**
+ * @file rt_flag_group.h
+ * @brief RealTimeFlag 群組取樣與輸出。
+ *
+ * 每個 RealTimeFlagStr_t 以 RealTimeFlagIn_step、RealTimeFlagOut_step
+ * 個別執行，各自呼叫一次函式、讀一次暫存器並增加自己的 TrigCount；
+ * 分布在 3 個埠上的 16 個旗標就要 16 次呼叫與 16 次暫存器讀取。
+ *
+ * RtFlagGroup 在 net 時將成員的 Mask 與由 Shift 換算的乘數複製到群組
+ * 內依 Reg_p 排序的成員表，並合併為暫存器表。每次 step 每個暫存器只
+ * 讀取一次，再以成員表取出旗標；輸出時每個暫存器只做一次讀改寫。
+ * AVR 沒有可變位數的移位指令，平移改以硬體乘法完成，不需逐位元迴圈。
+ * 群組只有一個共用的 TrigCount，成員自己的 TrigCount 不再增加。
+ *
+ * net 之後成員的 Reg_p、Mask、Shift 不可再改變。
+ */
+
+#ifndef RT_FLAG_GROUP_H
+#define RT_FLAG_GROUP_H
+
+#include "c4mlib.h"
+
+/**
+ * @brief 群組中的一個暫存器
+ * @ingroup rtflaggroup_struct
+ */
+typedef struct {
+    volatile uint8_t* Reg_p;  ///< 硬體暫存器指標。
+    uint8_t First;            ///< 第一個成員在排序後列表中的位置。
+    uint8_t Num;              ///< 使用此暫存器的成員數。
+    uint8_t Mask;             ///< 所有成員遮罩的聯集。
+} RtFlagGroupRegStr_t;
+
+/**
+ * @brief 群組中的一個成員
+ * @ingroup rtflaggroup_struct
+ *
+ * Up 為 1 << Shift，輸出值乘上 Up 即為左移；Down 為 1 << (8 - Shift)，
+ * 輸入值乘上 Down 後取高位元組即為右移。
+ */
+typedef struct {
+    RealTimeFlagStr_t* Flag_p;  ///< 成員指標。
+    uint8_t Mask;               ///< 成員遮罩。
+    uint8_t Up;                 ///< 輸出乘數。
+    uint16_t Down;              ///< 輸入乘數。
+} RtFlagGroupMemStr_t;
+
+/**
+ * @brief RtFlagGroup 結構原型
+ * @ingroup rtflaggroup_struct
+ */
+typedef struct {
+    RtFlagGroupMemStr_t Mem[RTFLAGGROUP_MAX_FLAG];  ///< 成員表，依 Reg_p 排序。
+    uint8_t Num;                                    ///< 成員數。
+    uint8_t RegNum;                                 ///< 暫存器數。
+    RtFlagGroupRegStr_t Reg[RTFLAGGROUP_MAX_REG];   ///< 暫存器表。
+    volatile uint8_t TrigCount;                     ///< 觸發次數計數值。
+} RtFlagGroupStr_t;
+
+/**
+ * @brief 鏈結已以 RealTimeFlag_net 設定好的成員並建立暫存器表。
+ *
+ * @ingroup rtflaggroup_func
+ * @param Str_p   RtFlagGroup 結構指標。
+ * @param Flag_pp 成員指標列表，呼叫返回後即可重複使用。
+ * @param Num     成員數。
+ * @return uint8_t 錯誤代碼：
+ *   - 0：成功無誤。
+ *   - 1：參數 Num 為0或大於 RTFLAGGROUP_MAX_FLAG。
+ *   - 2：成員使用的暫存器超過 RTFLAGGROUP_MAX_REG 個。
+ */
+uint8_t RtFlagGroup_net(RtFlagGroupStr_t* Str_p, RealTimeFlagStr_t** Flag_pp,
+                        uint8_t Num);
+
+/**
+ * @brief 讀取所有成員旗標，並將群組觸發計數+1。
+ *
+ * @ingroup rtflaggroup_func
+ * @param void_p RtFlagGroup 結構指標。
+ *
+ * 每個暫存器讀取一次，再依成員表存入各成員的 FlagsValue。
+ * 可登錄在中斷服務常式中執行。
+ */
+void RtFlagGroupIn_step(void* void_p);
+
+/**
+ * @brief 寫入所有成員旗標，並將群組觸發計數+1。
+ *
+ * @ingroup rtflaggroup_func
+ * @param void_p RtFlagGroup 結構指標。
+ *
+ * 將同一暫存器成員的 FlagsValue 合併後，對每個暫存器做一次讀改寫，
+ * 遮罩以外的位元不變。可登錄在中斷服務常式中執行。
+ */
+void RtFlagGroupOut_step(void* void_p);
+
+#endif  // RT_FLAG_GROUP_H
@@ -0,0 +1,171 @@
+/**
+ * @file rt_pattern.c
+ * @brief RealTimePort 輸出樣式播放實作。
+ */
+
+#include "rt_pattern.h"
+
+#include <avr/pgmspace.h>
+
+static uint8_t RtPattern_read(const uint8_t* Tab_p, uint16_t Index,
+                              uint8_t Flags) {
+    return (Flags & RTPATTERN_F_PGM) ? pgm_read_byte(&Tab_p[Index])
+                                     : Tab_p[Index];
+}
+
+/* 預先取出下一步，一輪結束時切換表、循環或進入最後一步 */
+static void RtPattern_fetch(RtPatternStr_t* Str_p) {
+    RtPatternSeqStr_t* seq_p = &Str_p->Seq[Str_p->Active];
+    uint8_t hold;
+
+    if (Str_p->Index == seq_p->Num) {
+        if (Str_p->Pending) {
+            Str_p->Active ^= 1;
+            Str_p->Pending = 0;
+            seq_p          = &Str_p->Seq[Str_p->Active];
+            if (Str_p->Func_p != NULL) {
+                Str_p->Func_p(Str_p->FuncPara_p);
+            }
+        }
+        else if (!(seq_p->Flags & RTPATTERN_F_LOOP)) {
+            Str_p->Run = RTPATTERN_LAST;
+            return;
+        }
+        Str_p->Index = 0;
+    }
+
+    Str_p->NextVal = RtPattern_read(seq_p->Data_p, Str_p->Index, seq_p->Flags);
+    hold           = 1;
+    if (seq_p->Hold_p != NULL) {
+        hold = RtPattern_read(seq_p->Hold_p, Str_p->Index, seq_p->Flags);
+    }
+    Str_p->NextHold = hold;
+    Str_p->Index++;
+}
+
+static void RtPattern_load(RtPatternSeqStr_t* Seq_p, const uint8_t* Data_p,
+                           const uint8_t* Hold_p, uint16_t Num,
+                           uint8_t Flags) {
+    Seq_p->Data_p = Data_p;
+    Seq_p->Hold_p = Hold_p;
+    Seq_p->Num    = Num;
+    Seq_p->Flags  = Flags;
+}
+
+uint8_t RtPattern_net(RtPatternStr_t* Str_p, RealTimePortStr_t* Port_p,
+                      Func_t Func_p, void* FuncPara_p) {
+    if (Port_p->Bytes != 1) {
+        return 1;
+    }
+    Str_p->Port_p     = Port_p;
+    Str_p->Func_p     = Func_p;
+    Str_p->FuncPara_p = FuncPara_p;
+    Str_p->Run        = RTPATTERN_STOP;
+    Str_p->Pending    = 0;
+    return 0;
+}
+
+/* 立即開始播放 Seq[0]，須在關閉中斷時呼叫 */
+static void RtPattern_begin(RtPatternStr_t* Str_p, const uint8_t* Data_p,
+                            const uint8_t* Hold_p, uint16_t Num,
+                            uint8_t Flags) {
+    Str_p->Active  = 0;
+    Str_p->Pending = 0;
+    RtPattern_load(&Str_p->Seq[0], Data_p, Hold_p, Num, Flags);
+    Str_p->Index = 0;
+    Str_p->Hold  = 0;
+    Str_p->Run   = RTPATTERN_RUN;
+    RtPattern_fetch(Str_p);
+}
+
+uint8_t RtPattern_start(RtPatternStr_t* Str_p, const uint8_t* Data_p,
+                        const uint8_t* Hold_p, uint16_t Num, uint8_t Flags) {
+    uint8_t sreg;
+
+    if (Num == 0) {
+        return 1;
+    }
+    sreg = SREG;
+    cli();
+    RtPattern_begin(Str_p, Data_p, Hold_p, Num, Flags);
+    SREG = sreg;
+    return 0;
+}
+
+uint8_t RtPattern_queue(RtPatternStr_t* Str_p, const uint8_t* Data_p,
+                        const uint8_t* Hold_p, uint16_t Num, uint8_t Flags) {
+    uint8_t result = 0;
+    uint8_t sreg;
+
+    if (Num == 0) {
+        return 1;
+    }
+
+    /* 中斷可能在任何時候由 LAST 進入 STOP，狀態須在關閉中斷後判斷 */
+    sreg = SREG;
+    cli();
+    if (Str_p->Run == RTPATTERN_STOP) {
+        RtPattern_begin(Str_p, Data_p, Hold_p, Num, Flags);
+    }
+    else if (Str_p->Pending) {
+        result = 2;
+    }
+    else if (Str_p->Run == RTPATTERN_LAST) {
+        /* 單次播放已取完，接在最後一步的保持之後，視同切換表執行 Func_p */
+        Str_p->Active ^= 1;
+        RtPattern_load(&Str_p->Seq[Str_p->Active], Data_p, Hold_p, Num,
+                       Flags);
+        Str_p->Index = 0;
+        Str_p->Run   = RTPATTERN_RUN;
+        RtPattern_fetch(Str_p);
+        if (Str_p->Func_p != NULL) {
+            Str_p->Func_p(Str_p->FuncPara_p);
+        }
+    }
+    else {
+        RtPattern_load(&Str_p->Seq[Str_p->Active ^ 1], Data_p, Hold_p, Num,
+                       Flags);
+        Str_p->Pending = 1;
+    }
+    SREG = sreg;
+    return result;
+}
+
+void RtPattern_stop(RtPatternStr_t* Str_p) {
+    uint8_t sreg = SREG;
+    cli();
+    Str_p->Run     = RTPATTERN_STOP;
+    Str_p->Pending = 0;
+    Str_p->Hold    = 0;
+    SREG           = sreg;
+}
+
+uint8_t RtPattern_isRunning(RtPatternStr_t* Str_p) {
+    return Str_p->Run != RTPATTERN_STOP;
+}
+
+void RtPattern_step(void* void_p) {
+    RtPatternStr_t* Str_p     = (RtPatternStr_t*)void_p;
+    RealTimePortStr_t* port_p = Str_p->Port_p;
+    uint8_t value             = Str_p->NextVal;
+
+    if (Str_p->Hold > 1) {
+        Str_p->Hold--;
+        return;
+    }
+    if (Str_p->Run != RTPATTERN_RUN) {
+        if (Str_p->Run == RTPATTERN_LAST) {
+            Str_p->Run = RTPATTERN_STOP;
+            if (Str_p->Func_p != NULL) {
+                Str_p->Func_p(Str_p->FuncPara_p);
+            }
+        }
+        return;
+    }
+
+    *port_p->Reg_p  = value;
+    port_p->Buff[0] = value;
+    port_p->TrigCount++;
+    Str_p->Hold = Str_p->NextHold;
+    RtPattern_fetch(Str_p);
+}
@@ -0,0 +1,137 @@
+/**
+ * @file rt_pattern.h
+ * @brief RealTimePort 輸出樣式播放。
+ *
+ * RealTimePortOut_step 每次只輸出 Buff 中的一個值，要輸出步進馬達相序、
+ * LED 矩陣掃描等樣式時，主程式必須以中斷的速率持續更新 Buff。
+ * RtPattern_step 可取代 RealTimePortOut_step 註冊在計時中斷上，依序
+ * 輸出一張輸出值表，不需要主程式參與。
+ *
+ * 每一步可另外指定保持次數，保持期間的中斷不改變輸出。下一步的輸出值
+ * 在上一次輸出後即預先取出，輸出時第一個動作就是寫入暫存器，與表格
+ * 位於 RAM 或 PROGMEM、是否換表無關，輸出時間的抖動只有中斷進入的
+ * 週期數差異。
+ *
+ * RtPattern_queue 排入的下一張表在目前這張表播放完一輪時切換，兩張表
+ * 之間沒有間隙。
+ */
+
+#ifndef RT_PATTERN_H
+#define RT_PATTERN_H
+
+#include "c4mlib.h"
+
+#define RTPATTERN_F_LOOP 0x01  ///< 播放完畢後重頭循環 @ingroup rtpattern_macro
+#define RTPATTERN_F_PGM  0x02  ///< 表格位於 PROGMEM @ingroup rtpattern_macro
+
+#define RTPATTERN_STOP 0  ///< 停止 @ingroup rtpattern_macro
+#define RTPATTERN_RUN  1  ///< 播放中 @ingroup rtpattern_macro
+#define RTPATTERN_LAST 2  ///< 單次播放的最後一步保持中 @ingroup rtpattern_macro
+
+/**
+ * @brief 輸出值表
+ * @ingroup rtpattern_struct
+ */
+typedef struct {
+    const uint8_t* Data_p;  ///< 輸出值表。
+    const uint8_t* Hold_p;  ///< 各步保持次數表，NULL 表示每步 1 次。
+    uint16_t Num;           ///< 步數。
+    uint8_t Flags;          ///< RTPATTERN_F_* 旗標。
+} RtPatternSeqStr_t;
+
+/**
+ * @brief RtPattern 結構原型
+ * @ingroup rtpattern_struct
+ *
+ * Seq[Active] 為播放中的表，Pending 為 1 時 Seq[Active ^ 1] 為排入的
+ * 下一張表，由中斷在一輪結束時切換並清除 Pending。
+ */
+typedef struct {
+    RealTimePortStr_t* Port_p;  ///< 輸出的 RealTimePort 結構指標。
+    RtPatternSeqStr_t Seq[2];   ///< 兩張輸出值表。
+    volatile uint8_t Active;    ///< 播放中的表編號。
+    volatile uint8_t Pending;   ///< 是否有排入的下一張表。
+    volatile uint8_t Run;       ///< 播放狀態。
+    uint16_t Index;             ///< 下一個要取出的步。
+    uint8_t Hold;               ///< 目前輸出值剩餘的保持次數。
+    uint8_t NextVal;            ///< 預先取出的下一個輸出值。
+    uint8_t NextHold;           ///< 預先取出的下一個保持次數。
+    Func_t Func_p;              ///< 切換表或單次播放結束時執行函式，可為 NULL。
+    void* FuncPara_p;           ///< 執行函式之傳參。
+} RtPatternStr_t;
+
+/**
+ * @brief 鏈結結構實體與 RealTimePort。
+ *
+ * @ingroup rtpattern_func
+ * @param Str_p      RtPattern 結構指標。
+ * @param Port_p     已以 RealTimePort_net 鏈結的結構指標。
+ * @param Func_p     切換表或單次播放結束時執行函式，於中斷中執行，可為 NULL。
+ * @param FuncPara_p 執行函式之傳參。
+ * @return uint8_t 錯誤代碼：
+ *   - 0：成功無誤。
+ *   - 1：Port_p 的暫存器不是 1 byte。
+ */
+uint8_t RtPattern_net(RtPatternStr_t* Str_p, RealTimePortStr_t* Port_p,
+                      Func_t Func_p, void* FuncPara_p);
+
+/**
+ * @brief 立即開始播放一張表。
+ *
+ * @ingroup rtpattern_func
+ * @param Str_p  RtPattern 結構指標。
+ * @param Data_p 輸出值表。
+ * @param Hold_p 各步保持次數表，NULL 表示每步 1 次，0 與 1 相同。
+ * @param Num    步數。
+ * @param Flags  RTPATTERN_F_LOOP、RTPATTERN_F_PGM 的組合。
+ * @return uint8_t 錯誤代碼：
+ *   - 0：成功無誤。
+ *   - 1：參數 Num 為0。
+ *
+ * 取消排入的下一張表，第一個值在下一次中斷輸出。
+ */
+uint8_t RtPattern_start(RtPatternStr_t* Str_p, const uint8_t* Data_p,
+                        const uint8_t* Hold_p, uint16_t Num, uint8_t Flags);
+
+/**
+ * @brief 排入下一張表，目前這張表播放完一輪時無縫切換。
+ *
+ * @ingroup rtpattern_func
+ * @return uint8_t 錯誤代碼：
+ *   - 0：成功無誤。
+ *   - 1：參數 Num 為0。
+ *   - 2：上一次排入的表尚未切換。
+ *
+ * 參數同 RtPattern_start。已停止時直接開始播放。切換後原本的表不再被
+ * 讀取，可在執行函式中得知。單次播放已進入最後一步時立即切換，執行
+ * 函式在本函式中關閉中斷執行。
+ */
+uint8_t RtPattern_queue(RtPatternStr_t* Str_p, const uint8_t* Data_p,
+                        const uint8_t* Hold_p, uint16_t Num, uint8_t Flags);
+
+/**
+ * @brief 停止播放，輸出維持最後的值。
+ * @ingroup rtpattern_func
+ */
+void RtPattern_stop(RtPatternStr_t* Str_p);
+
+/**
+ * @brief 查詢是否播放中。
+ *
+ * @ingroup rtpattern_func
+ * @return uint8_t 1 表示播放中，包含單次播放最後一步的保持期間。
+ */
+uint8_t RtPattern_isRunning(RtPatternStr_t* Str_p);
+
+/**
+ * @brief 輸出一步，可登錄在中斷服務常式中執行。
+ *
+ * @ingroup rtpattern_func
+ * @param void_p RtPattern 結構指標。
+ *
+ * 保持期間只將保持次數減1；否則寫入預先取出的值、同 RealTimePortOut_step
+ * 更新 Buff[0] 與 TrigCount，再取出下一步。
+ */
+void RtPattern_step(void* void_p);
+
+#endif  // RT_PATTERN_H
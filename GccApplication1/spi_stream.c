@@ -0,0 +1,74 @@
+/**
+ * @file spi_stream.c
+ * @brief SPI 乒乓雙緩衝串流接收實作。
+ */
+
+#include "spi_stream.h"
+
+uint8_t SpiStream_net(SpiStreamStr_t* Str_p, uint8_t* Buf0_p, uint8_t* Buf1_p,
+                      uint8_t Size) {
+    if (Size == 0) {
+        return 1;
+    }
+    Str_p->Buf_p[0] = Buf0_p;
+    Str_p->Buf_p[1] = Buf1_p;
+    Str_p->Size     = Size;
+    Str_p->Active   = 0;
+    Str_p->Index    = 0;
+    Str_p->Full     = 0;
+    Str_p->Overrun  = 0;
+    Str_p->Run      = 0;
+    return 0;
+}
+
+void SpiStream_start(SpiStreamStr_t* Str_p) {
+    Str_p->Run = 1;
+    SPDR       = Str_p->Dummy;
+}
+
+void SpiStream_stop(SpiStreamStr_t* Str_p) {
+    Str_p->Run = 0;
+}
+
+uint8_t SpiStream_getFull(SpiStreamStr_t* Str_p) {
+    uint8_t full = Str_p->Full;
+
+    if (full == 0) {
+        return SPISTREAM_NONE;
+    }
+    /* 另一個已滿時 SpiStream_step 記為 Overrun 而不切換，不會兩個都滿 */
+    return (full & 0x01) ? 0 : 1;
+}
+
+void SpiStream_release(SpiStreamStr_t* Str_p, uint8_t Num) {
+    uint8_t sreg = SREG;
+    cli();
+    Str_p->Full &= ~(1 << Num);
+    SREG = sreg;
+}
+
+void SpiStream_step(SpiStreamStr_t* Str_p) {
+    uint8_t active = Str_p->Active;
+    uint8_t index  = Str_p->Index;
+
+    Str_p->Buf_p[active][index] = SPDR;
+    if (Str_p->Run) {
+        SPDR = Str_p->Dummy;
+    }
+
+    if (++index < Str_p->Size) {
+        Str_p->Index = index;
+        return;
+    }
+
+    Str_p->Index = 0;
+    if (Str_p->Full & (1 << (active ^ 1))) {
+        Str_p->Overrun++;
+        return;
+    }
+    Str_p->Full |= 1 << active;
+    Str_p->Active = active ^ 1;
+    if (Str_p->Func_p != NULL) {
+        Str_p->Func_p(Str_p->FuncPara_p);
+    }
+}
@@ -0,0 +1,93 @@
+/**
+ * @file spi_stream.h
+ * @brief SPI 乒乓(ping-pong)雙緩衝串流接收。
+ *
+ * SpiInt_step 只負責把 SPIF 中斷分派給註冊的函式，沒有資料搬移功能。
+ * SpiStream 在每次 SPIF 中斷時將 SPDR 存入目前的緩衝區並立即送出下一筆，
+ * 緩衝區填滿時切換到另一個緩衝區，讓主程式處理已滿的一半。
+ */
+
+#ifndef SPI_STREAM_H
+#define SPI_STREAM_H
+
+#include "c4mlib.h"
+
+#define SPISTREAM_NONE 0xFF  ///< 沒有已滿的緩衝區 @ingroup spistream_macro
+
+/**
+ * @brief SpiStream 結構原型
+ * @ingroup spistream_struct
+ *
+ * Full 的 bit0、bit1 分別代表緩衝區 0、1 已滿，由中斷設定、
+ * 主程式處理完後以 SpiStream_release 清除。
+ */
+typedef struct {
+    uint8_t* Buf_p[2];          ///< 兩個緩衝區指標。
+    uint8_t Size;               ///< 每個緩衝區大小。
+    uint8_t Dummy;              ///< 接收時送出的位元組。
+    volatile uint8_t Active;    ///< 目前填入的緩衝區編號。
+    volatile uint8_t Index;     ///< 目前緩衝區已填入數量。
+    volatile uint8_t Full;      ///< 已滿緩衝區旗標。
+    volatile uint8_t Overrun;   ///< 兩個緩衝區皆滿而捨棄的次數。
+    volatile uint8_t Run;       ///< 是否持續串流。
+    Func_t Func_p;              ///< 緩衝區填滿時執行函式，可為 NULL。
+    void* FuncPara_p;           ///< 緩衝區填滿時執行函式之傳參。
+} SpiStreamStr_t;
+
+/**
+ * @brief 鏈結結構實體與兩個緩衝區。
+ *
+ * @ingroup spistream_func
+ * @param Str_p  SpiStream 結構指標。
+ * @param Buf0_p 緩衝區 0 指標。
+ * @param Buf1_p 緩衝區 1 指標。
+ * @param Size   每個緩衝區大小(1~255)。
+ * @return uint8_t 錯誤代碼：
+ *   - 0：成功無誤。
+ *   - 1：參數 Size 錯誤。
+ *
+ * 完成後以 SpiInt_reg 將 SpiStream_step 註冊至 SPI 中斷；若要去除分派
+ * 迴圈的負擔，也可以在 ISR(SPI_STC_vect) 中直接呼叫 SpiStream_step。
+ */
+uint8_t SpiStream_net(SpiStreamStr_t* Str_p, uint8_t* Buf0_p, uint8_t* Buf1_p,
+                      uint8_t Size);
+
+/**
+ * @brief 開始串流，送出第一筆 Dummy 觸發 SPI 傳輸。
+ * @ingroup spistream_func
+ */
+void SpiStream_start(SpiStreamStr_t* Str_p);
+
+/**
+ * @brief 停止串流，目前這一筆交換完成後不再送出下一筆。
+ * @ingroup spistream_func
+ */
+void SpiStream_stop(SpiStreamStr_t* Str_p);
+
+/**
+ * @brief 取得已滿的緩衝區編號。
+ *
+ * @ingroup spistream_func
+ * @return uint8_t 已滿緩衝區編號 0 或 1，沒有時為 SPISTREAM_NONE。
+ */
+uint8_t SpiStream_getFull(SpiStreamStr_t* Str_p);
+
+/**
+ * @brief 釋放處理完畢的緩衝區，讓中斷可以再次填入。
+ * @ingroup spistream_func
+ */
+void SpiStream_release(SpiStreamStr_t* Str_p, uint8_t Num);
+
+/**
+ * @brief 執行一次資料交換，可登錄在 SPI 中斷中執行。
+ *
+ * @ingroup spistream_func
+ * @param Str_p 要執行的結構指標。
+ *
+ * 讀取 SPDR 存入目前緩衝區並立即寫入下一筆 Dummy。緩衝區填滿時設定
+ * Full 旗標、切換至另一個緩衝區並呼叫 Func_p；若另一個緩衝區尚未被
+ * 釋放，則重新填寫目前緩衝區並將 Overrun 加1。
+ */
+void SpiStream_step(SpiStreamStr_t* Str_p);
+
+#endif  // SPI_STREAM_H
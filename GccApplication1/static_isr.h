@@ -0,0 +1,233 @@
+/**
+ * @file static_isr.h
+ * @brief 編譯時期展開的靜態中斷分派。
+ *
+ * 各 *IntStr_t 皆帶有 volatile FuncBlockStr_t IntFb[20] 分派表，*_step
+ * 在中斷中以迴圈逐項檢查 enable 並間接呼叫。對於執行函式在編譯時期即已
+ * 確定的中斷，可在 interrupt.cfg 中以 <向量名稱>_STATIC_FB 列表宣告，
+ * 本檔會為該向量產生逐項直接呼叫的 ISR，沒有迴圈、enable 檢查與分派表。
+ *
+ * 使用方式：在可以看到列表中執行函式與傳參宣告的「一個」 .c 檔中，
+ *
+ *   #define C4M_STATIC_ISR_IMPL
+ *   #include "static_isr.h"
+ *
+ * 使用靜態列表的向量不需要再建立對應的 *IntStr_t 實體(每個省下
+ * IntFb 分派表 5 x MAX_*_FUNCNUM bytes)，也不可再對其使用 *_reg。
+ * 其餘向量維持原本的動態註冊。
+ */
+
+#ifndef STATIC_ISR_H
+#define STATIC_ISR_H
+
+#include "c4mlib.h"
+
+/**
+ * @def STATIC_FB_CALL(FUNC, PARA)
+ * @ingroup interrupt_macro
+ * @brief 將靜態分派列表中的一項展開為直接呼叫。
+ */
+#define STATIC_FB_CALL(FUNC, PARA) FUNC(PARA);
+
+#ifdef C4M_STATIC_ISR_IMPL
+#    ifdef INT0_STATIC_FB
+ISR(INT0_vect) {
+    INT0_STATIC_FB(STATIC_FB_CALL)
+}
+#    endif
+
+#    ifdef INT1_STATIC_FB
+ISR(INT1_vect) {
+    INT1_STATIC_FB(STATIC_FB_CALL)
+}
+#    endif
+
+#    ifdef INT2_STATIC_FB
+ISR(INT2_vect) {
+    INT2_STATIC_FB(STATIC_FB_CALL)
+}
+#    endif
+
+#    ifdef INT3_STATIC_FB
+ISR(INT3_vect) {
+    INT3_STATIC_FB(STATIC_FB_CALL)
+}
+#    endif
+
+#    ifdef INT4_STATIC_FB
+ISR(INT4_vect) {
+    INT4_STATIC_FB(STATIC_FB_CALL)
+}
+#    endif
+
+#    ifdef INT5_STATIC_FB
+ISR(INT5_vect) {
+    INT5_STATIC_FB(STATIC_FB_CALL)
+}
+#    endif
+
+#    ifdef INT6_STATIC_FB
+ISR(INT6_vect) {
+    INT6_STATIC_FB(STATIC_FB_CALL)
+}
+#    endif
+
+#    ifdef INT7_STATIC_FB
+ISR(INT7_vect) {
+    INT7_STATIC_FB(STATIC_FB_CALL)
+}
+#    endif
+
+#    ifdef TIMER0_COMP_STATIC_FB
+ISR(TIMER0_COMP_vect) {
+    TIMER0_COMP_STATIC_FB(STATIC_FB_CALL)
+}
+#    endif
+
+#    ifdef TIMER0_OVF_STATIC_FB
+ISR(TIMER0_OVF_vect) {
+    TIMER0_OVF_STATIC_FB(STATIC_FB_CALL)
+}
+#    endif
+
+#    ifdef TIMER1_CAPT_STATIC_FB
+ISR(TIMER1_CAPT_vect) {
+    TIMER1_CAPT_STATIC_FB(STATIC_FB_CALL)
+}
+#    endif
+
+#    ifdef TIMER1_COMPA_STATIC_FB
+ISR(TIMER1_COMPA_vect) {
+    TIMER1_COMPA_STATIC_FB(STATIC_FB_CALL)
+}
+#    endif
+
+#    ifdef TIMER1_COMPB_STATIC_FB
+ISR(TIMER1_COMPB_vect) {
+    TIMER1_COMPB_STATIC_FB(STATIC_FB_CALL)
+}
+#    endif
+
+#    ifdef TIMER1_COMPC_STATIC_FB
+ISR(TIMER1_COMPC_vect) {
+    TIMER1_COMPC_STATIC_FB(STATIC_FB_CALL)
+}
+#    endif
+
+#    ifdef TIMER1_OVF_STATIC_FB
+ISR(TIMER1_OVF_vect) {
+    TIMER1_OVF_STATIC_FB(STATIC_FB_CALL)
+}
+#    endif
+
+#    ifdef TIMER2_COMP_STATIC_FB
+ISR(TIMER2_COMP_vect) {
+    TIMER2_COMP_STATIC_FB(STATIC_FB_CALL)
+}
+#    endif
+
+#    ifdef TIMER2_OVF_STATIC_FB
+ISR(TIMER2_OVF_vect) {
+    TIMER2_OVF_STATIC_FB(STATIC_FB_CALL)
+}
+#    endif
+
+#    ifdef TIMER3_CAPT_STATIC_FB
+ISR(TIMER3_CAPT_vect) {
+    TIMER3_CAPT_STATIC_FB(STATIC_FB_CALL)
+}
+#    endif
+
+#    ifdef TIMER3_COMPA_STATIC_FB
+ISR(TIMER3_COMPA_vect) {
+    TIMER3_COMPA_STATIC_FB(STATIC_FB_CALL)
+}
+#    endif
+
+#    ifdef TIMER3_COMPB_STATIC_FB
+ISR(TIMER3_COMPB_vect) {
+    TIMER3_COMPB_STATIC_FB(STATIC_FB_CALL)
+}
+#    endif
+
+#    ifdef TIMER3_COMPC_STATIC_FB
+ISR(TIMER3_COMPC_vect) {
+    TIMER3_COMPC_STATIC_FB(STATIC_FB_CALL)
+}
+#    endif
+
+#    ifdef TIMER3_OVF_STATIC_FB
+ISR(TIMER3_OVF_vect) {
+    TIMER3_OVF_STATIC_FB(STATIC_FB_CALL)
+}
+#    endif
+
+#    ifdef SPI_STC_STATIC_FB
+ISR(SPI_STC_vect) {
+    SPI_STC_STATIC_FB(STATIC_FB_CALL)
+}
+#    endif
+
+#    ifdef USART0_RX_STATIC_FB
+ISR(USART0_RX_vect) {
+    USART0_RX_STATIC_FB(STATIC_FB_CALL)
+}
+#    endif
+
+#    ifdef USART0_UDRE_STATIC_FB
+ISR(USART0_UDRE_vect) {
+    USART0_UDRE_STATIC_FB(STATIC_FB_CALL)
+}
+#    endif
+
+#    ifdef USART0_TX_STATIC_FB
+ISR(USART0_TX_vect) {
+    USART0_TX_STATIC_FB(STATIC_FB_CALL)
+}
+#    endif
+
+#    ifdef USART1_RX_STATIC_FB
+ISR(USART1_RX_vect) {
+    USART1_RX_STATIC_FB(STATIC_FB_CALL)
+}
+#    endif
+
+#    ifdef USART1_UDRE_STATIC_FB
+ISR(USART1_UDRE_vect) {
+    USART1_UDRE_STATIC_FB(STATIC_FB_CALL)
+}
+#    endif
+
+#    ifdef USART1_TX_STATIC_FB
+ISR(USART1_TX_vect) {
+    USART1_TX_STATIC_FB(STATIC_FB_CALL)
+}
+#    endif
+
+#    ifdef TWI_STATIC_FB
+ISR(TWI_vect) {
+    TWI_STATIC_FB(STATIC_FB_CALL)
+}
+#    endif
+
+#    ifdef ADC_STATIC_FB
+ISR(ADC_vect) {
+    ADC_STATIC_FB(STATIC_FB_CALL)
+}
+#    endif
+
+#    ifdef EE_READY_STATIC_FB
+ISR(EE_READY_vect) {
+    EE_READY_STATIC_FB(STATIC_FB_CALL)
+}
+#    endif
+
+#    ifdef ANALOG_COMP_STATIC_FB
+ISR(ANALOG_COMP_vect) {
+    ANALOG_COMP_STATIC_FB(STATIC_FB_CALL)
+}
+#    endif
+
+#endif  // C4M_STATIC_ISR_IMPL
+
+#endif  // STATIC_ISR_H
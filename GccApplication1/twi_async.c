@@ -0,0 +1,290 @@
+/**
+ * @file twi_async.c
+ * @brief TwiAsync 中斷驅動 TWI Master 傳輸引擎實作。
+ */
+
+#include "twi_async.h"
+
+#define JOB_MASK (TWIASYNC_MAX_JOB - 1)
+
+#if (TWIASYNC_MAX_JOB & JOB_MASK) != 0
+#    error "TWIASYNC_MAX_JOB must be a power of two"
+#endif
+
+#define TWCR_GO    ((1 << TWINT) | (1 << TWEN) | (1 << TWIE))
+#define TWCR_ACK   (TWCR_GO | (1 << TWEA))
+#define TWCR_START (TWCR_GO | (1 << TWSTA))
+#define TWCR_STOP  (TWCR_GO | (1 << TWSTO))
+
+/* TWSR 狀態碼(已遮除預除位元) */
+#define TW_START         0x08
+#define TW_REP_START     0x10
+#define TW_MT_SLA_ACK    0x18
+#define TW_MT_SLA_NACK   0x20
+#define TW_MT_DATA_ACK   0x28
+#define TW_MT_DATA_NACK  0x30
+#define TW_ARB_LOST      0x38
+#define TW_MR_SLA_ACK    0x40
+#define TW_MR_SLA_NACK   0x48
+#define TW_MR_DATA_ACK   0x50
+#define TW_MR_DATA_NACK  0x58
+
+#define PHASE_WRITE 0  ///< 以寫入定址，或正在送出資料
+#define PHASE_REG   1  ///< 已送出 RegAdd
+#define PHASE_READ  2  ///< 以讀取定址，或正在接收資料
+
+/* Mode 1、3、5 由高至低，Mode 2、4、6 由低至高 */
+#define DATA_IDX(JOB_P, I) (((JOB_P)->Mode & 1) ? (JOB_P)->Bytes - 1 - (I) : (I))
+#define HAS_REGADD(JOB_P) ((JOB_P)->Mode >= 5)
+
+/* 設定佇列最前端工作的傳輸狀態，START 由呼叫者送出 */
+static void TwiAsync_load(TwiAsyncStr_t* Str_p) {
+    TwiAsyncJob_t* job_p = &Str_p->Job[Str_p->JobTail & JOB_MASK];
+
+    Str_p->Index    = 0;
+    Str_p->Phase    = (job_p->Type == TWIASYNC_TYPE_REC && !HAS_REGADD(job_p))
+                          ? PHASE_READ
+                          : PHASE_WRITE;
+    Str_p->TimeLeft = Str_p->Timeout;
+    Str_p->Busy     = 1;
+}
+
+/* 結束佇列最前端的工作，送出 STOP 並接續下一筆工作 */
+static void TwiAsync_finish(TwiAsyncStr_t* Str_p, uint8_t Result) {
+    TwiAsyncJob_t* job_p = &Str_p->Job[Str_p->JobTail & JOB_MASK];
+    Func_t func_p        = job_p->Func_p;
+    void* para_p         = job_p->FuncPara_p;
+    /* 仲裁失敗時已不是 Master，不可送出 STOP；匯流排錯誤仍以 STOP 釋放 */
+    uint8_t twcr = (Result == TWIASYNC_RES_BUS && (TWSR & 0xF8) == TW_ARB_LOST)
+                       ? TWCR_GO
+                       : TWCR_STOP;
+
+    job_p->Result = Result;
+    Str_p->JobTail++;
+    if (Str_p->JobTail != Str_p->JobHead) {
+        TwiAsync_load(Str_p);
+        /* 成功時不釋放匯流排，直接以 repeated START 接續下一筆工作 */
+        twcr = (Result == TWIASYNC_RES_OK) ? TWCR_START : twcr | (1 << TWSTA);
+    }
+    else {
+        Str_p->Busy = 0;
+        Str_p->BitCount++;
+    }
+    TWCR = twcr;
+    if (func_p != NULL) {
+        func_p(para_p);
+    }
+}
+
+static void TwiAsync_txNext(TwiAsyncStr_t* Str_p, TwiAsyncJob_t* job_p) {
+    uint8_t data;
+
+    if (Str_p->Index >= job_p->Bytes) {
+        TwiAsync_finish(Str_p, TWIASYNC_RES_OK);
+        return;
+    }
+    data = job_p->Data_p[DATA_IDX(job_p, Str_p->Index)];
+    if (Str_p->Index == 0 && job_p->Mode <= 2) {
+        data |= job_p->RegAdd;
+    }
+    Str_p->Index++;
+    Str_p->Phase = PHASE_WRITE;
+    TWDR         = data;
+    TWCR         = TWCR_GO;
+}
+
+static uint8_t TwiAsync_submit(TwiAsyncStr_t* Str_p, uint8_t Type,
+                               uint8_t mode, uint8_t SLA, uint8_t RegAdd,
+                               uint8_t Bytes, void* Data_p, Func_t Func_p,
+                               void* FuncPara_p, uint8_t* Handle_p) {
+    uint8_t head = Str_p->JobHead;
+    uint8_t sreg;
+    TwiAsyncJob_t* job_p;
+
+    if (mode < 1 || mode > 6) {
+        return 1;
+    }
+    if ((uint8_t)(head - Str_p->JobTail) >= TWIASYNC_MAX_JOB) {
+        return 2;
+    }
+    if (Bytes == 0 && (Type == TWIASYNC_TYPE_REC || mode <= 2)) {
+        return 3;
+    }
+
+    job_p             = &Str_p->Job[head & JOB_MASK];
+    job_p->Type       = Type;
+    job_p->Mode       = mode;
+    job_p->SLA        = SLA;
+    job_p->RegAdd     = RegAdd;
+    job_p->Bytes      = Bytes;
+    job_p->Data_p     = (uint8_t*)Data_p;
+    job_p->Result     = TWIASYNC_RES_PENDING;
+    job_p->Func_p     = Func_p;
+    job_p->FuncPara_p = FuncPara_p;
+
+    sreg = SREG;
+    cli();
+    Str_p->JobHead = head + 1;
+    if (!Str_p->Busy) {
+        TwiAsync_load(Str_p);
+        /* 等待前一筆工作的 STOP 送出完畢 */
+        while (TWCR & (1 << TWSTO))
+            ;
+        TWCR = TWCR_START;
+    }
+    SREG = sreg;
+
+    *Handle_p = head;
+    return 0;
+}
+
+uint8_t TwiAsync_net(TwiAsyncStr_t* Str_p, TwiIntStr_t* TwiIntStr_p,
+                     uint16_t Timeout) {
+    Str_p->Timeout  = Timeout;
+    Str_p->TimeLeft = 0;
+    Str_p->Busy     = 0;
+    Str_p->JobHead  = 0;
+    Str_p->JobTail  = 0;
+    Str_p->BitCount = 0;
+
+    Str_p->Fb_Id = TwiInt_reg(TwiIntStr_p, TwiAsync_step, Str_p);
+    TwiInt_en(TwiIntStr_p, Str_p->Fb_Id, ENABLE);
+    return 0;
+}
+
+uint8_t TwiAsync_trm(TwiAsyncStr_t* Str_p, uint8_t mode, uint8_t SLA,
+                     uint8_t RegAdd, uint8_t Bytes, void* Data_p,
+                     Func_t Func_p, void* FuncPara_p, uint8_t* Handle_p) {
+    return TwiAsync_submit(Str_p, TWIASYNC_TYPE_TRM, mode, SLA, RegAdd, Bytes,
+                           Data_p, Func_p, FuncPara_p, Handle_p);
+}
+
+uint8_t TwiAsync_rec(TwiAsyncStr_t* Str_p, uint8_t mode, uint8_t SLA,
+                     uint8_t RegAdd, uint8_t Bytes, void* Data_p,
+                     Func_t Func_p, void* FuncPara_p, uint8_t* Handle_p) {
+    return TwiAsync_submit(Str_p, TWIASYNC_TYPE_REC, mode, SLA, RegAdd, Bytes,
+                           Data_p, Func_p, FuncPara_p, Handle_p);
+}
+
+uint8_t TwiAsync_isDone(TwiAsyncStr_t* Str_p, uint8_t Handle) {
+    uint8_t tail = Str_p->JobTail;
+    return (uint8_t)(Handle - tail) >= (uint8_t)(Str_p->JobHead - tail);
+}
+
+uint8_t TwiAsync_getResult(TwiAsyncStr_t* Str_p, uint8_t Handle) {
+    if (!TwiAsync_isDone(Str_p, Handle)) {
+        return TWIASYNC_RES_PENDING;
+    }
+    return Str_p->Job[Handle & JOB_MASK].Result;
+}
+
+uint16_t TwiAsync_busLoad(TwiAsyncStr_t* Str_p, uint16_t WindowMs) {
+    uint32_t bits;
+    uint32_t scl_clk;
+    uint32_t window;
+    uint8_t sreg;
+
+    sreg = SREG;
+    cli();
+    bits            = Str_p->BitCount;
+    Str_p->BitCount = 0;
+    SREG            = sreg;
+
+    /* f_SCL = F_CPU / (16 + 2 * TWBR * 4^TWPS) */
+    scl_clk = 16 + ((uint32_t)TWBR << (1 + 2 * (TWSR & 0x03)));
+    window  = (uint32_t)WindowMs * (F_CPU / 1000UL) / 1000;
+    if (window == 0) {
+        return 0;
+    }
+    bits = bits * scl_clk / window;
+    return (bits > 1000) ? 1000 : (uint16_t)bits;
+}
+
+void TwiAsync_tick(void* void_p) {
+    TwiAsyncStr_t* Str_p = (TwiAsyncStr_t*)void_p;
+
+    if (!Str_p->Busy || Str_p->TimeLeft == 0) {
+        return;
+    }
+    if (--Str_p->TimeLeft == 0) {
+        /* 關閉 TWI 以重置硬體狀態機並釋放 SCL、SDA */
+        TWCR = 0;
+        TwiAsync_finish(Str_p, TWIASYNC_RES_TIMEOUT);
+    }
+}
+
+void TwiAsync_step(void* void_p) {
+    TwiAsyncStr_t* Str_p = (TwiAsyncStr_t*)void_p;
+    TwiAsyncJob_t* job_p;
+    uint8_t status = TWSR & 0xF8;
+
+    if (!Str_p->Busy) {
+        return;
+    }
+    job_p = &Str_p->Job[Str_p->JobTail & JOB_MASK];
+    /* START 約佔1個 SCL 週期，位址或資料位元組含 ACK 佔9個 */
+    Str_p->BitCount += (status == TW_START || status == TW_REP_START) ? 1 : 9;
+
+    switch (status) {
+        case TW_START:
+        case TW_REP_START:
+            TWDR = (job_p->SLA << 1) | (Str_p->Phase == PHASE_READ);
+            TWCR = TWCR_GO;
+            break;
+        case TW_MT_SLA_ACK:
+            if (HAS_REGADD(job_p)) {
+                Str_p->Phase = PHASE_REG;
+                TWDR         = job_p->RegAdd;
+                TWCR         = TWCR_GO;
+            }
+            else {
+                TwiAsync_txNext(Str_p, job_p);
+            }
+            break;
+        case TW_MT_DATA_ACK:
+            if (Str_p->Phase == PHASE_REG &&
+                job_p->Type == TWIASYNC_TYPE_REC) {
+                Str_p->Phase = PHASE_READ;
+                TWCR         = TWCR_START;
+            }
+            else {
+                TwiAsync_txNext(Str_p, job_p);
+            }
+            break;
+        case TW_MT_DATA_NACK:
+            /* 最後一個位元組允許 Slave 回 NACK */
+            if (Str_p->Phase == PHASE_WRITE && Str_p->Index == job_p->Bytes) {
+                TwiAsync_finish(Str_p, TWIASYNC_RES_OK);
+            }
+            else {
+                TwiAsync_finish(Str_p, TWIASYNC_RES_NACK);
+            }
+            break;
+        case TW_MT_SLA_NACK:
+        case TW_MR_SLA_NACK:
+            TwiAsync_finish(Str_p, TWIASYNC_RES_SLA);
+            break;
+        case TW_MR_SLA_ACK:
+            TWCR = (job_p->Bytes > 1) ? TWCR_ACK : TWCR_GO;
+            break;
+        case TW_MR_DATA_ACK:
+        case TW_MR_DATA_NACK:
+            job_p->Data_p[DATA_IDX(job_p, Str_p->Index)] = TWDR;
+            Str_p->Index++;
+            if (status == TW_MR_DATA_NACK) {
+                TwiAsync_finish(Str_p, TWIASYNC_RES_OK);
+            }
+            else {
+                /* 最後一個位元組回 NACK 通知 Slave 結束傳送 */
+                TWCR = (job_p->Bytes - Str_p->Index > 1) ? TWCR_ACK : TWCR_GO;
+            }
+            break;
+        case TW_ARB_LOST:
+            TwiAsync_finish(Str_p, TWIASYNC_RES_BUS);
+            break;
+        default:
+            /* 匯流排錯誤，TwiAsync_finish 以 STOP 釋放 SCL、SDA */
+            TwiAsync_finish(Str_p, TWIASYNC_RES_BUS);
+            break;
+    }
+}
@@ -0,0 +1,168 @@
+/**
+ * @file twi_async.h
+ * @brief 中斷驅動的非阻塞 TWI Master 傳輸引擎。
+ *
+ * TWIM_trm / TWIM_rec 以輪詢 TWINT 的方式逐位元組送收，並在位元組間以
+ * WaitTick 延遲，傳輸期間主程式完全被佔用。TwiAsync 將傳輸工作排入佇列後
+ * 立即返回傳輸編號，由 TwiIntStr_t 註冊的 TwiAsync_step 在每次 TWI 中斷
+ * 依 TWSR 狀態推進，完成或發生錯誤時呼叫使用者註冊的完成函式。
+ * 指定 RegAdd 的接收(Mode 5、6)在送出 RegAdd 後以 repeated START 轉為讀取。
+ * 工作成功結束且佇列中還有下一筆工作時，不送出 STOP，直接以 repeated START
+ * 接續，讓多筆工作背靠背佔用匯流排而不需主程式介入。
+ */
+
+#ifndef TWI_ASYNC_H
+#define TWI_ASYNC_H
+
+#include "c4mlib.h"
+
+#define TWIASYNC_TYPE_TRM 0  ///< 傳送工作 @ingroup twiasync_macro
+#define TWIASYNC_TYPE_REC 1  ///< 接收工作 @ingroup twiasync_macro
+
+#define TWIASYNC_RES_OK       0     ///< 傳輸成功 @ingroup twiasync_macro
+#define TWIASYNC_RES_TIMEOUT  1     ///< 傳輸逾時 @ingroup twiasync_macro
+#define TWIASYNC_RES_NACK     2     ///< 資料未被 ACK @ingroup twiasync_macro
+#define TWIASYNC_RES_BUS      3     ///< 仲裁失敗或匯流排錯誤 @ingroup twiasync_macro
+#define TWIASYNC_RES_SLA      4     ///< SLA 未被 ACK @ingroup twiasync_macro
+#define TWIASYNC_RES_PENDING  0xFF  ///< 傳輸尚未完成 @ingroup twiasync_macro
+
+/**
+ * @brief TwiAsync 傳輸工作結構
+ * @ingroup twiasync_struct
+ */
+typedef struct {
+    uint8_t Type;             ///< 工作種類，傳送或接收。
+    uint8_t Mode;             ///< TWI 通訊模式 1~6，同 TWIM_trm / TWIM_rec。
+    uint8_t SLA;              ///< Slave 裝置的7位元 TWI ID。
+    uint8_t RegAdd;           ///< 遠端暫存器位址或控制旗標。
+    uint8_t Bytes;            ///< 資料位元組數。
+    uint8_t* Data_p;          ///< 資料指標。
+    volatile uint8_t Result;  ///< 傳輸結果。
+    Func_t Func_p;            ///< 完成時執行函式。
+    void* FuncPara_p;         ///< 完成時執行函式之傳參。
+} TwiAsyncJob_t;
+
+/**
+ * @brief TwiAsync 管理結構
+ * @ingroup twiasync_struct
+ */
+typedef struct {
+    uint8_t Fb_Id;               ///< TWI 中斷中功能方塊名單編號。
+    uint16_t Timeout;            ///< 每筆工作的逾時計數，0 為不逾時。
+    volatile uint16_t TimeLeft;  ///< 目前工作剩餘的逾時計數。
+    volatile uint8_t Busy;       ///< 目前有工作佔用匯流排。
+    uint8_t Phase;               ///< 目前工作的傳輸階段。
+    uint8_t Index;               ///< 目前工作已送收的資料位元組數。
+
+    volatile uint32_t BitCount;  ///< 已使用的 SCL 週期數，供 TwiAsync_busLoad 計算。
+
+    volatile uint8_t JobHead;    ///< 已排入工作計數，亦為下一個傳輸編號。
+    volatile uint8_t JobTail;    ///< 已完成工作計數。
+    TwiAsyncJob_t Job[TWIASYNC_MAX_JOB];
+} TwiAsyncStr_t;
+
+/**
+ * @brief 初始化 TwiAsync 並註冊至 TWI 中斷。
+ *
+ * @ingroup twiasync_func
+ * @param Str_p       TwiAsync 管理結構指標。
+ * @param TwiIntStr_p 已完成 TwiInt_net 與 TwiInt_set 的 TWI 中斷結構指標。
+ * @param Timeout     每筆工作的逾時計數，以 TwiAsync_tick 的呼叫次數計，
+ *                    0 為不逾時。
+ * @return uint8_t 錯誤代碼：
+ *   - 0：成功無誤。
+ *
+ * 會以 TwiInt_reg 註冊 TwiAsync_step 並啟用。需要逾時偵測時，另將
+ * TwiAsync_tick 註冊到計時中斷或 IntFreqDiv 中。
+ */
+uint8_t TwiAsync_net(TwiAsyncStr_t* Str_p, TwiIntStr_t* TwiIntStr_p,
+                     uint16_t Timeout);
+
+/**
+ * @brief 非阻塞 TWI Master 多位元組傳送。
+ *
+ * @ingroup twiasync_func
+ * @param Str_p      TwiAsync 管理結構指標。
+ * @param mode       TWI通訊模式，目前支援：1、2、3、4、5、6。
+ * @param SLA        Slave(僕)裝置的TWI ID。
+ * @param RegAdd     遠端讀寫暫存器(Register)的位址或控制旗標(control flag)。
+ * @param Bytes      待送資料位元組數。
+ * @param Data_p     待送資料指標，完成前不可修改或釋放。
+ * @param Func_p     完成時執行函式，於中斷中執行，可為 NULL。
+ * @param FuncPara_p 完成時執行函式之傳參。
+ * @param Handle_p   回傳傳輸編號。
+ * @return uint8_t 錯誤代碼：
+ *   - 0：成功無誤。
+ *   - 1：參數 mode 錯誤。
+ *   - 2：工作佇列已滿。
+ *   - 3：參數 Bytes 錯誤。
+ *
+ * 各模式的位元組順序與 TWIM_trm 相同。Mode 1、2 的 Bytes 需大於0；
+ * Mode 3、4 的 Bytes 可為0，只送出 SLA 以確認裝置存在。
+ */
+uint8_t TwiAsync_trm(TwiAsyncStr_t* Str_p, uint8_t mode, uint8_t SLA,
+                     uint8_t RegAdd, uint8_t Bytes, void* Data_p,
+                     Func_t Func_p, void* FuncPara_p, uint8_t* Handle_p);
+
+/**
+ * @brief 非阻塞 TWI Master 多位元組接收。
+ *
+ * @ingroup twiasync_func
+ * @param Data_p 待收資料指標，完成前不可釋放。
+ *
+ * 其餘參數與回傳值同 TwiAsync_trm，Bytes 需大於0。各模式的位元組順序與
+ * TWIM_rec 相同；Mode 1、2 的控制旗標包含在收到的第一個位元組中，
+ * RegAdd 不會送出。Mode 5、6 先以寫入送出 RegAdd，再以 repeated START
+ * 轉為讀取，中間不釋放匯流排。
+ */
+uint8_t TwiAsync_rec(TwiAsyncStr_t* Str_p, uint8_t mode, uint8_t SLA,
+                     uint8_t RegAdd, uint8_t Bytes, void* Data_p,
+                     Func_t Func_p, void* FuncPara_p, uint8_t* Handle_p);
+
+/**
+ * @brief 查詢傳輸是否完成。
+ *
+ * @ingroup twiasync_func
+ * @return uint8_t 1：已完成，0：尚在佇列中。
+ */
+uint8_t TwiAsync_isDone(TwiAsyncStr_t* Str_p, uint8_t Handle);
+
+/**
+ * @brief 取得傳輸結果。
+ *
+ * @ingroup twiasync_func
+ * @return uint8_t TWIASYNC_RES_* 結果代碼，尚未完成時為
+ * TWIASYNC_RES_PENDING。結果保留至該編號的工作欄位被重新使用為止。
+ */
+uint8_t TwiAsync_getResult(TwiAsyncStr_t* Str_p, uint8_t Handle);
+
+/**
+ * @brief 計算匯流排使用率，並清除累計的 SCL 週期數。
+ *
+ * @ingroup twiasync_func
+ * @param Str_p    TwiAsync 管理結構指標。
+ * @param WindowMs 距離上次呼叫經過的時間，單位為 ms。
+ * @return uint16_t 匯流排使用率，單位為千分之一(0~1000)。
+ *
+ * 以每個 START 1個、每個位址或資料位元組9個 SCL 週期累計，並依目前
+ * TWBR、TWSR 預除設定換算為時間，適合在固定週期的 IntFreqDiv 工作中呼叫。
+ */
+uint16_t TwiAsync_busLoad(TwiAsyncStr_t* Str_p, uint16_t WindowMs);
+
+/**
+ * @brief 逾時計數執行片段，可註冊到計時中斷或 IntFreqDiv 中。
+ *
+ * @ingroup twiasync_func
+ *
+ * 目前工作的逾時計數歸零時重置 TWI 硬體、送出 STOP，並以
+ * TWIASYNC_RES_TIMEOUT 結束該工作。
+ */
+void TwiAsync_tick(void* Str_p);
+
+/**
+ * @brief TWI 中斷執行片段，由 TwiAsync_net 註冊。
+ * @ingroup twiasync_func
+ */
+void TwiAsync_step(void* Str_p);
+
+#endif  // TWI_ASYNC_H
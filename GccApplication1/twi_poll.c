@@ -0,0 +1,82 @@
+/**
+ * @file twi_poll.c
+ * @brief 週期性 TWI 輪詢列表實作。
+ */
+
+#include "twi_poll.h"
+
+/* 每筆傳輸完成時由 TwiAsync 呼叫，傳輸依排入順序完成 */
+static void TwiPoll_itemDone(void* void_p) {
+    TwiPollStr_t* Str_p      = (TwiPollStr_t*)void_p;
+    TwiPollItemStr_t* item_p = &Str_p->Item_p[Str_p->Done];
+
+    item_p->Result = TwiAsync_getResult(Str_p->Twi_p, item_p->Handle);
+    if (++Str_p->Done == Str_p->Total) {
+        Str_p->Busy = 0;
+        Str_p->Round++;
+        if (Str_p->Func_p != NULL) {
+            Str_p->Func_p(Str_p->FuncPara_p);
+        }
+    }
+}
+
+uint8_t TwiPoll_net(TwiPollStr_t* Str_p, TwiAsyncStr_t* Twi_p,
+                    TwiPollItemStr_t* Item_p, uint8_t Total, Func_t Func_p,
+                    void* FuncPara_p) {
+    if (Total == 0 || Total > TWIASYNC_MAX_JOB) {
+        return 1;
+    }
+    for (uint8_t i = 0; i < Total; i++) {
+        TwiPollItemStr_t* item_p = &Item_p[i];
+        if (item_p->Type > TWIASYNC_TYPE_REC || item_p->Mode < 1 ||
+            item_p->Mode > 6) {
+            return 2;
+        }
+        if (item_p->Bytes == 0 &&
+            (item_p->Type == TWIASYNC_TYPE_REC || item_p->Mode <= 2)) {
+            return 2;
+        }
+        item_p->Result = TWIASYNC_RES_PENDING;
+    }
+    Str_p->Twi_p      = Twi_p;
+    Str_p->Item_p     = Item_p;
+    Str_p->Total      = Total;
+    Str_p->Done       = 0;
+    Str_p->Busy       = 0;
+    Str_p->Overrun    = 0;
+    Str_p->Round      = 0;
+    Str_p->Func_p     = Func_p;
+    Str_p->FuncPara_p = FuncPara_p;
+    return 0;
+}
+
+void TwiPoll_step(void* void_p) {
+    TwiPollStr_t* Str_p  = (TwiPollStr_t*)void_p;
+    TwiAsyncStr_t* twi_p = Str_p->Twi_p;
+    uint8_t sreg;
+
+    sreg = SREG;
+    cli();
+    if (Str_p->Busy || (uint8_t)(twi_p->JobHead - twi_p->JobTail) >
+                           TWIASYNC_MAX_JOB - Str_p->Total) {
+        Str_p->Overrun++;
+        SREG = sreg;
+        return;
+    }
+    Str_p->Busy = 1;
+    Str_p->Done = 0;
+    for (uint8_t i = 0; i < Str_p->Total; i++) {
+        TwiPollItemStr_t* item_p = &Str_p->Item_p[i];
+        if (item_p->Type == TWIASYNC_TYPE_REC) {
+            TwiAsync_rec(twi_p, item_p->Mode, item_p->SLA, item_p->RegAdd,
+                         item_p->Bytes, item_p->Data_p, TwiPoll_itemDone,
+                         Str_p, &item_p->Handle);
+        }
+        else {
+            TwiAsync_trm(twi_p, item_p->Mode, item_p->SLA, item_p->RegAdd,
+                         item_p->Bytes, item_p->Data_p, TwiPoll_itemDone,
+                         Str_p, &item_p->Handle);
+        }
+    }
+    SREG = sreg;
+}
@@ -0,0 +1,86 @@
+/**
+ * @file twi_poll.h
+ * @brief 週期性 TWI 輪詢列表。
+ *
+ * 多個 I2C 感測器需要固定週期讀取時，將每個裝置的讀寫描述放在一個列表中，
+ * 把 TwiPoll_step 註冊到 IntFreqDiv。每次觸發時整個列表一次排入 TwiAsync
+ * 佇列，由 TWI 中斷以 repeated START 背靠背完成，全部完成後呼叫使用者
+ * 註冊的完成函式，主程式不需介入。
+ *
+ *   TwiPollItemStr_t Sensor_list[] = {
+ *       {.Type = TWIASYNC_TYPE_REC, .Mode = 5, .SLA = 0x68, .RegAdd = 0x3B,
+ *        .Bytes = 6, .Data_p = Acc_buf},
+ *       {.Type = TWIASYNC_TYPE_REC, .Mode = 5, .SLA = 0x1E, .RegAdd = 0x03,
+ *        .Bytes = 6, .Data_p = Mag_buf},
+ *   };
+ *   TwiPoll_net(&Sensor_poll, &TwiAsync_str, Sensor_list, 2, Fuse_step, 0);
+ *   IntFreqDiv_reg(&IFD_str, TwiPoll_step, &Sensor_poll, 10, 0);
+ */
+
+#ifndef TWI_POLL_H
+#define TWI_POLL_H
+
+#include "c4mlib.h"
+#include "twi_async.h"
+
+/**
+ * @brief 輪詢列表中的單筆傳輸描述
+ * @ingroup twipoll_struct
+ */
+typedef struct {
+    uint8_t Type;             ///< TWIASYNC_TYPE_TRM 或 TWIASYNC_TYPE_REC。
+    uint8_t Mode;             ///< TWI 通訊模式 1~6。
+    uint8_t SLA;              ///< Slave 裝置的7位元 TWI ID。
+    uint8_t RegAdd;           ///< 遠端暫存器位址或控制旗標。
+    uint8_t Bytes;            ///< 資料位元組數。
+    void* Data_p;             ///< 資料指標。
+    uint8_t Handle;           ///< 本輪的傳輸編號。
+    volatile uint8_t Result;  ///< 最近一輪的傳輸結果，TWIASYNC_RES_*。
+} TwiPollItemStr_t;
+
+/**
+ * @brief 輪詢列表結構
+ * @ingroup twipoll_struct
+ */
+typedef struct {
+    TwiAsyncStr_t* Twi_p;      ///< 使用的 TwiAsync 引擎。
+    TwiPollItemStr_t* Item_p;  ///< 傳輸描述陣列。
+    uint8_t Total;             ///< 傳輸描述數量。
+    volatile uint8_t Done;     ///< 本輪已完成的傳輸數。
+    volatile uint8_t Busy;     ///< 本輪尚未完成。
+    volatile uint8_t Overrun;  ///< 上一輪未完成或佇列空間不足而略過的次數。
+    volatile uint16_t Round;   ///< 已完成的輪數。
+    Func_t Func_p;             ///< 每輪完成時執行函式，可為 NULL。
+    void* FuncPara_p;          ///< 每輪完成時執行函式之傳參。
+} TwiPollStr_t;
+
+/**
+ * @brief 鏈結輪詢列表。
+ *
+ * @ingroup twipoll_func
+ * @param Str_p      輪詢列表結構指標。
+ * @param Twi_p      已完成 TwiAsync_net 的 TwiAsync 引擎。
+ * @param Item_p     傳輸描述陣列。
+ * @param Total      傳輸描述數量，1~TWIASYNC_MAX_JOB。
+ * @param Func_p     每輪完成時執行函式，於 TWI 中斷中執行，可為 NULL。
+ * @param FuncPara_p 每輪完成時執行函式之傳參。
+ * @return uint8_t 錯誤代碼：
+ *   - 0：成功無誤。
+ *   - 1：參數 Total 錯誤。
+ *   - 2：傳輸描述的 Type、Mode 或 Bytes 錯誤。
+ */
+uint8_t TwiPoll_net(TwiPollStr_t* Str_p, TwiAsyncStr_t* Twi_p,
+                    TwiPollItemStr_t* Item_p, uint8_t Total, Func_t Func_p,
+                    void* FuncPara_p);
+
+/**
+ * @brief 排入一輪輪詢，註冊到 IntFreqDiv 中週期執行。
+ *
+ * @ingroup twipoll_func
+ * @param Str_p 輪詢列表結構指標(TwiPollStr_t*)。
+ *
+ * 上一輪尚未完成或 TwiAsync 佇列空間不足時略過本輪並累計 Overrun。
+ */
+void TwiPoll_step(void* Str_p);
+
+#endif  // TWI_POLL_H
@@ -0,0 +1,443 @@
+/**
+ * @file uart_pipe.c
+ * @brief UartPipe 管線化 UART Mode 0 傳輸實作。
+ */
+
+#include "uart_pipe.h"
+
+#define JOB_MASK (UARTPIPE_MAX_JOB - 1)
+#define SEQ_MASK 0x7F
+
+#define RX_STATE_HEADER 0
+#define RX_STATE_UID    1
+#define RX_STATE_SEQ    2
+#define RX_STATE_STATUS 3  ///< Slave 端為 RegAdd
+#define RX_STATE_BYTES  4
+#define RX_STATE_DATA   5
+#define RX_STATE_CHKSUM 6
+
+static uint8_t UartPipe_udr(volatile uint8_t** Udr_pp, uint8_t Num) {
+    switch (Num) {
+        case 0:
+            *Udr_pp = &UDR0;
+            return 0;
+        case 1:
+            *Udr_pp = &UDR1;
+            return 0;
+        default:
+            return 1;
+    }
+}
+
+/*-- Master ------------------------------------------------------------------*/
+
+/* 視窗未滿時開始送出下一個封包，須在中斷中或關閉中斷時呼叫 */
+static void UartPipe_kick(UartPipeStr_t* Str_p) {
+    UartPipeJob_t* job_p;
+    uint8_t data;
+
+    if (Str_p->TxActive || Str_p->JobSent == Str_p->JobHead ||
+        Str_p->Outstanding >= Str_p->Window) {
+        return;
+    }
+    job_p = &Str_p->Job[Str_p->JobSent & JOB_MASK];
+    /* 不同裝置的回應會在共用的回應線上碰撞，等前一個裝置全部回應 */
+    if (Str_p->Outstanding && job_p->UartID != Str_p->TxUid) {
+        return;
+    }
+    Str_p->TxUid    = job_p->UartID;
+    job_p->Sent     = 1;
+    job_p->TimeLeft = Str_p->Timeout;
+    Str_p->Outstanding++;
+    Str_p->JobSent++;
+
+    Str_p->TxActive = 1;
+    Str_p->TxLeft   = job_p->TxBytes - 1;
+    RingBuf_get(&Str_p->TxBuf, &data);
+    *Str_p->Udr_p = data;
+}
+
+/* 結束一個已送出的工作，並將 JobTail 推進到第一個未完成的工作 */
+static void UartPipe_finish(UartPipeStr_t* Str_p, UartPipeJob_t* job_p,
+                            uint8_t Result) {
+    job_p->Result = Result;
+    job_p->Sent   = 0;
+    Str_p->Outstanding--;
+    while (Str_p->JobTail != Str_p->JobSent &&
+           Str_p->Job[Str_p->JobTail & JOB_MASK].Result !=
+               UARTPIPE_RES_PENDING) {
+        Str_p->JobTail++;
+    }
+    UartPipe_kick(Str_p);
+    if (job_p->Func_p != NULL) {
+        job_p->Func_p(job_p->FuncPara_p);
+    }
+}
+
+static uint8_t UartPipe_submit(UartPipeStr_t* Str_p, uint8_t Type,
+                               uint8_t UartID, uint8_t RegAdd, uint8_t Bytes,
+                               void* Data_p, Func_t Func_p, void* FuncPara_p,
+                               uint8_t* Handle_p) {
+    uint8_t head = Str_p->JobHead;
+    uint8_t tx_bytes;
+    uint8_t chksum;
+    uint8_t sreg;
+    UartPipeJob_t* job_p;
+
+    if (Bytes == 0 || Bytes > UARTPIPE_MAX_BYTES) {
+        return 4;
+    }
+    if ((uint8_t)(head - Str_p->JobTail) >= UARTPIPE_MAX_JOB) {
+        return 2;
+    }
+    tx_bytes = (Type == UARTPIPE_TYPE_TRM) ? 6 + Bytes : 6;
+    if (tx_bytes > RingBuf_space(&Str_p->TxBuf)) {
+        return 3;
+    }
+
+    job_p             = &Str_p->Job[head & JOB_MASK];
+    job_p->Type       = Type;
+    job_p->UartID     = UartID;
+    job_p->Seq        = (head & SEQ_MASK) |
+                        (Type == UARTPIPE_TYPE_REC ? UARTPIPE_READ : 0);
+    job_p->Bytes      = Bytes;
+    job_p->Data_p     = (uint8_t*)Data_p;
+    job_p->TxBytes    = tx_bytes;
+    job_p->Sent       = 0;
+    job_p->Result     = UARTPIPE_RES_PENDING;
+    job_p->Func_p     = Func_p;
+    job_p->FuncPara_p = FuncPara_p;
+
+    RingBuf_put(&Str_p->TxBuf, UARTPIPE_CMD_HEADER);
+    RingBuf_put(&Str_p->TxBuf, UartID);
+    RingBuf_put(&Str_p->TxBuf, job_p->Seq);
+    RingBuf_put(&Str_p->TxBuf, RegAdd);
+    RingBuf_put(&Str_p->TxBuf, Bytes);
+    chksum = UartID + job_p->Seq + RegAdd + Bytes;
+    if (Type == UARTPIPE_TYPE_TRM) {
+        for (uint8_t i = 0; i < Bytes; i++) {
+            RingBuf_put(&Str_p->TxBuf, ((uint8_t*)Data_p)[i]);
+            chksum += ((uint8_t*)Data_p)[i];
+        }
+    }
+    RingBuf_put(&Str_p->TxBuf, chksum);
+
+    sreg = SREG;
+    cli();
+    Str_p->JobHead = head + 1;
+    UartPipe_kick(Str_p);
+    SREG = sreg;
+
+    *Handle_p = head;
+    return 0;
+}
+
+uint8_t UartPipe_net(UartPipeStr_t* Str_p, UartIntStr_t* UartIntStr_p,
+                     uint8_t Num, uint8_t Window, uint16_t Timeout) {
+    if (UartPipe_udr(&Str_p->Udr_p, Num)) {
+        return 1;
+    }
+    if (RingBuf_net(&Str_p->TxBuf, Str_p->TxData, UARTPIPE_TX_SZ)) {
+        return 2;
+    }
+    if (Window == 0 || Window > UARTPIPE_MAX_JOB) {
+        return 3;
+    }
+    Str_p->Window      = Window;
+    Str_p->Timeout     = Timeout;
+    Str_p->TxActive    = 0;
+    Str_p->TxLeft      = 0;
+    Str_p->Outstanding = 0;
+    Str_p->RxState     = RX_STATE_HEADER;
+    Str_p->Stray       = 0;
+    Str_p->JobHead     = 0;
+    Str_p->JobSent     = 0;
+    Str_p->JobTail     = 0;
+
+    Str_p->TxFb_Id = UartTxInt_reg(UartIntStr_p, UartPipe_txStep, Str_p);
+    Str_p->RxFb_Id = UartRxInt_reg(UartIntStr_p, UartPipe_rxStep, Str_p);
+    UartTxInt_en(UartIntStr_p, Str_p->TxFb_Id, ENABLE);
+    UartRxInt_en(UartIntStr_p, Str_p->RxFb_Id, ENABLE);
+    return 0;
+}
+
+uint8_t UartPipe_trm(UartPipeStr_t* Str_p, uint8_t UartID, uint8_t RegAdd,
+                     uint8_t Bytes, void* Data_p, Func_t Func_p,
+                     void* FuncPara_p, uint8_t* Handle_p) {
+    return UartPipe_submit(Str_p, UARTPIPE_TYPE_TRM, UartID, RegAdd, Bytes,
+                           Data_p, Func_p, FuncPara_p, Handle_p);
+}
+
+uint8_t UartPipe_rec(UartPipeStr_t* Str_p, uint8_t UartID, uint8_t RegAdd,
+                     uint8_t Bytes, void* Data_p, Func_t Func_p,
+                     void* FuncPara_p, uint8_t* Handle_p) {
+    return UartPipe_submit(Str_p, UARTPIPE_TYPE_REC, UartID, RegAdd, Bytes,
+                           Data_p, Func_p, FuncPara_p, Handle_p);
+}
+
+uint8_t UartPipe_isDone(UartPipeStr_t* Str_p, uint8_t Handle) {
+    uint8_t tail = Str_p->JobTail;
+
+    if ((uint8_t)(Handle - tail) >= (uint8_t)(Str_p->JobHead - tail)) {
+        return 1;
+    }
+    return Str_p->Job[Handle & JOB_MASK].Result != UARTPIPE_RES_PENDING;
+}
+
+uint8_t UartPipe_getResult(UartPipeStr_t* Str_p, uint8_t Handle) {
+    if (!UartPipe_isDone(Str_p, Handle)) {
+        return UARTPIPE_RES_PENDING;
+    }
+    return Str_p->Job[Handle & JOB_MASK].Result;
+}
+
+void UartPipe_tick(void* void_p) {
+    UartPipeStr_t* Str_p = (UartPipeStr_t*)void_p;
+
+    for (uint8_t i = Str_p->JobTail; i != Str_p->JobSent; i++) {
+        UartPipeJob_t* job_p = &Str_p->Job[i & JOB_MASK];
+        if (job_p->Sent && job_p->TimeLeft && --job_p->TimeLeft == 0) {
+            UartPipe_finish(Str_p, job_p, UARTPIPE_RES_TIMEOUT);
+        }
+    }
+}
+
+void UartPipe_txStep(void* void_p) {
+    UartPipeStr_t* Str_p = (UartPipeStr_t*)void_p;
+    uint8_t data;
+
+    if (!Str_p->TxActive) {
+        return;
+    }
+    if (Str_p->TxLeft) {
+        Str_p->TxLeft--;
+        RingBuf_get(&Str_p->TxBuf, &data);
+        *Str_p->Udr_p = data;
+    }
+    else {
+        Str_p->TxActive = 0;
+        UartPipe_kick(Str_p);
+    }
+}
+
+void UartPipe_rxStep(void* void_p) {
+    UartPipeStr_t* Str_p = (UartPipeStr_t*)void_p;
+    uint8_t data         = *Str_p->Udr_p;
+    UartPipeJob_t* job_p = Str_p->RxJob_p;
+
+    if (Str_p->RxState != RX_STATE_HEADER && Str_p->RxState != RX_STATE_CHKSUM) {
+        Str_p->RxSum += data;
+    }
+    switch (Str_p->RxState) {
+        case RX_STATE_HEADER:
+            if (data == UARTPIPE_RSP_HEADER) {
+                Str_p->RxSum   = 0;
+                Str_p->RxState = RX_STATE_UID;
+            }
+            break;
+        case RX_STATE_UID:
+            Str_p->RxUid   = data;
+            Str_p->RxState = RX_STATE_SEQ;
+            break;
+        case RX_STATE_SEQ:
+            job_p = &Str_p->Job[data & JOB_MASK];
+            if (!job_p->Sent || job_p->Seq != data ||
+                job_p->UartID != Str_p->RxUid) {
+                job_p = NULL;
+            }
+            Str_p->RxJob_p = job_p;
+            Str_p->RxState = RX_STATE_STATUS;
+            break;
+        case RX_STATE_STATUS:
+            Str_p->RxStatus = data;
+            Str_p->RxState  = RX_STATE_BYTES;
+            break;
+        case RX_STATE_BYTES:
+            Str_p->RxBytes = data;
+            Str_p->RxCount = 0;
+            if (job_p != NULL && data != 0 &&
+                (job_p->Type != UARTPIPE_TYPE_REC || data != job_p->Bytes)) {
+                Str_p->RxJob_p = NULL;
+            }
+            Str_p->RxState = data ? RX_STATE_DATA : RX_STATE_CHKSUM;
+            break;
+        case RX_STATE_DATA:
+            if (job_p != NULL) {
+                job_p->Data_p[Str_p->RxCount] = data;
+            }
+            if (++Str_p->RxCount == Str_p->RxBytes) {
+                Str_p->RxState = RX_STATE_CHKSUM;
+            }
+            break;
+        case RX_STATE_CHKSUM:
+            Str_p->RxState = RX_STATE_HEADER;
+            if (job_p == NULL) {
+                Str_p->Stray++;
+            }
+            else if (data != Str_p->RxSum) {
+                UartPipe_finish(Str_p, job_p, UARTPIPE_RES_CHKSUM);
+            }
+            else if (Str_p->RxStatus) {
+                UartPipe_finish(Str_p, job_p, Str_p->RxStatus);
+            }
+            else if (job_p->Type == UARTPIPE_TYPE_REC && Str_p->RxBytes == 0) {
+                UartPipe_finish(Str_p, job_p, UARTPIPE_RES_BYTES);
+            }
+            else {
+                UartPipe_finish(Str_p, job_p, UARTPIPE_RES_OK);
+            }
+            break;
+    }
+}
+
+/*-- Slave -------------------------------------------------------------------*/
+
+/* 將回應放入回應緩衝區並開始送出 */
+static void UartPipeS_reply(UartPipeSStr_t* Str_p, uint8_t Status) {
+    UartPipeRegStr_t* reg_p = NULL;
+    uint8_t bytes           = 0;
+    uint8_t chksum;
+    uint8_t data;
+
+    if (Status == UARTPIPE_RES_OK && (Str_p->RxSeq & UARTPIPE_READ)) {
+        reg_p = &Str_p->Reg_p[Str_p->RxRegAdd];
+        bytes = Str_p->RxBytes;
+    }
+    if (RingBuf_space(&Str_p->TxBuf) < 6 + bytes) {
+        Str_p->Drop++;
+        return;
+    }
+    RingBuf_put(&Str_p->TxBuf, UARTPIPE_RSP_HEADER);
+    RingBuf_put(&Str_p->TxBuf, Str_p->UartID);
+    RingBuf_put(&Str_p->TxBuf, Str_p->RxSeq);
+    RingBuf_put(&Str_p->TxBuf, Status);
+    RingBuf_put(&Str_p->TxBuf, bytes);
+    chksum = Str_p->UartID + Str_p->RxSeq + Status + bytes;
+    for (uint8_t i = 0; i < bytes; i++) {
+        data = ((uint8_t*)reg_p->Data_p)[i];
+        RingBuf_put(&Str_p->TxBuf, data);
+        chksum += data;
+    }
+    RingBuf_put(&Str_p->TxBuf, chksum);
+
+    if (!Str_p->TxActive) {
+        Str_p->TxActive = 1;
+        RingBuf_get(&Str_p->TxBuf, &data);
+        *Str_p->Udr_p = data;
+    }
+}
+
+/* 檢查命令的 RegAdd 與位元組數 */
+static uint8_t UartPipeS_check(UartPipeSStr_t* Str_p) {
+    if (Str_p->RxRegAdd >= Str_p->RegTotal ||
+        Str_p->Reg_p[Str_p->RxRegAdd].Data_p == NULL) {
+        return UARTPIPE_RES_REGADD;
+    }
+    if (Str_p->RxBytes != Str_p->Reg_p[Str_p->RxRegAdd].Bytes ||
+        Str_p->RxBytes > UARTPIPE_MAX_BYTES) {
+        return UARTPIPE_RES_BYTES;
+    }
+    return UARTPIPE_RES_OK;
+}
+
+uint8_t UartPipeS_net(UartPipeSStr_t* Str_p, UartIntStr_t* UartIntStr_p,
+                      uint8_t Num, uint8_t UartID, UartPipeRegStr_t* Reg_p,
+                      uint8_t RegTotal) {
+    if (UartPipe_udr(&Str_p->Udr_p, Num)) {
+        return 1;
+    }
+    if (RingBuf_net(&Str_p->TxBuf, Str_p->TxData, UARTPIPE_S_TX_SZ)) {
+        return 2;
+    }
+    Str_p->UartID   = UartID;
+    Str_p->Reg_p    = Reg_p;
+    Str_p->RegTotal = RegTotal;
+    Str_p->TxActive = 0;
+    Str_p->Drop     = 0;
+    Str_p->RxState  = RX_STATE_HEADER;
+
+    Str_p->TxFb_Id = UartTxInt_reg(UartIntStr_p, UartPipeS_txStep, Str_p);
+    Str_p->RxFb_Id = UartRxInt_reg(UartIntStr_p, UartPipeS_rxStep, Str_p);
+    UartTxInt_en(UartIntStr_p, Str_p->TxFb_Id, ENABLE);
+    UartRxInt_en(UartIntStr_p, Str_p->RxFb_Id, ENABLE);
+    return 0;
+}
+
+void UartPipeS_txStep(void* void_p) {
+    UartPipeSStr_t* Str_p = (UartPipeSStr_t*)void_p;
+    uint8_t data;
+
+    if (RingBuf_get(&Str_p->TxBuf, &data)) {
+        Str_p->TxActive = 0;
+    }
+    else {
+        *Str_p->Udr_p = data;
+    }
+}
+
+void UartPipeS_rxStep(void* void_p) {
+    UartPipeSStr_t* Str_p = (UartPipeSStr_t*)void_p;
+    uint8_t data          = *Str_p->Udr_p;
+    uint8_t status;
+
+    if (Str_p->RxState != RX_STATE_HEADER && Str_p->RxState != RX_STATE_CHKSUM) {
+        Str_p->RxSum += data;
+    }
+    switch (Str_p->RxState) {
+        case RX_STATE_HEADER:
+            if (data == UARTPIPE_CMD_HEADER) {
+                Str_p->RxSum   = 0;
+                Str_p->RxState = RX_STATE_UID;
+            }
+            break;
+        case RX_STATE_UID:
+            Str_p->RxMatch = (data == Str_p->UartID);
+            Str_p->RxState = RX_STATE_SEQ;
+            break;
+        case RX_STATE_SEQ:
+            Str_p->RxSeq   = data;
+            Str_p->RxState = RX_STATE_STATUS;
+            break;
+        case RX_STATE_STATUS:
+            Str_p->RxRegAdd = data;
+            Str_p->RxState  = RX_STATE_BYTES;
+            break;
+        case RX_STATE_BYTES:
+            Str_p->RxBytes = data;
+            Str_p->RxCount = 0;
+            /* 讀取命令不帶資料 */
+            Str_p->RxState = (data && !(Str_p->RxSeq & UARTPIPE_READ))
+                                 ? RX_STATE_DATA
+                                 : RX_STATE_CHKSUM;
+            break;
+        case RX_STATE_DATA:
+            if (Str_p->RxCount < UARTPIPE_MAX_BYTES) {
+                Str_p->Stage[Str_p->RxCount] = data;
+            }
+            if (++Str_p->RxCount == Str_p->RxBytes) {
+                Str_p->RxState = RX_STATE_CHKSUM;
+            }
+            break;
+        case RX_STATE_CHKSUM:
+            Str_p->RxState = RX_STATE_HEADER;
+            if (!Str_p->RxMatch) {
+                break;
+            }
+            if (data != Str_p->RxSum) {
+                status = UARTPIPE_RES_CHKSUM;
+            }
+            else {
+                status = UartPipeS_check(Str_p);
+            }
+            if (status == UARTPIPE_RES_OK &&
+                !(Str_p->RxSeq & UARTPIPE_READ)) {
+                uint8_t* reg_p =
+                    (uint8_t*)Str_p->Reg_p[Str_p->RxRegAdd].Data_p;
+                for (uint8_t i = 0; i < Str_p->RxBytes; i++) {
+                    reg_p[i] = Str_p->Stage[i];
+                }
+            }
+            UartPipeS_reply(Str_p, status);
+            break;
+    }
+}
@@ -0,0 +1,270 @@
+/**
+ * @file uart_pipe.h
+ * @brief 具序號與傳送視窗的管線化 UART Mode 0 傳輸(Master 與 Slave)。
+ *
+ * UARTM_trm Mode 0 與 UartStream 每送出一個封包都要等到 Slave 回應
+ * ASAUART_RSP_HEADER 才能送下一個，來回等待時間讓通訊線閒置。UartPipe
+ * 在封包中加入7位元序號，Master 最多可同時有 Window 個尚未回應的封包，
+ * 回應依序號配對，不需依送出順序到達。
+ *
+ * 命令封包：[0xAC][UID][R/W|Seq][RegAdd][Bytes][Data...][checksum]
+ *  - R/W|Seq：bit7 為1表示讀取，bit0~6 為序號。
+ *  - Bytes：寫入時為資料位元組數，讀取時為要求的位元組數，讀取時不帶 Data。
+ * 回應封包：[0xAD][UID][R/W|Seq][Status][Bytes][Data...][checksum]
+ *  - Status：0 成功，其餘為 UARTPIPE_RES_* 錯誤代碼。
+ *  - Bytes：讀取成功時為資料位元組數，其餘為0。
+ * checksum 為 UID 至最後一個資料位元組的 8 位元總和，資料皆由低至高傳輸。
+ *
+ * 多個封包未回應時 Master 送出與 Slave 回應可能同時發生，通訊線須為
+ * 全雙工(RS-232、RS-422 或 4 線 RS-485)。
+ *
+ * 多個 Slave 共用同一條回應線，每個 Slave 確認 checksum 後立即回應，
+ * 不同裝置的回應若重疊就會碰撞。因此同一時間只對一個 UART ID 管線化：
+ * 下一個封包的目標與已送出未回應的封包不同時，等這些封包全部回應或
+ * 逾時後才送出。Timeout 須大於 Slave 的回應時間，否則逾時後才到達的
+ * 回應仍可能與下一個裝置的回應碰撞。
+ */
+
+#ifndef UART_PIPE_H
+#define UART_PIPE_H
+
+#include "c4mlib.h"
+#include "ringbuf.h"
+
+#define UARTPIPE_CMD_HEADER 0xAC  ///< 命令封包頭 @ingroup uartpipe_macro
+#define UARTPIPE_RSP_HEADER 0xAD  ///< 回應封包頭 @ingroup uartpipe_macro
+#define UARTPIPE_READ       0x80  ///< 序號欄位中的讀取旗標 @ingroup uartpipe_macro
+
+#define UARTPIPE_TYPE_TRM 0  ///< 傳送工作 @ingroup uartpipe_macro
+#define UARTPIPE_TYPE_REC 1  ///< 接收工作 @ingroup uartpipe_macro
+
+#define UARTPIPE_RES_OK      0     ///< 傳輸成功 @ingroup uartpipe_macro
+#define UARTPIPE_RES_TIMEOUT 1     ///< 回應逾時 @ingroup uartpipe_macro
+#define UARTPIPE_RES_REGADD  2     ///< Slave 沒有此暫存器 @ingroup uartpipe_macro
+#define UARTPIPE_RES_CHKSUM  3     ///< checksum 錯誤 @ingroup uartpipe_macro
+#define UARTPIPE_RES_BYTES   4     ///< 位元組數與暫存器大小不符 @ingroup uartpipe_macro
+#define UARTPIPE_RES_PENDING 0xFF  ///< 傳輸尚未完成 @ingroup uartpipe_macro
+
+#if UARTPIPE_MAX_JOB < 2 || UARTPIPE_MAX_JOB > 64 || \
+    (UARTPIPE_MAX_JOB & (UARTPIPE_MAX_JOB - 1))
+#    error "UARTPIPE_MAX_JOB must be a power of two between 2 and 64"
+#endif
+
+/**
+ * @brief UartPipe 傳輸工作結構
+ * @ingroup uartpipe_struct
+ */
+typedef struct {
+    uint8_t Type;               ///< 工作種類，傳送或接收。
+    uint8_t UartID;             ///< 目標裝置的 UART ID。
+    uint8_t Seq;                ///< 封包序號欄位，含讀取旗標。
+    uint8_t Bytes;              ///< 資料位元組數。
+    uint8_t* Data_p;            ///< 接收工作的資料存放指標。
+    uint8_t TxBytes;            ///< 本工作在傳送緩衝區中的位元組數。
+    volatile uint8_t Sent;      ///< 已送出、等待回應中。
+    volatile uint16_t TimeLeft; ///< 等待回應的剩餘逾時計數。
+    volatile uint8_t Result;    ///< 傳輸結果。
+    Func_t Func_p;              ///< 完成時執行函式。
+    void* FuncPara_p;           ///< 完成時執行函式之傳參。
+} UartPipeJob_t;
+
+/**
+ * @brief UartPipe Master 管理結構
+ * @ingroup uartpipe_struct
+ *
+ * JobTail ≤ JobSent ≤ JobHead，JobTail 到 JobSent 之間為已送出的工作，
+ * JobSent 到 JobHead 之間為已放入傳送緩衝區但受視窗限制尚未送出的工作。
+ */
+typedef struct {
+    volatile uint8_t* Udr_p;       ///< UART 資料暫存器指標。
+    uint8_t TxFb_Id;               ///< 傳送中斷中功能方塊名單編號。
+    uint8_t RxFb_Id;               ///< 接收中斷中功能方塊名單編號。
+    uint8_t Window;                ///< 最多同時未回應的封包數。
+    uint16_t Timeout;              ///< 等待回應的逾時計數，0 為不逾時。
+
+    RingBufStr_t TxBuf;            ///< 傳送環狀緩衝區。
+    uint8_t TxData[UARTPIPE_TX_SZ];
+    volatile uint8_t TxActive;     ///< 正在送出封包。
+    volatile uint8_t TxLeft;       ///< 目前封包尚未送出的位元組數。
+    volatile uint8_t Outstanding;  ///< 已送出尚未回應的封包數。
+    uint8_t TxUid;                 ///< 已送出尚未回應封包的 UART ID。
+
+    uint8_t RxState;               ///< 回應解包狀態。
+    uint8_t RxUid;                 ///< 回應中的 UART ID。
+    uint8_t RxStatus;              ///< 回應中的 Status。
+    uint8_t RxBytes;               ///< 回應中的資料位元組數。
+    uint8_t RxCount;               ///< 已接收資料位元組數。
+    uint8_t RxSum;                 ///< 接收 checksum。
+    UartPipeJob_t* RxJob_p;        ///< 回應對應的工作，無法配對時為 NULL。
+    volatile uint8_t Stray;        ///< 無法配對而捨棄的回應數。
+
+    volatile uint8_t JobHead;      ///< 已排入工作計數，亦為下一個傳輸編號。
+    volatile uint8_t JobSent;      ///< 已送出工作計數。
+    volatile uint8_t JobTail;      ///< 已完成工作計數。
+    UartPipeJob_t Job[UARTPIPE_MAX_JOB];
+} UartPipeStr_t;
+
+/**
+ * @brief UartPipe Slave 暫存器描述結構
+ * @ingroup uartpipe_struct
+ */
+typedef struct {
+    void* Data_p;   ///< 暫存器資料指標。
+    uint8_t Bytes;  ///< 暫存器位元組數。
+} UartPipeRegStr_t;
+
+/**
+ * @brief UartPipe Slave 管理結構
+ * @ingroup uartpipe_struct
+ */
+typedef struct {
+    volatile uint8_t* Udr_p;       ///< UART 資料暫存器指標。
+    uint8_t TxFb_Id;               ///< 傳送中斷中功能方塊名單編號。
+    uint8_t RxFb_Id;               ///< 接收中斷中功能方塊名單編號。
+    uint8_t UartID;                ///< 本裝置的 UART ID。
+    UartPipeRegStr_t* Reg_p;       ///< 暫存器描述陣列，以 RegAdd 為索引。
+    uint8_t RegTotal;              ///< 暫存器描述數量。
+
+    RingBufStr_t TxBuf;            ///< 回應環狀緩衝區。
+    uint8_t TxData[UARTPIPE_S_TX_SZ];
+    volatile uint8_t TxActive;     ///< 正在送出回應。
+    volatile uint8_t Drop;         ///< 回應緩衝區不足而未回應的命令數。
+
+    uint8_t RxState;               ///< 命令解包狀態。
+    uint8_t RxMatch;               ///< 命令 UID 與本裝置相同。
+    uint8_t RxSeq;                 ///< 命令序號欄位。
+    uint8_t RxRegAdd;              ///< 命令暫存器位址。
+    uint8_t RxBytes;               ///< 命令位元組數。
+    uint8_t RxCount;               ///< 已接收資料位元組數。
+    uint8_t RxSum;                 ///< 接收 checksum。
+    uint8_t Stage[UARTPIPE_MAX_BYTES];  ///< checksum 確認前的寫入資料。
+} UartPipeSStr_t;
+
+/**
+ * @brief 初始化 UartPipe Master 並註冊至 UART 中斷。
+ *
+ * @ingroup uartpipe_func
+ * @param Str_p        UartPipe 管理結構指標。
+ * @param UartIntStr_p 已完成 UartInt_net 的 UART 中斷結構指標。
+ * @param Num          UART 硬體編號，0 或 1。
+ * @param Window       最多同時未回應的封包數，1~UARTPIPE_MAX_JOB。
+ * @param Timeout      等待回應的逾時計數，以 UartPipe_tick 的呼叫次數計，
+ *                     0 為不逾時。
+ * @return uint8_t 錯誤代碼：
+ *   - 0：成功無誤。
+ *   - 1：參數 Num 錯誤。
+ *   - 2：UARTPIPE_TX_SZ 設定錯誤。
+ *   - 3：參數 Window 錯誤。
+ *
+ * Window 為1時行為與 UartStream 相同，只差在封包格式。
+ */
+uint8_t UartPipe_net(UartPipeStr_t* Str_p, UartIntStr_t* UartIntStr_p,
+                     uint8_t Num, uint8_t Window, uint16_t Timeout);
+
+/**
+ * @brief 非阻塞管線化多位元組傳送。
+ *
+ * @ingroup uartpipe_func
+ * @param Str_p      UartPipe 管理結構指標。
+ * @param UartID     目標裝置的 UART ID。
+ * @param RegAdd     遠端讀寫暫存器位址。
+ * @param Bytes      待送資料位元組數，1~UARTPIPE_MAX_BYTES。
+ * @param Data_p     待送資料指標，呼叫返回後即可重複使用。
+ * @param Func_p     完成時執行函式，於中斷中執行，可為 NULL。
+ * @param FuncPara_p 完成時執行函式之傳參。
+ * @param Handle_p   回傳傳輸編號。
+ * @return uint8_t 錯誤代碼：
+ *   - 0：成功無誤。
+ *   - 2：工作佇列已滿。
+ *   - 3：傳送緩衝區空間不足。
+ *   - 4：參數 Bytes 錯誤。
+ *
+ * UartID 與已送出未回應的封包不同時，封包留在傳送緩衝區，等那些封包
+ * 全部完成後才送出。
+ */
+uint8_t UartPipe_trm(UartPipeStr_t* Str_p, uint8_t UartID, uint8_t RegAdd,
+                     uint8_t Bytes, void* Data_p, Func_t Func_p,
+                     void* FuncPara_p, uint8_t* Handle_p);
+
+/**
+ * @brief 非阻塞管線化多位元組接收。
+ *
+ * @ingroup uartpipe_func
+ * @param Data_p 待收資料指標，完成前不可釋放。
+ *
+ * 其餘參數與回傳值同 UartPipe_trm。
+ */
+uint8_t UartPipe_rec(UartPipeStr_t* Str_p, uint8_t UartID, uint8_t RegAdd,
+                     uint8_t Bytes, void* Data_p, Func_t Func_p,
+                     void* FuncPara_p, uint8_t* Handle_p);
+
+/**
+ * @brief 查詢傳輸是否完成。
+ *
+ * @ingroup uartpipe_func
+ * @return uint8_t 1：已完成，0：尚未完成。
+ */
+uint8_t UartPipe_isDone(UartPipeStr_t* Str_p, uint8_t Handle);
+
+/**
+ * @brief 取得傳輸結果。
+ *
+ * @ingroup uartpipe_func
+ * @return uint8_t UARTPIPE_RES_* 結果代碼，尚未完成時為
+ * UARTPIPE_RES_PENDING。結果保留至該編號的工作欄位被重新使用為止。
+ */
+uint8_t UartPipe_getResult(UartPipeStr_t* Str_p, uint8_t Handle);
+
+/**
+ * @brief 回應逾時計數執行片段，可註冊到計時中斷或 IntFreqDiv 中。
+ * @ingroup uartpipe_func
+ */
+void UartPipe_tick(void* Str_p);
+
+/**
+ * @brief Master 傳送完成中斷執行片段，由 UartPipe_net 註冊。
+ * @ingroup uartpipe_func
+ */
+void UartPipe_txStep(void* Str_p);
+
+/**
+ * @brief Master 接收完成中斷執行片段，由 UartPipe_net 註冊。
+ * @ingroup uartpipe_func
+ */
+void UartPipe_rxStep(void* Str_p);
+
+/**
+ * @brief 初始化 UartPipe Slave 並註冊至 UART 中斷。
+ *
+ * @ingroup uartpipe_func
+ * @param Str_p        UartPipe Slave 管理結構指標。
+ * @param UartIntStr_p 已完成 UartInt_net 的 UART 中斷結構指標。
+ * @param Num          UART 硬體編號，0 或 1。
+ * @param UartID       本裝置的 UART ID。
+ * @param Reg_p        暫存器描述陣列，以 RegAdd 為索引。
+ * @param RegTotal     暫存器描述數量。
+ * @return uint8_t 錯誤代碼：
+ *   - 0：成功無誤。
+ *   - 1：參數 Num 錯誤。
+ *   - 2：UARTPIPE_S_TX_SZ 設定錯誤。
+ *
+ * 命令依收到順序處理，每個命令 checksum 確認後才寫入暫存器並排入回應，
+ * 回應在傳送中斷中背靠背送出，不會阻擋後續命令的接收。
+ */
+uint8_t UartPipeS_net(UartPipeSStr_t* Str_p, UartIntStr_t* UartIntStr_p,
+                      uint8_t Num, uint8_t UartID, UartPipeRegStr_t* Reg_p,
+                      uint8_t RegTotal);
+
+/**
+ * @brief Slave 傳送完成中斷執行片段，由 UartPipeS_net 註冊。
+ * @ingroup uartpipe_func
+ */
+void UartPipeS_txStep(void* Str_p);
+
+/**
+ * @brief Slave 接收完成中斷執行片段，由 UartPipeS_net 註冊。
+ * @ingroup uartpipe_func
+ */
+void UartPipeS_rxStep(void* Str_p);
+
+#endif  // UART_PIPE_H
@@ -0,0 +1,329 @@
+/**
+ * @file uart_stream.c
+ * @brief UartStream 非阻塞 UART Master Mode 0 傳輸引擎實作。
+ */
+
+#include "uart_stream.h"
+
+#define JOB_MASK (UARTSTREAM_MAX_JOB - 1)
+
+#define RX_STATE_HEADER 0
+#define RX_STATE_DATA   1
+#define RX_STATE_CHKSUM 2
+
+#if (UARTSTREAM_MAX_JOB & JOB_MASK) != 0
+#    error "UARTSTREAM_MAX_JOB must be a power of two"
+#endif
+#if UARTSTREAM_REC_SZ < 1 || UARTSTREAM_REC_SZ > 255
+#    error "UARTSTREAM_REC_SZ must be in 1~255"
+#endif
+
+/* 開始傳送佇列最前端的工作，須在中斷中或關閉中斷時呼叫 */
+static void UartStream_kick(UartStreamStr_t* Str_p) {
+    UartStreamJob_t* job_p = &Str_p->Job[Str_p->JobTail & JOB_MASK];
+    uint8_t data;
+
+    Str_p->TxBusy   = 1;
+    Str_p->RxState  = RX_STATE_HEADER;
+    Str_p->RxCount  = 0;
+    Str_p->RxSum    = 0;
+    Str_p->TimeLeft = Str_p->Timeout;
+    Str_p->TxLeft   = job_p->TxBytes - 1;
+    RingBuf_get(&Str_p->TxBuf, &data);
+    *Str_p->Udr_p = data;
+}
+
+/* 結束佇列最前端的工作，並接續下一筆工作 */
+static void UartStream_finish(UartStreamStr_t* Str_p, uint8_t Result) {
+    UartStreamJob_t* job_p = &Str_p->Job[Str_p->JobTail & JOB_MASK];
+    Func_t func_p          = job_p->Func_p;
+    void* para_p           = job_p->FuncPara_p;
+
+    job_p->Result = Result;
+    Str_p->JobTail++;
+    if (Str_p->JobTail != Str_p->JobHead) {
+        UartStream_kick(Str_p);
+    }
+    else {
+        Str_p->TxBusy = 0;
+    }
+    if (func_p != NULL) {
+        func_p(para_p);
+    }
+}
+
+/* 填寫工作欄位並排入佇列，封包須已放入傳送緩衝區 */
+static void UartStream_queue(UartStreamStr_t* Str_p, uint8_t Type,
+                             uint8_t UartID, uint8_t RegAdd, uint8_t Bytes,
+                             void* Data_p, uint8_t TxBytes, Func_t Func_p,
+                             void* FuncPara_p, uint8_t* Handle_p) {
+    uint8_t head           = Str_p->JobHead;
+    UartStreamJob_t* job_p = &Str_p->Job[head & JOB_MASK];
+    uint8_t sreg;
+
+    job_p->Type       = Type;
+    job_p->UartID     = UartID;
+    job_p->RegAdd     = RegAdd;
+    job_p->Bytes      = Bytes;
+    job_p->Data_p     = (uint8_t*)Data_p;
+    job_p->TxBytes    = TxBytes;
+    job_p->Result     = UARTSTREAM_RES_PENDING;
+    job_p->Func_p     = Func_p;
+    job_p->FuncPara_p = FuncPara_p;
+
+    sreg = SREG;
+    cli();
+    Str_p->JobHead = head + 1;
+    if (!Str_p->TxBusy) {
+        UartStream_kick(Str_p);
+    }
+    SREG = sreg;
+
+    *Handle_p = head;
+}
+
+static uint8_t UartStream_submit(UartStreamStr_t* Str_p, uint8_t Type,
+                                 uint8_t UartID, uint8_t RegAdd, uint8_t Bytes,
+                                 void* Data_p, Func_t Func_p, void* FuncPara_p,
+                                 uint8_t* Handle_p) {
+    uint16_t tx_bytes;
+    uint8_t reg_add;
+    uint8_t chksum;
+
+    if ((uint8_t)(Str_p->JobHead - Str_p->JobTail) >= UARTSTREAM_MAX_JOB) {
+        return 2;
+    }
+    /* 0x7F 為批次封包標記，不可作為單一暫存器位址 */
+    if (RegAdd >= UARTSTREAM_BULK_W) {
+        return 4;
+    }
+    if (Type == UARTSTREAM_TYPE_REC && Bytes > UARTSTREAM_REC_SZ) {
+        return 4;
+    }
+    tx_bytes = (Type == UARTSTREAM_TYPE_TRM) ? 4 + (uint16_t)Bytes : 4;
+    if (tx_bytes > RingBuf_space(&Str_p->TxBuf)) {
+        return 3;
+    }
+
+    RingBuf_put(&Str_p->TxBuf, ASAUART_CMD_HEADER);
+    /* 同 UARTM_rec，讀取命令的 RegAdd 最高位元為 1 */
+    reg_add = (Type == UARTSTREAM_TYPE_REC) ? (RegAdd | 0x80) : RegAdd;
+    RingBuf_put(&Str_p->TxBuf, UartID);
+    RingBuf_put(&Str_p->TxBuf, reg_add);
+    chksum = UartID + reg_add;
+    if (Type == UARTSTREAM_TYPE_TRM) {
+        for (uint8_t i = 0; i < Bytes; i++) {
+            RingBuf_put(&Str_p->TxBuf, ((uint8_t*)Data_p)[i]);
+            chksum += ((uint8_t*)Data_p)[i];
+        }
+    }
+    RingBuf_put(&Str_p->TxBuf, chksum);
+
+    UartStream_queue(Str_p, Type, UartID, reg_add, Bytes, Data_p,
+                     (uint8_t)tx_bytes, Func_p, FuncPara_p, Handle_p);
+    return 0;
+}
+
+static uint8_t UartStream_submitBulk(UartStreamStr_t* Str_p, uint8_t Type,
+                                     uint8_t UartID,
+                                     const UartStreamBulkStr_t* List_p,
+                                     uint8_t Num, void* Data_p, Func_t Func_p,
+                                     void* FuncPara_p, uint8_t* Handle_p) {
+    uint16_t bytes = 0;
+    uint16_t tx_bytes;
+    uint8_t reg_add;
+    uint8_t chksum;
+
+    if ((uint8_t)(Str_p->JobHead - Str_p->JobTail) >= UARTSTREAM_MAX_JOB) {
+        return 2;
+    }
+    for (uint8_t i = 0; i < Num; i++) {
+        bytes += List_p[i].Bytes;
+    }
+    tx_bytes = 5 + 2 * (uint16_t)Num;
+    if (Type == UARTSTREAM_TYPE_TRM) {
+        tx_bytes += bytes;
+    }
+    if (Num == 0 || bytes > 0xFF || tx_bytes > 0xFF) {
+        return 4;
+    }
+    if (Type == UARTSTREAM_TYPE_REC && bytes > UARTSTREAM_REC_SZ) {
+        return 4;
+    }
+    if (tx_bytes > RingBuf_space(&Str_p->TxBuf)) {
+        return 3;
+    }
+
+    reg_add =
+        (Type == UARTSTREAM_TYPE_TRM) ? UARTSTREAM_BULK_W : UARTSTREAM_BULK_R;
+    RingBuf_put(&Str_p->TxBuf, ASAUART_CMD_HEADER);
+    RingBuf_put(&Str_p->TxBuf, UartID);
+    RingBuf_put(&Str_p->TxBuf, reg_add);
+    RingBuf_put(&Str_p->TxBuf, Num);
+    chksum = UartID + reg_add + Num;
+    for (uint8_t i = 0; i < Num; i++) {
+        RingBuf_put(&Str_p->TxBuf, List_p[i].RegAdd);
+        RingBuf_put(&Str_p->TxBuf, List_p[i].Bytes);
+        chksum += List_p[i].RegAdd + List_p[i].Bytes;
+    }
+    if (Type == UARTSTREAM_TYPE_TRM) {
+        for (uint8_t i = 0; i < bytes; i++) {
+            RingBuf_put(&Str_p->TxBuf, ((uint8_t*)Data_p)[i]);
+            chksum += ((uint8_t*)Data_p)[i];
+        }
+    }
+    RingBuf_put(&Str_p->TxBuf, chksum);
+
+    UartStream_queue(Str_p, Type, UartID, reg_add, (uint8_t)bytes, Data_p,
+                     (uint8_t)tx_bytes, Func_p, FuncPara_p, Handle_p);
+    return 0;
+}
+
+uint8_t UartStream_net(UartStreamStr_t* Str_p, UartIntStr_t* UartIntStr_p,
+                       uint8_t Num, uint16_t Timeout) {
+    switch (Num) {
+        case 0:
+            Str_p->Udr_p = &UDR0;
+            break;
+        case 1:
+            Str_p->Udr_p = &UDR1;
+            break;
+        default:
+            return 1;
+    }
+    if (RingBuf_net(&Str_p->TxBuf, Str_p->TxData, UARTSTREAM_TX_SZ) ||
+        RingBuf_net(&Str_p->RxBuf, Str_p->RxData, UARTSTREAM_RX_SZ)) {
+        return 2;
+    }
+    Str_p->TxBusy   = 0;
+    Str_p->TxLeft   = 0;
+    Str_p->Timeout  = Timeout;
+    Str_p->TimeLeft = 0;
+    Str_p->JobHead  = 0;
+    Str_p->JobTail  = 0;
+
+    Str_p->TxFb_Id = UartTxInt_reg(UartIntStr_p, UartStream_txStep, Str_p);
+    Str_p->RxFb_Id = UartRxInt_reg(UartIntStr_p, UartStream_rxStep, Str_p);
+    UartTxInt_en(UartIntStr_p, Str_p->TxFb_Id, ENABLE);
+    UartRxInt_en(UartIntStr_p, Str_p->RxFb_Id, ENABLE);
+    return 0;
+}
+
+uint8_t UartStream_trm(UartStreamStr_t* Str_p, uint8_t UartID, uint8_t RegAdd,
+                       uint8_t Bytes, void* Data_p, Func_t Func_p,
+                       void* FuncPara_p, uint8_t* Handle_p) {
+    return UartStream_submit(Str_p, UARTSTREAM_TYPE_TRM, UartID, RegAdd, Bytes,
+                             Data_p, Func_p, FuncPara_p, Handle_p);
+}
+
+uint8_t UartStream_rec(UartStreamStr_t* Str_p, uint8_t UartID, uint8_t RegAdd,
+                       uint8_t Bytes, void* Data_p, Func_t Func_p,
+                       void* FuncPara_p, uint8_t* Handle_p) {
+    return UartStream_submit(Str_p, UARTSTREAM_TYPE_REC, UartID, RegAdd, Bytes,
+                             Data_p, Func_p, FuncPara_p, Handle_p);
+}
+
+uint8_t UartStream_bulkTrm(UartStreamStr_t* Str_p, uint8_t UartID,
+                           const UartStreamBulkStr_t* List_p, uint8_t Num,
+                           void* Data_p, Func_t Func_p, void* FuncPara_p,
+                           uint8_t* Handle_p) {
+    return UartStream_submitBulk(Str_p, UARTSTREAM_TYPE_TRM, UartID, List_p,
+                                 Num, Data_p, Func_p, FuncPara_p, Handle_p);
+}
+
+uint8_t UartStream_bulkRec(UartStreamStr_t* Str_p, uint8_t UartID,
+                           const UartStreamBulkStr_t* List_p, uint8_t Num,
+                           void* Data_p, Func_t Func_p, void* FuncPara_p,
+                           uint8_t* Handle_p) {
+    return UartStream_submitBulk(Str_p, UARTSTREAM_TYPE_REC, UartID, List_p,
+                                 Num, Data_p, Func_p, FuncPara_p, Handle_p);
+}
+
+uint8_t UartStream_isDone(UartStreamStr_t* Str_p, uint8_t Handle) {
+    uint8_t tail = Str_p->JobTail;
+    return (uint8_t)(Handle - tail) >= (uint8_t)(Str_p->JobHead - tail);
+}
+
+uint8_t UartStream_getResult(UartStreamStr_t* Str_p, uint8_t Handle) {
+    if (!UartStream_isDone(Str_p, Handle)) {
+        return UARTSTREAM_RES_PENDING;
+    }
+    return Str_p->Job[Handle & JOB_MASK].Result;
+}
+
+uint8_t UartStream_read(UartStreamStr_t* Str_p, uint8_t* Data_p) {
+    return RingBuf_get(&Str_p->RxBuf, Data_p);
+}
+
+void UartStream_tick(void* void_p) {
+    UartStreamStr_t* Str_p = (UartStreamStr_t*)void_p;
+    uint8_t data;
+
+    if (!Str_p->TxBusy || Str_p->TimeLeft == 0) {
+        return;
+    }
+    if (--Str_p->TimeLeft == 0) {
+        /* 丟棄尚未送出的部分，避免接在下一筆工作的封包前 */
+        while (Str_p->TxLeft) {
+            Str_p->TxLeft--;
+            RingBuf_get(&Str_p->TxBuf, &data);
+        }
+        UartStream_finish(Str_p, UARTSTREAM_RES_TIMEOUT);
+    }
+}
+
+void UartStream_txStep(void* void_p) {
+    UartStreamStr_t* Str_p = (UartStreamStr_t*)void_p;
+    uint8_t data;
+
+    if (Str_p->TxLeft) {
+        Str_p->TxLeft--;
+        RingBuf_get(&Str_p->TxBuf, &data);
+        *Str_p->Udr_p = data;
+    }
+}
+
+void UartStream_rxStep(void* void_p) {
+    UartStreamStr_t* Str_p = (UartStreamStr_t*)void_p;
+    uint8_t data           = *Str_p->Udr_p;
+    UartStreamJob_t* job_p;
+
+    if (!Str_p->TxBusy || Str_p->TxLeft) {
+        RingBuf_put(&Str_p->RxBuf, data);
+        return;
+    }
+
+    job_p = &Str_p->Job[Str_p->JobTail & JOB_MASK];
+    switch (Str_p->RxState) {
+        case RX_STATE_HEADER:
+            if (data != ASAUART_RSP_HEADER) {
+                UartStream_finish(Str_p, UARTSTREAM_RES_SLAVE);
+            }
+            else if (job_p->Type == UARTSTREAM_TYPE_TRM) {
+                UartStream_finish(Str_p, UARTSTREAM_RES_OK);
+            }
+            else {
+                Str_p->RxState =
+                    job_p->Bytes ? RX_STATE_DATA : RX_STATE_CHKSUM;
+            }
+            break;
+        case RX_STATE_DATA:
+            Str_p->RxStage[Str_p->RxCount] = data;
+            Str_p->RxSum += data;
+            if (++Str_p->RxCount == job_p->Bytes) {
+                Str_p->RxState = RX_STATE_CHKSUM;
+            }
+            break;
+        case RX_STATE_CHKSUM:
+            /* 同 UARTM_rec，checksum 正確才寫入使用者的資料 */
+            if (data != Str_p->RxSum) {
+                UartStream_finish(Str_p, UARTSTREAM_RES_CHKSUM);
+                break;
+            }
+            for (uint8_t i = 0; i < job_p->Bytes; i++) {
+                job_p->Data_p[i] = Str_p->RxStage[i];
+            }
+            UartStream_finish(Str_p, UARTSTREAM_RES_OK);
+            break;
+    }
+}
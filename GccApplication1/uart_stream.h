@@ -0,0 +1,249 @@
+/**
+ * @file uart_stream.h
+ * @brief 中斷驅動、環狀緩衝的 UART Master Mode 0 非阻塞傳輸引擎。
+ *
+ * UARTM_trm / UARTM_rec 在傳輸期間會以 WaitTick 忙碌等待，整個封包期間
+ * 主程式都無法執行。UartStream 將封包放入傳送環狀緩衝區後立即返回傳輸
+ * 編號，由 UartIntStr_t 的 TxIntFb / RxIntFb 中斷逐位元組送收，封包與
+ * checksum 完成後呼叫使用者註冊的完成函式。
+ */
+
+#ifndef UART_STREAM_H
+#define UART_STREAM_H
+
+#include "c4mlib.h"
+#include "ringbuf.h"
+
+#ifndef ASAUART_CMD_HEADER
+#    define ASAUART_CMD_HEADER 0xAA  ///< Mode 0 命令封包頭 @ingroup uartstream_macro
+#endif
+#ifndef ASAUART_RSP_HEADER
+#    define ASAUART_RSP_HEADER 0xAB  ///< Mode 0 回應封包頭 @ingroup uartstream_macro
+#endif
+
+#define UARTSTREAM_BULK_W 0x7F  ///< 批次寫入的 RegAdd 欄位 @ingroup uartstream_macro
+#define UARTSTREAM_BULK_R 0xFF  ///< 批次讀取的 RegAdd 欄位 @ingroup uartstream_macro
+
+#define UARTSTREAM_TYPE_TRM 0  ///< 傳送工作 @ingroup uartstream_macro
+#define UARTSTREAM_TYPE_REC 1  ///< 接收工作 @ingroup uartstream_macro
+
+#define UARTSTREAM_RES_OK      0  ///< 傳輸成功 @ingroup uartstream_macro
+#define UARTSTREAM_RES_TIMEOUT 1  ///< 等待回應逾時 @ingroup uartstream_macro
+#define UARTSTREAM_RES_CHKSUM  3  ///< 回應 checksum 錯誤 @ingroup uartstream_macro
+#define UARTSTREAM_RES_SLAVE   6  ///< Slave 回應錯誤資訊 @ingroup uartstream_macro
+#define UARTSTREAM_RES_PENDING 0xFF  ///< 傳輸尚未完成 @ingroup uartstream_macro
+
+/**
+ * @brief UartStream 傳輸工作結構
+ * @ingroup uartstream_struct
+ */
+typedef struct {
+    uint8_t Type;              ///< 工作種類，傳送或接收。
+    uint8_t UartID;            ///< 目標裝置的 UART ID。
+    uint8_t RegAdd;            ///< 封包中的 RegAdd 欄位。
+    uint8_t Bytes;             ///< 資料位元組數。
+    uint8_t* Data_p;           ///< 接收工作的資料存放指標。
+    uint8_t TxBytes;           ///< 本工作在傳送緩衝區中的位元組數。
+    volatile uint8_t Result;   ///< 傳輸結果。
+    Func_t Func_p;             ///< 完成時執行函式。
+    void* FuncPara_p;          ///< 完成時執行函式之傳參。
+} UartStreamJob_t;
+
+/**
+ * @brief 批次傳輸列表項
+ * @ingroup uartstream_struct
+ */
+typedef struct {
+    uint8_t RegAdd;  ///< 遠端暫存器位址。
+    uint8_t Bytes;   ///< 暫存器位元組數。
+} UartStreamBulkStr_t;
+
+/**
+ * @brief UartStream 管理結構
+ * @ingroup uartstream_struct
+ *
+ * 傳送、接收緩衝區與工作佇列皆為單一生產者、單一消費者結構，
+ * 主程式寫入、中斷讀出(接收緩衝區則相反)，不需要關閉中斷。
+ */
+typedef struct {
+    volatile uint8_t* Udr_p;   ///< UART 資料暫存器指標。
+    uint8_t TxFb_Id;           ///< 傳送中斷中功能方塊名單編號。
+    uint8_t RxFb_Id;           ///< 接收中斷中功能方塊名單編號。
+
+    RingBufStr_t TxBuf;        ///< 傳送環狀緩衝區。
+    RingBufStr_t RxBuf;        ///< 無工作時收到的位元組。
+    uint8_t TxData[UARTSTREAM_TX_SZ];
+    uint8_t RxData[UARTSTREAM_RX_SZ];
+
+    volatile uint8_t TxBusy;   ///< 目前有工作佔用通訊線。
+    volatile uint8_t TxLeft;   ///< 目前工作尚未送出的位元組數。
+    uint8_t RxState;           ///< 回應解包狀態。
+    uint8_t RxCount;           ///< 已接收資料位元組數。
+    uint8_t RxSum;             ///< 接收資料 checksum。
+    uint8_t RxStage[UARTSTREAM_REC_SZ];  ///< checksum 檢查前的接收資料。
+
+    uint16_t Timeout;          ///< 每筆工作的逾時計數，0 為不逾時。
+    volatile uint16_t TimeLeft;  ///< 目前工作剩餘的逾時計數。
+
+    volatile uint8_t JobHead;  ///< 已排入工作計數，亦為下一個傳輸編號。
+    volatile uint8_t JobTail;  ///< 已完成工作計數。
+    UartStreamJob_t Job[UARTSTREAM_MAX_JOB];
+} UartStreamStr_t;
+
+/**
+ * @brief 初始化 UartStream 並註冊至 UART 中斷。
+ *
+ * @ingroup uartstream_func
+ * @param Str_p        UartStream 管理結構指標。
+ * @param UartIntStr_p 已完成 UartInt_net 的 UART 中斷結構指標。
+ * @param Num          UART 硬體編號，0 或 1。
+ * @param Timeout      每筆工作的逾時計數，以 UartStream_tick 的呼叫次數計，
+ *                     由開始送出封包起算，0 為不逾時。
+ * @return uint8_t 錯誤代碼：
+ *   - 0：成功無誤。
+ *   - 1：參數 Num 錯誤。
+ *   - 2：UARTSTREAM_TX_SZ、UARTSTREAM_RX_SZ 設定錯誤。
+ *
+ * 會以 UartTxInt_reg、UartRxInt_reg 註冊 UartStream_txStep、
+ * UartStream_rxStep 並啟用。使用前須在 UartSet 中開啟 TxIntEn、RxIntEn。
+ * 需要逾時偵測時，另將 UartStream_tick 註冊到計時中斷或 IntFreqDiv 中。
+ */
+uint8_t UartStream_net(UartStreamStr_t* Str_p, UartIntStr_t* UartIntStr_p,
+                       uint8_t Num, uint16_t Timeout);
+
+/**
+ * @brief 非阻塞 Mode 0 多位元組傳送。
+ *
+ * @ingroup uartstream_func
+ * @param Str_p      UartStream 管理結構指標。
+ * @param UartID     目標裝置的 UART ID。
+ * @param RegAdd     遠端讀寫暫存器位址，0~0x7E，0x7F 保留為批次標記。
+ * @param Bytes      待送資料位元組數。
+ * @param Data_p     待送資料指標，呼叫返回後即可重複使用。
+ * @param Func_p     完成時執行函式，於中斷中執行，可為 NULL。
+ * @param FuncPara_p 完成時執行函式之傳參。
+ * @param Handle_p   回傳傳輸編號。
+ * @return uint8_t 錯誤代碼：
+ *   - 0：成功無誤。
+ *   - 2：工作佇列已滿。
+ *   - 3：傳送緩衝區空間不足。
+ *   - 4：參數 RegAdd 超過 0x7E。
+ *
+ * 封包格式與 UARTM_trm Mode 0 相同：[0xAA]、[UID]、[RegAdd]、由低到高的
+ * [Data]、[checksum]，checksum 為 UID、RegAdd 及資料的 8 位元總和。
+ * 待 Slave 回傳 ASAUART_RSP_HEADER 後才會開始下一筆工作。
+ */
+uint8_t UartStream_trm(UartStreamStr_t* Str_p, uint8_t UartID, uint8_t RegAdd,
+                       uint8_t Bytes, void* Data_p, Func_t Func_p,
+                       void* FuncPara_p, uint8_t* Handle_p);
+
+/**
+ * @brief 非阻塞 Mode 0 多位元組接收。
+ *
+ * @ingroup uartstream_func
+ * @param Data_p 待收資料指標，完成前不可釋放。
+ *
+ * 其餘參數與回傳值同 UartStream_trm，Bytes 超過 UARTSTREAM_REC_SZ 時亦
+ * 回傳 4。封包格式與 UARTM_rec Mode 0 相同：送出 [0xAA]、[UID]、
+ * [0x80 | RegAdd]、[checksum]，checksum 為 UID 與 0x80 | RegAdd 的總和；
+ * 於中斷中接收 [0xAB]、[Data]、[checksum]。資料先暫存於 RxStage，
+ * checksum 正確才寫入 Data_p，錯誤時結果為 UARTSTREAM_RES_CHKSUM，
+ * Data_p 內容不變。
+ */
+uint8_t UartStream_rec(UartStreamStr_t* Str_p, uint8_t UartID, uint8_t RegAdd,
+                       uint8_t Bytes, void* Data_p, Func_t Func_p,
+                       void* FuncPara_p, uint8_t* Handle_p);
+
+/**
+ * @brief 非阻塞 Mode 0 批次寫入多個暫存器。
+ *
+ * @ingroup uartstream_func
+ * @param Str_p      UartStream 管理結構指標。
+ * @param UartID     目標裝置的 UART ID。
+ * @param List_p     暫存器列表，呼叫返回後即可重複使用。
+ * @param Num        列表項數。
+ * @param Data_p     依列表順序連續存放的待送資料，呼叫返回後即可重複使用。
+ * @param Func_p     完成時執行函式，於中斷中執行，可為 NULL。
+ * @param FuncPara_p 完成時執行函式之傳參。
+ * @param Handle_p   回傳傳輸編號。
+ * @return uint8_t 錯誤代碼：
+ *   - 0：成功無誤。
+ *   - 2：工作佇列已滿。
+ *   - 3：傳送緩衝區空間不足。
+ *   - 4：參數 Num 為0，或資料合計、封包長度超過 255 位元組；批次讀取時
+ *        資料合計超過 UARTSTREAM_REC_SZ。
+ *
+ * 封包為 [0xAA]、[UID]、[UARTSTREAM_BULK_W]、[Num]、Num 組 [RegAdd][Bytes]、
+ * 所有資料、[checksum]，一次 checksum 與一次回應取代 Num 次單一暫存器
+ * 傳輸。Slave 端由 RemoSlave UART Mode 0 處理。
+ */
+uint8_t UartStream_bulkTrm(UartStreamStr_t* Str_p, uint8_t UartID,
+                           const UartStreamBulkStr_t* List_p, uint8_t Num,
+                           void* Data_p, Func_t Func_p, void* FuncPara_p,
+                           uint8_t* Handle_p);
+
+/**
+ * @brief 非阻塞 Mode 0 批次讀取多個暫存器。
+ *
+ * @ingroup uartstream_func
+ * @param Data_p 依列表順序連續存放接收資料，完成前不可釋放。
+ *
+ * 其餘參數與回傳值同 UartStream_bulkTrm。命令以 UARTSTREAM_BULK_R 送出
+ * 列表，回應為 [0xAB]、所有資料、[checksum]，同 UartStream_rec 在
+ * checksum 正確後才寫入 Data_p。
+ */
+uint8_t UartStream_bulkRec(UartStreamStr_t* Str_p, uint8_t UartID,
+                           const UartStreamBulkStr_t* List_p, uint8_t Num,
+                           void* Data_p, Func_t Func_p, void* FuncPara_p,
+                           uint8_t* Handle_p);
+
+/**
+ * @brief 查詢傳輸是否完成。
+ *
+ * @ingroup uartstream_func
+ * @return uint8_t 1：已完成，0：尚在佇列中。
+ */
+uint8_t UartStream_isDone(UartStreamStr_t* Str_p, uint8_t Handle);
+
+/**
+ * @brief 取得傳輸結果。
+ *
+ * @ingroup uartstream_func
+ * @return uint8_t UARTSTREAM_RES_* 結果代碼，尚未完成時為
+ * UARTSTREAM_RES_PENDING。結果保留至該編號的工作欄位被重新使用為止。
+ */
+uint8_t UartStream_getResult(UartStreamStr_t* Str_p, uint8_t Handle);
+
+/**
+ * @brief 讀取沒有傳輸工作時收到的位元組。
+ *
+ * @ingroup uartstream_func
+ * @return uint8_t 錯誤代碼：
+ *   - 0：成功無誤。
+ *   - 1：沒有資料。
+ */
+uint8_t UartStream_read(UartStreamStr_t* Str_p, uint8_t* Data_p);
+
+/**
+ * @brief 逾時計數執行片段，可註冊到計時中斷或 IntFreqDiv 中。
+ *
+ * @ingroup uartstream_func
+ *
+ * 目前工作的逾時計數歸零時丟棄其未送出的位元組，以
+ * UARTSTREAM_RES_TIMEOUT 結束該工作並開始下一筆。
+ */
+void UartStream_tick(void* Str_p);
+
+/**
+ * @brief 傳送完成中斷執行片段，由 UartStream_net 註冊。
+ * @ingroup uartstream_func
+ */
+void UartStream_txStep(void* Str_p);
+
+/**
+ * @brief 接收完成中斷執行片段，由 UartStream_net 註冊。
+ * @ingroup uartstream_func
+ */
+void UartStream_rxStep(void* Str_p);
+
+#endif  // UART_STREAM_H
@@ -0,0 +1,346 @@
+/**
+ * @file bench_api.c
+ * @brief 各模組公開函式的每次呼叫計數。
+ *
+ * 每一項重複執行後取最小值，輸出 [函式] [計數] [單位]。中斷執行片段
+ * 以穩定狀態量測，例如 UartStream_txStep 為傳送中的一個位元組。
+ *
+ * 每次呼叫都會推進狀態機的執行片段無法單獨重複執行，改以一個完整封包
+ * 量測，名稱中註明封包內容：
+ *   - RemoSlave 的 UART、SPI、TWI 為寫入 2 位元組暫存器的命令封包，
+ *     包含全部的接收與回應執行片段。
+ *   - UartPipe 為一筆寫入的來回，包含兩端的傳送與接收執行片段。
+ * IsrProf_step 為包住空函式的量測負擔，本程式另以 ISRPROF_EN=1 編譯
+ * isr_prof.c。
+ */
+
+#include <stdio.h>
+
+#include "adc_filt.h"
+#include "adc_scan.h"
+#include "defer.h"
+#include "ee_queue.h"
+#include "host_bench.h"
+#include "host_model.h"
+#include "intfreqwheel.h"
+#include "isr_prof.h"
+#include "remo_slave.h"
+#include "ringbuf.h"
+#include "rt_capture.h"
+#include "rt_count32.h"
+#include "rt_flag_group.h"
+#include "rt_pattern.h"
+#include "spi_stream.h"
+#include "twi_async.h"
+#include "uart_pipe.h"
+#include "uart_stream.h"
+
+#define REPEAT 2000
+
+static RingBufStr_t Ring;
+static uint8_t RingData[64];
+static DeferStr_t Defer;
+static AdcFiltStr_t Filt = ADC0_FILT_STR_INI;
+static uint16_t FiltBuf[8];
+static EeQueueStr_t EeQueue;
+static IntFreqWheelStr_t Wheel;
+static RtUpCount32Str_t Count;
+static RealTimePortStr_t Port;
+static RtPatternStr_t Pattern;
+static UartStreamStr_t Stream;
+static UartIntStr_t UartInt;
+static TwiAsyncStr_t Twi;
+static TwiIntStr_t TwiInt;
+static uint8_t TwiData[255];
+static RemoSlaveRegStr_t Regs[4];
+static uint8_t Reg2[2];
+static RemoSlaveStr_t UartSlave, SpiSlave, TwiSlave;
+static SpiStreamStr_t Spi;
+static uint8_t SpiBuf[2][64];
+static AdcScanStr_t Scan;
+static AdcScanChStr_t ScanCh[4];
+static uint16_t ScanBuf[4][8];
+static RealTimePortStr_t CapPort;
+static RtCaptureStr_t Capture;
+static uint8_t CapBuf[64];
+static RtFlagGroupStr_t Group;
+static RealTimeFlagStr_t Flag[10];
+static UartPipeStr_t Pipe;
+static UartPipeSStr_t PipeS;
+static UartIntStr_t PipeInt, PipeSInt;
+static UartPipeRegStr_t PipeRegs[1];
+static uint8_t PipeReg[1];
+static IsrProfFbStr_t ProfFb;
+
+static void nop(void* Para_p) {
+}
+
+static void ringPutGet(void* Para_p) {
+    uint8_t data;
+
+    RingBuf_put(&Ring, 0x55);
+    RingBuf_get(&Ring, &data);
+}
+
+static void deferPostRun(void* Para_p) {
+    Defer_post(&Defer, 0, nop, NULL);
+    Defer_run(&Defer);
+}
+
+static void adcFiltStep(void* Para_p) {
+    uint16_t data;
+
+    ADCW = 0x200;
+    AdcFilt_step(&Filt);
+    AdcFilt_get(&Filt, &data);
+}
+
+static void eeQueueGet(void* Para_p) {
+    uint8_t data[8];
+
+    EeQueue_get(&EeQueue, 0x100, 8, data);
+}
+
+static void wheelStep(void* Para_p) {
+    IntFreqWheel_step(&Wheel);
+}
+
+static void count32Step(void* Para_p) {
+    RtUpCount32_step(&Count);
+}
+
+static void count32Get(void* Para_p) {
+    volatile uint32_t count = RtUpCount32_get(&Count);
+    (void)count;
+}
+
+static void patternStep(void* Para_p) {
+    RtPattern_step(&Pattern);
+}
+
+/* 一筆 1 位元組的 Mode 0 寫入，含 Slave 回應 */
+static void streamTrm(void* Para_p) {
+    uint8_t data = 0x12;
+    uint8_t handle;
+
+    UartStream_trm(&Stream, 1, 2, 1, &data, NULL, NULL, &handle);
+    while (Stream.TxLeft) {
+        UartTx_step(&UartInt);
+    }
+    UDR0 = ASAUART_RSP_HEADER;
+    UartRx_step(&UartInt);
+}
+
+static void streamTxStep(void* Para_p) {
+    Stream.TxLeft = 2;
+    RingBuf_put(&Stream.TxBuf, 0);
+    UartStream_txStep(&Stream);
+    Stream.TxLeft = 0;
+}
+
+/* 寫入中的一個資料位元組被 ACK */
+static void twiStep(void* Para_p) {
+    Twi.Index = 1;
+    TWSR      = 0x28;
+    TwiAsync_step(&Twi);
+}
+
+/* [0xAA][UID][RegAdd][Data x2][checksum] 與回應 */
+static void remoUart(void* Para_p) {
+    static const uint8_t cmd[6] = {0xAA, 1, 2, 0x12, 0x34, 1 + 2 + 0x12 + 0x34};
+
+    for (uint8_t i = 0; i < sizeof(cmd); i++) {
+        UDR1 = cmd[i];
+        RemoSlave_uartRxStep(&UartSlave);
+    }
+    while (UartSlave.TxActive) {
+        RemoSlave_uartTxStep(&UartSlave);
+    }
+}
+
+/* mode 5：CS 拉低後 [RegAdd][Data x2] */
+static void remoSpi(void* Para_p) {
+    static const uint8_t cmd[3] = {2, 0x12, 0x34};
+
+    RemoSlave_csStep(&SpiSlave);
+    for (uint8_t i = 0; i < sizeof(cmd); i++) {
+        SPDR = cmd[i];
+        RemoSlave_spiStep(&SpiSlave);
+    }
+}
+
+/* mode 6：SLA+W、[RegAdd][Data x2]、STOP */
+static void remoTwi(void* Para_p) {
+    static const uint8_t cmd[3] = {2, 0x12, 0x34};
+
+    TWSR = 0x60;
+    RemoSlave_twiStep(&TwiSlave);
+    TWSR = 0x80;
+    for (uint8_t i = 0; i < sizeof(cmd); i++) {
+        TWDR = cmd[i];
+        RemoSlave_twiStep(&TwiSlave);
+    }
+    TWSR = 0xA0;
+    RemoSlave_twiStep(&TwiSlave);
+}
+
+/* 緩衝區填滿時立即釋放，量測一般的位元組路徑 */
+static void spiStreamStep(void* Para_p) {
+    uint8_t full;
+
+    SpiStream_step(&Spi);
+    full = SpiStream_getFull(&Spi);
+    if (full != SPISTREAM_NONE) {
+        SpiStream_release(&Spi, full);
+    }
+}
+
+/* 連續轉換，取出結果使緩衝區不會滿 */
+static void adcScanStep(void* Para_p) {
+    AdcScanChStr_t* ch_p = &ScanCh[Scan.Cur];
+
+    AdcScan_step(&Scan);
+    ch_p->Tail = ch_p->Head;
+}
+
+static void captureStep(void* Para_p) {
+    RtCapture_step(&Capture);
+}
+
+static void groupInStep(void* Para_p) {
+    RtFlagGroupIn_step(&Group);
+}
+
+static void groupOutStep(void* Para_p) {
+    RtFlagGroupOut_step(&Group);
+}
+
+/* 一筆 1 位元組寫入，Master 與 Slave 直接相接 */
+static void pipeTrm(void* Para_p) {
+    uint8_t data = 0x12;
+    uint8_t handle;
+
+    UartPipe_trm(&Pipe, 1, 0, 1, &data, NULL, NULL, &handle);
+    while (Pipe.TxActive) {
+        UDR1 = UDR0;
+        UartPipeS_rxStep(&PipeS);
+        UartPipe_txStep(&Pipe);
+    }
+    while (PipeS.TxActive) {
+        UDR0 = UDR1;
+        UartPipe_rxStep(&Pipe);
+        UartPipeS_txStep(&PipeS);
+    }
+}
+
+static void profStep(void* Para_p) {
+    IsrProf_step(&ProfFb);
+}
+
+static void report(const char* Name_p, HostBenchFunc_t Func_p) {
+    printf("%-30s %6llu %s\n", Name_p,
+           (unsigned long long)HostBench_min(Func_p, NULL, REPEAT),
+           HostBench_unit());
+}
+
+int main(void) {
+    static const uint8_t table[4] = {1, 2, 4, 8};
+    RealTimeFlagStr_t* flags[10];
+    uint8_t handle;
+
+    Host_reset();
+    HostBench_open();
+
+    RingBuf_net(&Ring, RingData, sizeof(RingData));
+    Defer_net(&Defer);
+    AdcFilt_net(&Filt, FiltBuf, 8);
+    EeQueue_net(&EeQueue);
+
+    IntFreqWheel_net(&Wheel);
+    for (uint8_t i = 0; i < 20; i++) {
+        IntFreqWheel_en(&Wheel,
+                        IntFreqWheel_reg(&Wheel, nop, NULL, 10 + i, i), 1);
+    }
+
+    RtUpCount32_net(&Count, 0);
+
+    Port.Reg_p = &PORTA;
+    Port.Bytes = 1;
+    RtPattern_net(&Pattern, &Port, NULL, NULL);
+    RtPattern_start(&Pattern, table, NULL, 4, RTPATTERN_F_LOOP);
+
+    UartStream_net(&Stream, &UartInt, 0, 0);
+
+    TwiAsync_net(&Twi, &TwiInt, 0);
+    TwiAsync_trm(&Twi, 4, 0x20, 0, sizeof(TwiData), TwiData, NULL, NULL,
+                 &handle);
+    TWSR = 0x08;
+    TwiAsync_step(&Twi);
+
+    Regs[2].Data_p = Reg2;
+    Regs[2].Bytes  = sizeof(Reg2);
+    RemoSlave_net(&UartSlave, SERIAL_TYPE_UART, 1, 0, 1, Regs, 4);
+    RemoSlave_net(&SpiSlave, SERIAL_TYPE_SPI, 0, 5, 0, Regs, 4);
+    RemoSlave_setDir(&SpiSlave, REMOSLAVE_W);
+    RemoSlave_net(&TwiSlave, SERIAL_TYPE_TWI, 0, 6, 0, Regs, 4);
+
+    SpiStream_net(&Spi, SpiBuf[0], SpiBuf[1], sizeof(SpiBuf[0]));
+    SpiStream_start(&Spi);
+
+    for (uint8_t i = 0; i < 4; i++) {
+        AdcScan_chnet(&ScanCh[i], ADC_CHANNEL_0 + i, ScanBuf[i], 8);
+    }
+    AdcScan_net(&Scan, ScanCh, 4, ADC_CONVMODE_SUCCESIVELY);
+    AdcScan_start(&Scan);
+
+    /* 邊緣觸發但輸入不變，持續記錄觸發前資料 */
+    CapPort.Reg_p = &PINB;
+    CapPort.Bytes = 1;
+    RtCapture_net(&Capture, &CapPort, CapBuf, sizeof(CapBuf), 0);
+    RtCapture_arm(&Capture, RTCAPTURE_TRIG_EDGE, 0x01, 0x01,
+                  sizeof(CapBuf) - 1, 0);
+
+    /* 與 test_rt_flag_group 相同：PORTA 8 個 1 位元旗標，PORTC 2 個欄位 */
+    for (uint8_t i = 0; i < 8; i++) {
+        Flag[i].Reg_p = &PORTA;
+        Flag[i].Mask  = 1 << i;
+        Flag[i].Shift = i;
+        flags[i]      = &Flag[i];
+    }
+    Flag[8]  = (RealTimeFlagStr_t){.Reg_p = &PORTC, .Mask = 0xF0, .Shift = 4};
+    Flag[9]  = (RealTimeFlagStr_t){.Reg_p = &PORTC, .Mask = 0x0E, .Shift = 1};
+    flags[8] = &Flag[8];
+    flags[9] = &Flag[9];
+    RtFlagGroup_net(&Group, flags, 10);
+
+    UartPipe_net(&Pipe, &PipeInt, 0, 1, 0);
+    PipeRegs[0].Data_p = PipeReg;
+    PipeRegs[0].Bytes  = sizeof(PipeReg);
+    UartPipeS_net(&PipeS, &PipeSInt, 1, 1, PipeRegs, 1);
+
+    IsrProf_init();
+    IsrProf_link(&ProfFb, nop, NULL, 0);
+
+    report("RingBuf_put + RingBuf_get", ringPutGet);
+    report("Defer_post + Defer_run", deferPostRun);
+    report("AdcFilt_step + AdcFilt_get", adcFiltStep);
+    report("EeQueue_get (8 bytes)", eeQueueGet);
+    report("IntFreqWheel_step (20 jobs)", wheelStep);
+    report("RtUpCount32_step", count32Step);
+    report("RtUpCount32_get", count32Get);
+    report("RtPattern_step", patternStep);
+    report("UartStream_txStep", streamTxStep);
+    report("UartStream_trm round trip", streamTrm);
+    report("TwiAsync_step (data byte)", twiStep);
+    report("RemoSlave UART write packet", remoUart);
+    report("RemoSlave SPI write packet", remoSpi);
+    report("RemoSlave TWI write packet", remoTwi);
+    report("SpiStream_step", spiStreamStep);
+    report("AdcScan_step (4 channels)", adcScanStep);
+    report("RtCapture_step (armed)", captureStep);
+    report("RtFlagGroupIn_step (10 flags)", groupInStep);
+    report("RtFlagGroupOut_step (10 flags)", groupOutStep);
+    report("UartPipe_trm round trip", pipeTrm);
+    report("IsrProf_step (nop)", profStep);
+    return 0;
+}
@@ -0,0 +1,119 @@
+/**
+ * @file bench_asaspi_bulk.c
+ * @brief 讀取 1~20 個遠端暫存器時，ASA_SPIM_recb 批次與逐一讀取的比較。
+ *
+ * Master 與 RemoSlave SPI mode 7 以迴路連接，每個暫存器 2 位元組。逐一
+ * 讀取時每個暫存器一次 ASA_SPIM_recv，批次讀取時每 REMOSLAVE_BULK_MAX 個
+ * 暫存器一次 ASA_SPIM_recb。輸出通訊線上的位元組數、以 1 Mbps SPI 加上
+ * 每次片選 20us 換算的每秒暫存器數，以及主機上含 Slave 模型的每次計數。
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "asaspi_vec.h"
+#include "host_bench.h"
+#include "host_model.h"
+#include "remo_slave.h"
+
+#define MODE      7
+#define REG_NUM   20
+#define REG_BYTES 2
+#define BYTE_US   8   ///< 1 Mbps 時每位元組 8us
+#define CS_US     20  ///< 每次片選的額外時間
+
+static RemoSlaveStr_t Slave;
+static SpiIntStr_t SpiInt;
+static RemoSlaveRegStr_t Regs[REG_NUM];
+static uint8_t RegData[REG_NUM][REG_BYTES];
+static SpimBulkStr_t List[REG_NUM];
+static uint8_t Back[REG_NUM * REG_BYTES];
+static uint32_t Swaps;
+static uint8_t Num;
+
+static uint8_t swap(uint8_t Data) {
+    uint8_t out = SPDR;
+
+    SPDR = Data;
+    SpiInt_step(&SpiInt);
+    Swaps++;
+    return out;
+}
+
+/* 回傳片選次數 */
+static uint8_t readSingle(void) {
+    for (uint8_t i = 0; i < Num; i++) {
+        SpimVecStr_t vec = {&Back[i * REG_BYTES], REG_BYTES, SPIMV_LOWFIRST};
+
+        ASA_SPIM_recv(MODE, 1, i, 1, &vec, 0);
+    }
+    return Num;
+}
+
+static uint8_t readBulk(void) {
+    uint8_t cs = 0;
+
+    for (uint8_t i = 0; i < Num; i += REMOSLAVE_BULK_MAX) {
+        uint8_t n = Num - i;
+
+        if (n > REMOSLAVE_BULK_MAX) {
+            n = REMOSLAVE_BULK_MAX;
+        }
+        ASA_SPIM_recb(MODE, 1, n, &List[i], &Back[i * REG_BYTES], 0);
+        cs++;
+    }
+    return cs;
+}
+
+static void benchSingle(void* Para_p) {
+    readSingle();
+}
+
+static void benchBulk(void* Para_p) {
+    readBulk();
+}
+
+static void report(const char* Name_p, uint8_t (*Read_p)(void),
+                   HostBenchFunc_t Bench_p) {
+    uint32_t bytes;
+    uint32_t us;
+    uint8_t cs;
+
+    memset(Back, 0, sizeof(Back));
+    Swaps = 0;
+    cs    = Read_p();
+    bytes = Swaps;
+    if (memcmp(Back, RegData, Num * REG_BYTES) != 0) {
+        printf("%s: data mismatch\n", Name_p);
+    }
+    us = bytes * BYTE_US + cs * CS_US;
+    printf("  %-6s %3lu bytes %6lu reg/s %6llu %s", Name_p,
+           (unsigned long)bytes, (unsigned long)(Num * 1000000UL / us),
+           (unsigned long long)HostBench_min(Bench_p, NULL, 200),
+           HostBench_unit());
+}
+
+int main(void) {
+    Host_reset();
+    HostBench_open();
+
+    for (uint8_t i = 0; i < REG_NUM; i++) {
+        RegData[i][0]   = i;
+        RegData[i][1]   = 0x80 | i;
+        Regs[i].Data_p  = RegData[i];
+        Regs[i].Bytes   = REG_BYTES;
+        List[i].RegAdd  = i;
+        List[i].Bytes   = REG_BYTES;
+    }
+    RemoSlave_net(&Slave, SERIAL_TYPE_SPI, 0, MODE, 0, Regs, REG_NUM);
+    RemoSlave_spiReg(&Slave, &SpiInt);
+    HostSpi_swap_p = swap;
+
+    for (Num = 1; Num <= REG_NUM; Num++) {
+        printf("%2u regs", Num);
+        report("single", readSingle, benchSingle);
+        report("bulk", readBulk, benchBulk);
+        printf("\n");
+    }
+    return 0;
+}
@@ -0,0 +1,96 @@
+/**
+ * @file bench_defer.c
+ * @brief IFD 工作在中斷中直接執行與經由 Defer_post 延後執行的中斷時間。
+ *
+ * EXT 中斷在計時中斷執行期間無法進入，其最差延遲即為計時中斷本體的
+ * 時間。計時中斷依 IntFreqDiv_step 的方式走訪 IntFreqDivISR_t 並觸發
+ * 一項工作：直接執行時工作在中斷中完成；延後執行時註冊 Defer_step，
+ * 中斷只放入事件，工作由主迴圈的 Defer_run 執行。工作為 64 位元組的
+ * CRC-8，代表紀錄或濾波等較長的處理。
+ */
+
+#include <stdio.h>
+
+#include "defer.h"
+#include "host_bench.h"
+#include "host_model.h"
+
+#define DATA_SZ 64
+
+static DeferStr_t Defer;
+static DeferFbStr_t JobDefer;
+static IntFreqDivISR_t Ifd;
+static uint8_t Data[DATA_SZ];
+static volatile uint8_t Crc;
+
+static void job(void* Para_p) {
+    uint8_t crc = 0;
+
+    for (uint8_t i = 0; i < DATA_SZ; i++) {
+        crc ^= Data[i];
+        for (uint8_t b = 0; b < 8; b++) {
+            crc = (crc & 0x80) ? (uint8_t)(crc << 1) ^ 0x07 : crc << 1;
+        }
+    }
+    Crc = crc;
+}
+
+/* 每次計數都觸發的 IFD 計時中斷 */
+static void timerIsr(void* Para_p) {
+    if (Ifd.enable) {
+        if (++Ifd.counter == Ifd.cycle) {
+            Ifd.counter = 0;
+        }
+        if (Ifd.counter == Ifd.phase) {
+            Ifd.func_p(Ifd.funcPara_p);
+        }
+    }
+}
+
+/* 只量測中斷本體，丟棄事件使佇列不會滿，多出一次讀寫 */
+static void deferIsrOnly(void* Para_p) {
+    timerIsr(NULL);
+    Defer.Queue[1].Tail = Defer.Queue[1].Head;
+}
+
+/* 中斷加上主迴圈取出並執行事件 */
+static void mainLoop(void* Para_p) {
+    timerIsr(NULL);
+    Defer_run(&Defer);
+}
+
+static void setIfd(Func_t Func_p, void* FuncPara_p) {
+    Ifd.func_p     = Func_p;
+    Ifd.funcPara_p = FuncPara_p;
+    Ifd.cycle      = 1;
+    Ifd.phase      = 0;
+    Ifd.counter    = 0;
+    Ifd.enable     = 1;
+}
+
+int main(void) {
+    uint64_t inlineIsr;
+    uint64_t deferIsr;
+    uint64_t total;
+
+    Host_reset();
+    HostBench_open();
+    for (uint8_t i = 0; i < DATA_SZ; i++) {
+        Data[i] = i * 37;
+    }
+    Defer_net(&Defer);
+
+    setIfd(job, NULL);
+    inlineIsr = HostBench_min(timerIsr, NULL, 500);
+
+    setIfd(Defer_step, Defer_link(&JobDefer, &Defer, job, NULL, 1));
+    deferIsr = HostBench_min(deferIsrOnly, NULL, 500);
+    total    = HostBench_min(mainLoop, NULL, 500);
+
+    printf("worst EXT latency = timer ISR body (%s)\n", HostBench_unit());
+    printf("  inline  %6llu\n", (unsigned long long)inlineIsr);
+    printf("  defer   %6llu  (ISR + Defer_run in main loop %llu)\n",
+           (unsigned long long)deferIsr, (unsigned long long)total);
+    printf("  lost    %u\n", Defer.Queue[1].Lost);
+    return 0;
+}
@@ -0,0 +1,87 @@
+/**
+ * @file bench_ee_param.c
+ * @brief EeParam_net 開機重建索引的 EEPROM 讀取數與每次計數。
+ *
+ * 分別以空的 bank、寫滿 1 位元組紀錄的 bank、寫滿 EEPARAM_MAX_LEN
+ * 位元組紀錄的 bank 開機，輸出 EeQueue_get 讀出的位元組數與上限
+ * 4 + EEPARAM_BANK_SZ，以及主機上每次開機的計數。讀取數超過上限時
+ * 回傳 1。
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "ee_param.h"
+#include "host_bench.h"
+#include "host_model.h"
+
+#define BOUND (4 + EEPARAM_BANK_SZ)
+
+static EeQueueStr_t Queue;
+static EeParamStr_t Param;
+
+static void drain(void) {
+    while (!EeQueue_isIdle(&Queue)) {
+        if (HostEe_tick()) {
+            EeQueue_step(&Queue);
+        }
+    }
+}
+
+static uint8_t boot(void) {
+    EeQueue_net(&Queue);
+    return EeParam_net(&Param, &Queue);
+}
+
+static void benchBoot(void* Para_p) {
+    boot();
+}
+
+/* 以 Bytes 位元組的紀錄寫到下一筆就會觸發壓縮為止 */
+static void fill(uint8_t Bytes) {
+    uint16_t end = EEPARAM_BASE + EEPARAM_BANK_SZ;
+    uint8_t data[EEPARAM_MAX_LEN];
+    uint8_t n = 0;
+
+    memset(data, 0, sizeof(data));
+    while (Param.Tail + Bytes + 3 < end) {
+        data[0] = n;
+        EeParam_set(&Param, n++ % EEPARAM_KEY_NUM, data, Bytes, NULL, NULL);
+        drain();
+    }
+}
+
+static uint8_t report(const char* Name_p) {
+    uint32_t reads;
+
+    HostEe_reads = 0;
+    boot();
+    reads = HostEe_reads;
+    printf("  %-8s tail %4u  %4lu / %u reads  %6llu %s\n", Name_p,
+           Param.Tail - EEPARAM_BASE, (unsigned long)reads, BOUND,
+           (unsigned long long)HostBench_min(benchBoot, NULL, 200),
+           HostBench_unit());
+    return reads > BOUND;
+}
+
+int main(void) {
+    uint8_t over = 0;
+
+    Host_reset();
+    HostBench_open();
+    printf("EeParam_net, bank %u bytes\n", EEPARAM_BANK_SZ);
+
+    boot();
+    drain();
+    over |= report("empty");
+
+    fill(1);
+    over |= report("1 B");
+
+    Host_reset();
+    boot();
+    drain();
+    fill(EEPARAM_MAX_LEN);
+    over |= report("max");
+    return over;
+}
@@ -0,0 +1,140 @@
+/**
+ * @file bench_intfreqwheel.c
+ * @brief IntFreqWheel_step 與逐項走訪的 IFD 在 5、20、100 項工作時的最差計數。
+ *
+ * 逐項走訪的參考模型 linearStep 依 IntFreqDiv_step 的方式每次計數走訪
+ * 全部工作。兩者以相同的週期與相位註冊工作，連續執行 TICKS 次計數並
+ * 重複 REPEAT 次，每次計數取各次重複中的最小值以去除雜訊，再取所有
+ * 計數中的最大值作為最差中斷時間，同時輸出平均值。
+ */
+
+#include <stdio.h>
+
+#include "host_bench.h"
+#include "host_model.h"
+#include "intfreqwheel.h"
+
+#define JOB_MAX 100
+#define TICKS   1000
+#define REPEAT  50
+
+#if MAX_IFDW_FUNCNUM < JOB_MAX
+#    error "bench_intfreqwheel needs MAX_IFDW_FUNCNUM >= 100"
+#endif
+
+typedef struct {
+    uint8_t total;
+    IntFreqDivISR_t fb[JOB_MAX];
+} LinearStr_t;
+
+static IntFreqWheelStr_t Wheel;
+static LinearStr_t Linear;
+static uint64_t TickMin[TICKS];
+
+static void nop(void* Para_p) {
+}
+
+/* 第 k 次計數在 k % cycle == phase 時觸發 */
+static void linearStep(void* Para_p) {
+    LinearStr_t* str_p = (LinearStr_t*)Para_p;
+
+    for (uint8_t i = 0; i < str_p->total; i++) {
+        IntFreqDivISR_t* fb_p = &str_p->fb[i];
+
+        if (!fb_p->enable) {
+            continue;
+        }
+        if (++fb_p->counter == fb_p->cycle) {
+            fb_p->counter = 0;
+        }
+        if (fb_p->counter == fb_p->phase) {
+            fb_p->func_p(fb_p->funcPara_p);
+        }
+    }
+}
+
+static void wheelStep(void* Para_p) {
+    IntFreqWheel_step((IntFreqWheelStr_t*)Para_p);
+}
+
+/* 週期 2~64 與 100~900 混合，相位分散 */
+static void setup(uint8_t Num) {
+    IntFreqWheel_net(&Wheel);
+    Linear.total = Num;
+    for (uint8_t i = 0; i < Num; i++) {
+        uint16_t cycle = (i % 4 == 3) ? 100 * (i % 9 + 1) : 2 + (i * 7) % 63;
+        uint16_t phase = (i * 13) % cycle;
+
+        IntFreqWheel_en(&Wheel, IntFreqWheel_reg(&Wheel, nop, NULL, cycle,
+                                                 phase), 1);
+        Linear.fb[i].cycle      = cycle;
+        Linear.fb[i].phase      = phase;
+        Linear.fb[i].counter    = 0;
+        Linear.fb[i].enable     = 1;
+        Linear.fb[i].func_p     = nop;
+        Linear.fb[i].funcPara_p = NULL;
+    }
+}
+
+static uint64_t overhead(void) {
+    uint64_t min = UINT64_MAX;
+
+    for (uint16_t i = 0; i < 1000; i++) {
+        uint64_t t0 = HostBench_now();
+        uint64_t t1 = HostBench_now();
+
+        if (t1 - t0 < min) {
+            min = t1 - t0;
+        }
+    }
+    return min;
+}
+
+static void measure(const char* Name_p, uint8_t Num, HostBenchFunc_t Func_p,
+                    void* Para_p, uint64_t Overhead) {
+    uint64_t worst = 0;
+    uint64_t sum   = 0;
+
+    for (uint16_t k = 0; k < TICKS; k++) {
+        TickMin[k] = UINT64_MAX;
+    }
+    for (uint8_t r = 0; r < REPEAT; r++) {
+        setup(Num);
+        for (uint16_t k = 0; k < TICKS; k++) {
+            uint64_t t0 = HostBench_now();
+            uint64_t t;
+
+            Func_p(Para_p);
+            t = HostBench_now() - t0;
+            if (t < TickMin[k]) {
+                TickMin[k] = t;
+            }
+        }
+    }
+    for (uint16_t k = 0; k < TICKS; k++) {
+        uint64_t t = (TickMin[k] > Overhead) ? TickMin[k] - Overhead : 0;
+
+        sum += t;
+        if (t > worst) {
+            worst = t;
+        }
+    }
+    printf("%-16s %3u jobs  worst %6llu  mean %6llu %s\n", Name_p, Num,
+           (unsigned long long)worst, (unsigned long long)(sum / TICKS),
+           HostBench_unit());
+}
+
+int main(void) {
+    static const uint8_t num[3] = {5, 20, 100};
+    uint64_t cost;
+
+    Host_reset();
+    HostBench_open();
+    cost = overhead();
+
+    for (uint8_t i = 0; i < 3; i++) {
+        measure("IntFreqDiv_step", num[i], linearStep, &Linear, cost);
+        measure("IntFreqWheel_step", num[i], wheelStep, &Wheel, cost);
+    }
+    return 0;
+}
@@ -0,0 +1,134 @@
+/**
+ * @file bench_uart_bulk.c
+ * @brief 讀取 1~20 個遠端暫存器時，UartStream_bulkRec 批次與逐一讀取的比較。
+ *
+ * UART0 的 UartStream 與 UART1 的 RemoSlave UART Mode 0 以迴路連接，每個
+ * 暫存器 2 位元組。逐一讀取時每個暫存器一個 UartStream_rec 封包，批次讀取
+ * 時每 REMOSLAVE_BULK_MAX 個暫存器一個 UartStream_bulkRec 封包，每個封包
+ * 送完並收到回應後才送下一個。輸出通訊線上命令與回應的位元組數、以
+ * 115200 bps 8N1 換算的每秒暫存器數，以及主機上含 Slave 模型的每次計數。
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "host_bench.h"
+#include "host_model.h"
+#include "remo_slave.h"
+#include "uart_stream.h"
+
+#define SLAVE_ID  7
+#define REG_NUM   20
+#define REG_BYTES 2
+#define BYTE_NS   86806  ///< 115200 bps 8N1 每位元組 10 bit
+
+static UartStreamStr_t Stream;
+static UartIntStr_t MasterInt;
+static RemoSlaveStr_t Slave;
+static UartIntStr_t SlaveInt;
+static RemoSlaveRegStr_t Regs[REG_NUM];
+static uint8_t RegData[REG_NUM][REG_BYTES];
+static UartStreamBulkStr_t List[REG_NUM];
+static uint8_t Back[REG_NUM * REG_BYTES];
+static uint32_t Bytes;
+static uint8_t Num;
+
+static void toSlave(void) {
+    UDR1 = UDR0;
+    Bytes++;
+    UartRx_step(&SlaveInt);
+}
+
+/* 送完目前工作的封包並接收回應 */
+static void wire(void) {
+    toSlave();
+    while (Stream.TxLeft) {
+        UartTx_step(&MasterInt);
+        toSlave();
+    }
+    UartTx_step(&MasterInt);
+    while (Slave.TxActive) {
+        UDR0 = UDR1;
+        Bytes++;
+        UartRx_step(&MasterInt);
+        UartTx_step(&SlaveInt);
+    }
+}
+
+static void readSingle(void) {
+    uint8_t handle;
+
+    for (uint8_t i = 0; i < Num; i++) {
+        UartStream_rec(&Stream, SLAVE_ID, i, REG_BYTES, &Back[i * REG_BYTES],
+                       NULL, NULL, &handle);
+        wire();
+    }
+}
+
+static void readBulk(void) {
+    uint8_t handle;
+
+    for (uint8_t i = 0; i < Num; i += REMOSLAVE_BULK_MAX) {
+        uint8_t n = Num - i;
+
+        if (n > REMOSLAVE_BULK_MAX) {
+            n = REMOSLAVE_BULK_MAX;
+        }
+        UartStream_bulkRec(&Stream, SLAVE_ID, &List[i], n,
+                           &Back[i * REG_BYTES], NULL, NULL, &handle);
+        wire();
+    }
+}
+
+static void benchSingle(void* Para_p) {
+    readSingle();
+}
+
+static void benchBulk(void* Para_p) {
+    readBulk();
+}
+
+static void report(const char* Name_p, void (*Read_p)(void),
+                   HostBenchFunc_t Bench_p) {
+    uint32_t bytes;
+    uint64_t ns;
+
+    memset(Back, 0, sizeof(Back));
+    Bytes = 0;
+    Read_p();
+    bytes = Bytes;
+    if (memcmp(Back, RegData, Num * REG_BYTES) != 0) {
+        printf("%s: data mismatch\n", Name_p);
+    }
+    ns = (uint64_t)bytes * BYTE_NS;
+    printf("  %-6s %3lu bytes %5lu reg/s %6llu %s", Name_p,
+           (unsigned long)bytes,
+           (unsigned long)(Num * 1000000000ULL / ns),
+           (unsigned long long)HostBench_min(Bench_p, NULL, 200),
+           HostBench_unit());
+}
+
+int main(void) {
+    Host_reset();
+    HostBench_open();
+
+    for (uint8_t i = 0; i < REG_NUM; i++) {
+        RegData[i][0]  = i;
+        RegData[i][1]  = 0x80 | i;
+        Regs[i].Data_p = RegData[i];
+        Regs[i].Bytes  = REG_BYTES;
+        List[i].RegAdd = i;
+        List[i].Bytes  = REG_BYTES;
+    }
+    UartStream_net(&Stream, &MasterInt, 0, 5);
+    RemoSlave_net(&Slave, SERIAL_TYPE_UART, 1, 0, SLAVE_ID, Regs, REG_NUM);
+    RemoSlave_uartReg(&Slave, &SlaveInt);
+
+    for (Num = 1; Num <= REG_NUM; Num++) {
+        printf("%2u regs", Num);
+        report("single", readSingle, benchSingle);
+        report("bulk", readBulk, benchBulk);
+        printf("\n");
+    }
+    return 0;
+}
@@ -0,0 +1,69 @@
+/**
+ * @file bench_uart_pipe.c
+ * @brief UartPipe 在不同視窗大小與傳遞延遲下的封包吞吐量。
+ *
+ * 以全雙工連線模型連接 Master 與 Slave，連續送出 PACKETS 筆 4 位元組的
+ * 寫入，以經過的位元組時間換算 115200 bps(每秒 11520 位元組)時的每秒
+ * 封包數。延遲包含傳遞與 Slave 開始處理前的時間，以位元組時間計。
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "host_wire.h"
+#include "uart_pipe.h"
+
+#define SLAVE_ID     3
+#define PACKETS      256
+#define BYTES_PER_S  11520UL
+
+static UartPipeStr_t Pipe;
+static UartIntStr_t MasterInt;
+static UartPipeSStr_t Slave;
+static UartIntStr_t SlaveInt;
+static UartPipeRegStr_t Reg = {NULL, 4};
+static uint8_t RegData[4];
+static HostWireStr_t Wire;
+
+static uint32_t measure(uint8_t Window, uint16_t Latency) {
+    uint8_t data[4] = {1, 2, 3, 4};
+    uint8_t handle  = 0;
+
+    memset(&MasterInt, 0, sizeof(MasterInt));
+    memset(&SlaveInt, 0, sizeof(SlaveInt));
+    Reg.Data_p = RegData;
+    UartPipe_net(&Pipe, &MasterInt, 0, Window, 0);
+    UartPipeS_net(&Slave, &SlaveInt, 1, SLAVE_ID, &Reg, 1);
+    HostWire_net(&Wire, &MasterInt, &Pipe.TxBuf, &SlaveInt, &Slave.TxBuf,
+                 Latency);
+
+    for (uint16_t n = 0; n < PACKETS; n++) {
+        while (UartPipe_trm(&Pipe, SLAVE_ID, 0, 4, data, NULL, NULL,
+                            &handle)) {
+            HostWire_step(&Wire);
+        }
+    }
+    while (!UartPipe_isDone(&Pipe, handle) || !HostWire_isIdle(&Wire)) {
+        HostWire_step(&Wire);
+    }
+    return (uint32_t)(PACKETS * BYTES_PER_S / Wire.Now);
+}
+
+int main(void) {
+    static const uint16_t latency[3] = {1, 8, 32};
+
+    Host_reset();
+    printf("window");
+    for (uint8_t l = 0; l < 3; l++) {
+        printf("  latency %2u", latency[l]);
+    }
+    printf("   (packets/s)\n");
+    for (uint8_t w = 1; w <= UARTPIPE_MAX_JOB; w++) {
+        printf("%6u", w);
+        for (uint8_t l = 0; l < 3; l++) {
+            printf("  %10lu", (unsigned long)measure(w, latency[l]));
+        }
+        printf("\n");
+    }
+    return 0;
+}
@@ -0,0 +1,94 @@
+/**
+ * @file host_bench.c
+ * @brief 主機端的每次呼叫指令數量測實作。
+ */
+
+#include "host_bench.h"
+
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#    include <linux/perf_event.h>
+#    include <sys/syscall.h>
+#endif
+#if defined(__x86_64__) || defined(__i386__)
+#    include <x86intrin.h>
+#endif
+
+/* 每次取樣連續呼叫的次數，降低計數器解析度的影響 */
+#define BATCH 16
+
+static int HostBench_fd = -1;
+static uint64_t HostBench_overhead;
+
+static void HostBench_nop(void* Para_p) {
+    (void)Para_p;
+}
+
+void HostBench_open(void) {
+#ifdef __linux__
+    struct perf_event_attr attr;
+
+    memset(&attr, 0, sizeof(attr));
+    attr.type           = PERF_TYPE_HARDWARE;
+    attr.size           = sizeof(attr);
+    attr.config         = PERF_COUNT_HW_INSTRUCTIONS;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv     = 1;
+    HostBench_fd = (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+#endif
+    HostBench_overhead = 0;
+    HostBench_overhead = HostBench_min(HostBench_nop, NULL, 1000);
+}
+
+const char* HostBench_unit(void) {
+    if (HostBench_fd >= 0) {
+        return "instr";
+    }
+#if defined(__x86_64__) || defined(__i386__)
+    return "cycle";
+#else
+    return "ns";
+#endif
+}
+
+uint64_t HostBench_now(void) {
+    uint64_t count;
+    struct timespec ts;
+
+    if (HostBench_fd >= 0 &&
+        read(HostBench_fd, &count, sizeof(count)) == sizeof(count)) {
+        return count;
+    }
+#if defined(__x86_64__) || defined(__i386__)
+    (void)ts;
+    return __rdtsc();
+#else
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+uint64_t HostBench_min(HostBenchFunc_t Func_p, void* Para_p, uint32_t Repeat) {
+    uint64_t best = UINT64_MAX;
+    uint64_t start;
+    uint64_t count;
+
+    for (uint32_t i = 0; i < Repeat; i++) {
+        start = HostBench_now();
+        for (uint8_t j = 0; j < BATCH; j++) {
+            Func_p(Para_p);
+        }
+        count = HostBench_now() - start;
+        if (count < best) {
+            best = count;
+        }
+    }
+    if (Func_p == HostBench_nop) {
+        return best;
+    }
+    best = (best > HostBench_overhead) ? best - HostBench_overhead : 0;
+    return (best + BATCH / 2) / BATCH;
+}
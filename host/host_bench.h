@@ -0,0 +1,44 @@
+/**
+ * @file host_bench.h
+ * @brief 主機端的每次呼叫指令數量測。
+ *
+ * 可使用 perf_event_open 時計數使用者空間的指令數，否則退回 x86 的
+ * TSC 週期數或 clock_gettime 的奈秒數，HostBench_unit 回傳實際使用的
+ * 單位。指令數與 AVR 的週期數不同，只適合比較同一台主機上的相對成本。
+ */
+
+#ifndef HOST_BENCH_H
+#define HOST_BENCH_H
+
+#include <stdint.h>
+
+/**
+ * @brief 量測函式型態，每次呼叫量測一次。
+ */
+typedef void (*HostBenchFunc_t)(void* Para_p);
+
+/**
+ * @brief 開啟計數器，量測前呼叫一次。
+ */
+void HostBench_open(void);
+
+/**
+ * @brief 取得計數單位，"instr"、"cycle" 或 "ns"。
+ */
+const char* HostBench_unit(void);
+
+/**
+ * @brief 讀取目前的計數值。
+ */
+uint64_t HostBench_now(void);
+
+/**
+ * @brief 重複呼叫 Func_p，回傳扣除量測本身負擔後每次呼叫的最小計數。
+ *
+ * @param Func_p  量測函式。
+ * @param Para_p  量測函式之傳參。
+ * @param Repeat  取樣次數，每次取樣連續呼叫 16 次。
+ */
+uint64_t HostBench_min(HostBenchFunc_t Func_p, void* Para_p, uint32_t Repeat);
+
+#endif  // HOST_BENCH_H
@@ -0,0 +1,269 @@
+/**
+ * @file host_model.c
+ * @brief 主機端的周邊模型與 libc4m.a 進入點替身實作。
+ */
+
+#include "host_model.h"
+
+#include <string.h>
+
+volatile uint8_t HostReg[HOSTREG_SZ] __attribute__((aligned(2)));
+
+HostBusFunc_t HostBus_trm_p;
+HostBusFunc_t HostBus_rec_p;
+uint8_t HostBus_mem[3][256];
+uint32_t HostBus_count[3];
+
+uint8_t (*HostSpi_swap_p)(uint8_t Data);
+uint8_t HostSpi_id;
+
+uint8_t HostHmi_buf[HOSTHMI_BUF_SZ];
+uint16_t HostHmi_len;
+
+uint8_t HostEe_mem[E2END + 1];
+uint16_t HostEe_writeTicks;
+uint32_t HostEe_writes;
+uint32_t HostEe_reads;
+
+static uint16_t HostEe_busy;
+
+/*----- 遠端暫存器 ----------------------------------------------------------*/
+
+static char HostBus_memTrm(uint8_t Bus, char Mode, char Id, char RegAdd,
+                           char Bytes, void* Data_p) {
+    for (uint8_t i = 0; i < (uint8_t)Bytes; i++) {
+        HostBus_mem[Bus][(uint8_t)(RegAdd + i)] = ((uint8_t*)Data_p)[i];
+    }
+    return 0;
+}
+
+static char HostBus_memRec(uint8_t Bus, char Mode, char Id, char RegAdd,
+                           char Bytes, void* Data_p) {
+    for (uint8_t i = 0; i < (uint8_t)Bytes; i++) {
+        ((uint8_t*)Data_p)[i] = HostBus_mem[Bus][(uint8_t)(RegAdd + i)];
+    }
+    return 0;
+}
+
+static char HostBus_trm(uint8_t Bus, char Mode, char Id, char RegAdd,
+                        char Bytes, void* Data_p) {
+    HostBus_count[Bus]++;
+    return HostBus_trm_p(Bus, Mode, Id, RegAdd, Bytes, Data_p);
+}
+
+static char HostBus_rec(uint8_t Bus, char Mode, char Id, char RegAdd,
+                        char Bytes, void* Data_p) {
+    HostBus_count[Bus]++;
+    return HostBus_rec_p(Bus, Mode, Id, RegAdd, Bytes, Data_p);
+}
+
+char UARTM_trm(char Mode, char UartID, char RegAdd, char Bytes, void* Data_p,
+               uint16_t WaitTick) {
+    return HostBus_trm(HOSTBUS_UART, Mode, UartID, RegAdd, Bytes, Data_p);
+}
+
+char UARTM_rec(char Mode, char UartID, char RegAdd, char Bytes, void* Data_p,
+               uint16_t WaitTick) {
+    return HostBus_rec(HOSTBUS_UART, Mode, UartID, RegAdd, Bytes, Data_p);
+}
+
+char ASA_SPIM_trm(char mode, char ASAID, char RegAdd, char Bytes, void* Data_p,
+                  uint16_t WaitTick) {
+    return HostBus_trm(HOSTBUS_SPI, mode, ASAID, RegAdd, Bytes, Data_p);
+}
+
+char ASA_SPIM_rec(char mode, char ASAID, char RegAdd, char Bytes, void* Data_p,
+                  uint16_t WaitTick) {
+    return HostBus_rec(HOSTBUS_SPI, mode, ASAID, RegAdd, Bytes, Data_p);
+}
+
+char TWIM_trm(char mode, char SLA, char RegAdd, char Bytes, uint8_t* Data_p,
+              uint16_t WaitTick) {
+    return HostBus_trm(HOSTBUS_TWI, mode, SLA, RegAdd, Bytes, Data_p);
+}
+
+char TWIM_rec(char mode, char SLA, char RegAdd, char Bytes, uint8_t* Data_p,
+              uint16_t WaitTick) {
+    return HostBus_rec(HOSTBUS_TWI, mode, SLA, RegAdd, Bytes, Data_p);
+}
+
+/*----- ASA 匯流排 ----------------------------------------------------------*/
+
+static uint8_t HostSpi_idle(uint8_t Data) {
+    return 0xFF;
+}
+
+void ASABUS_ID_set(char id) {
+    HostSpi_id = id;
+}
+
+char ASABUS_SPI_swap(char data) {
+    return HostSpi_swap_p(data);
+}
+
+/*----- HMI -----------------------------------------------------------------*/
+
+static char HostHmi_put(uint16_t Bytes, const void* Data_p) {
+    if (HostHmi_len + Bytes > HOSTHMI_BUF_SZ) {
+        return 1;
+    }
+    memcpy(&HostHmi_buf[HostHmi_len], Data_p, Bytes);
+    HostHmi_len += Bytes;
+    return 0;
+}
+
+char HMI_put_array(char Type, char Num, void* Data_p) {
+    static const uint8_t size[] = {1, 2, 4, 8, 1, 2, 4, 8, 4, 8};
+
+    if ((uint8_t)Type >= sizeof(size)) {
+        return 1;
+    }
+    return HostHmi_put((uint16_t)size[(uint8_t)Type] * (uint8_t)Num, Data_p);
+}
+
+char HMI_put_struct(const char* FormatString, int Bytes, void* Data_p) {
+    return HostHmi_put((uint16_t)Bytes, Data_p);
+}
+
+/*----- 中斷註冊與分派 ------------------------------------------------------*/
+
+static uint8_t HostInt_reg(uint8_t* Total_p, volatile FuncBlockStr_t* Fb_p,
+                           uint8_t Max, Func_t FbFunc_p, void* FbPara_p) {
+    uint8_t id = *Total_p;
+
+    if (id >= Max) {
+        return id;
+    }
+    Fb_p[id].enable     = 0;
+    Fb_p[id].func_p     = FbFunc_p;
+    Fb_p[id].funcPara_p = FbPara_p;
+    *Total_p            = id + 1;
+    return id;
+}
+
+static void HostInt_step(uint8_t Total, volatile FuncBlockStr_t* Fb_p) {
+    for (uint8_t i = 0; i < Total; i++) {
+        if (Fb_p[i].enable) {
+            Fb_p[i].func_p(Fb_p[i].funcPara_p);
+        }
+    }
+}
+
+uint8_t UartTxInt_reg(UartIntStr_t* UartIntStr_p, Func_t FbFunc_p,
+                      void* FbPara_p) {
+    return HostInt_reg(&UartIntStr_p->TxIntTotal, UartIntStr_p->TxIntFb,
+                       MAX_UARTINT_FUNCNUM, FbFunc_p, FbPara_p);
+}
+
+uint8_t UartRxInt_reg(UartIntStr_t* UartIntStr_p, Func_t FbFunc_p,
+                      void* FbPara_p) {
+    return HostInt_reg(&UartIntStr_p->RxIntTotal, UartIntStr_p->RxIntFb,
+                       MAX_UARTINT_FUNCNUM, FbFunc_p, FbPara_p);
+}
+
+void UartTxInt_en(UartIntStr_t* UartIntStr_p, uint8_t Fb_Id, uint8_t enable) {
+    if (Fb_Id < UartIntStr_p->TxIntTotal) {
+        UartIntStr_p->TxIntFb[Fb_Id].enable = enable;
+    }
+}
+
+void UartRxInt_en(UartIntStr_t* UartIntStr_p, uint8_t Fb_Id, uint8_t enable) {
+    if (Fb_Id < UartIntStr_p->RxIntTotal) {
+        UartIntStr_p->RxIntFb[Fb_Id].enable = enable;
+    }
+}
+
+void UartTx_step(UartIntStr_t* UartIntStr_p) {
+    HostInt_step(UartIntStr_p->TxIntTotal, UartIntStr_p->TxIntFb);
+}
+
+void UartRx_step(UartIntStr_t* UartIntStr_p) {
+    HostInt_step(UartIntStr_p->RxIntTotal, UartIntStr_p->RxIntFb);
+}
+
+uint8_t SpiInt_reg(SpiIntStr_t* IntStr_p, Func_t FbFunc_p, void* FbPara_p) {
+    return HostInt_reg(&IntStr_p->IntTotal, IntStr_p->IntFb,
+                       MAX_SPIIINT_FUNCNUM, FbFunc_p, FbPara_p);
+}
+
+void SpiInt_en(SpiIntStr_t* IntStr_p, uint8_t Fb_Id, uint8_t enable) {
+    if (Fb_Id < IntStr_p->IntTotal) {
+        IntStr_p->IntFb[Fb_Id].enable = enable;
+    }
+}
+
+void SpiInt_step(SpiIntStr_t* IntStr_p) {
+    HostInt_step(IntStr_p->IntTotal, IntStr_p->IntFb);
+}
+
+uint8_t TwiInt_reg(TwiIntStr_t* TwiIntStr_p, Func_t FbFunc_p, void* FbPara_p) {
+    return HostInt_reg(&TwiIntStr_p->IntTotal, TwiIntStr_p->IntFb,
+                       MAX_TWIINT_FUNCNUM, FbFunc_p, FbPara_p);
+}
+
+void TwiInt_en(TwiIntStr_t* TwiIntStr_p, uint8_t Fb_Id, uint8_t enable) {
+    if (Fb_Id < TwiIntStr_p->IntTotal) {
+        TwiIntStr_p->IntFb[Fb_Id].enable = enable;
+    }
+}
+
+void TwiInt_step(TwiIntStr_t* TwiIntStr_p) {
+    HostInt_step(TwiIntStr_p->IntTotal, TwiIntStr_p->IntFb);
+}
+
+/*----- EEPROM --------------------------------------------------------------*/
+
+#define EECR_RAW _SFR_IO8(0x1C)
+#define EEDR_RAW _SFR_IO8(0x1D)
+
+volatile uint8_t* HostEe_cr(void) {
+    if (EECR_RAW & _BV(EEWE)) {
+        if (HostEe_busy == 0) {
+            HostEe_mem[EEAR & E2END] = EEDR_RAW;
+            HostEe_writes++;
+            HostEe_busy = HostEe_writeTicks + 1;
+        }
+        if (--HostEe_busy == 0) {
+            EECR_RAW &= (uint8_t)~(_BV(EEWE) | _BV(EEMWE));
+        }
+    }
+    return &EECR_RAW;
+}
+
+volatile uint8_t* HostEe_dr(void) {
+    if (EECR_RAW & _BV(EERE)) {
+        EECR_RAW &= (uint8_t)~_BV(EERE);
+        EEDR_RAW = HostEe_mem[EEAR & E2END];
+        HostEe_reads++;
+    }
+    return &EEDR_RAW;
+}
+
+uint8_t HostEe_tick(void) {
+    uint8_t eecr = EECR;
+
+    return ((eecr & (_BV(EEWE) | _BV(EERIE))) == _BV(EERIE)) ? 1 : 0;
+}
+
+/*----- 重置 ----------------------------------------------------------------*/
+
+void Host_reset(void) {
+    memset((void*)HostReg, 0, sizeof(HostReg));
+    SREG = _BV(SREG_I);
+
+    HostBus_trm_p = HostBus_memTrm;
+    HostBus_rec_p = HostBus_memRec;
+    memset(HostBus_mem, 0, sizeof(HostBus_mem));
+    memset(HostBus_count, 0, sizeof(HostBus_count));
+
+    HostSpi_swap_p = HostSpi_idle;
+    HostSpi_id     = 0;
+
+    HostHmi_len = 0;
+
+    memset(HostEe_mem, 0xFF, sizeof(HostEe_mem));
+    HostEe_writeTicks = 0;
+    HostEe_writes     = 0;
+    HostEe_reads      = 0;
+    HostEe_busy       = 0;
+}
@@ -0,0 +1,72 @@
+/**
+ * @file host_model.h
+ * @brief 主機端的周邊模型與 libc4m.a 進入點替身。
+ *
+ * libc4m.a 只有 AVR 版本，本專案中的模組在主機端連結時，改由本檔提供
+ * 它們用到的函式庫進入點：
+ *   - UartTxInt_reg、SpiInt_reg、TwiInt_reg 等註冊函式與 UartTx_step、
+ *     SpiInt_step 等分派函式，行為與函式庫相同，測試程式呼叫分派函式
+ *     即相當於發生一次硬體中斷。
+ *   - UARTM_trm / _rec、ASA_SPIM_trm / _rec、TWIM_trm / _rec 轉交給
+ *     HostBus_trm_p、HostBus_rec_p，預設為每個匯流排 256 位元組的遠端
+ *     暫存器陣列 HostBus_mem。
+ *   - ASABUS_SPI_swap 轉交給 HostSpi_swap_p，預設回傳 0xFF。
+ *   - HMI_put_array、HMI_put_struct 將資料附加到 HostHmi_buf。
+ *
+ * EEPROM 模型以 EECR 的存取次數計時：
+ *   - 設定 EERE 後下一次存取 EEDR 即讀出 HostEe_mem[EEAR]。
+ *   - 設定 EEWE 後下一次存取 EECR 時寫入一個位元組，再經過
+ *     HostEe_writeTicks 次存取才清除 EEWE。主程式輪詢 EEWE 的迴圈因此
+ *     一定會結束；測試程式以 HostEe_tick 代替中斷之間經過的時間。
+ */
+
+#ifndef HOST_MODEL_H
+#define HOST_MODEL_H
+
+#include "c4mlib.h"
+
+#define HOSTBUS_UART 0  ///< UARTM_* 的匯流排編號
+#define HOSTBUS_SPI  1  ///< ASA_SPIM_* 的匯流排編號
+#define HOSTBUS_TWI  2  ///< TWIM_* 的匯流排編號
+
+#define HOSTHMI_BUF_SZ 4096  ///< HMI 輸出紀錄大小
+
+/**
+ * @brief 遠端暫存器存取函式型態。
+ *
+ * 參數同 UARTM_trm，另以 Bus 區分匯流排，回傳值即為函式庫函式的回傳值。
+ */
+typedef char (*HostBusFunc_t)(uint8_t Bus, char Mode, char Id, char RegAdd,
+                              char Bytes, void* Data_p);
+
+extern HostBusFunc_t HostBus_trm_p;     ///< 遠端寫入，預設寫入 HostBus_mem
+extern HostBusFunc_t HostBus_rec_p;     ///< 遠端讀取，預設讀出 HostBus_mem
+extern uint8_t HostBus_mem[3][256];     ///< 預設的遠端暫存器
+extern uint32_t HostBus_count[3];       ///< 各匯流排的存取次數
+
+extern uint8_t (*HostSpi_swap_p)(uint8_t Data);  ///< SPI 交換一個位元組
+extern uint8_t HostSpi_id;                        ///< ASABUS_ID_set 設定值
+
+extern uint8_t HostHmi_buf[HOSTHMI_BUF_SZ];  ///< HMI 輸出紀錄
+extern uint16_t HostHmi_len;                 ///< HMI 輸出紀錄長度
+
+extern uint8_t HostEe_mem[E2END + 1];  ///< EEPROM 內容
+extern uint16_t HostEe_writeTicks;     ///< 每個位元組的寫入時間
+extern uint32_t HostEe_writes;         ///< 已寫入位元組數
+extern uint32_t HostEe_reads;          ///< 已讀出位元組數
+
+/**
+ * @brief 重置暫存器、EEPROM 與所有模型，SREG 的 I 位元為 1。
+ *
+ * EEPROM 全為 0xFF，遠端暫存器全為0，函式指標回到預設。
+ */
+void Host_reset(void);
+
+/**
+ * @brief EEPROM 經過一個時間單位，同存取一次 EECR。
+ *
+ * @return uint8_t 1 表示 EEWE 已清除且 EERIE 開啟，應執行 EE_READY 中斷。
+ */
+uint8_t HostEe_tick(void);
+
+#endif  // HOST_MODEL_H
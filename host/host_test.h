@@ -0,0 +1,29 @@
+/**
+ * @file host_test.h
+ * @brief 主機端測試的檢查巨集。
+ *
+ * 每個測試檔為一個執行檔，CHECK 失敗時印出位置並繼續，main 以
+ * HOSTTEST_RESULT() 回傳是否有失敗，交由 ctest 判斷。
+ */
+
+#ifndef HOST_TEST_H
+#define HOST_TEST_H
+
+#include <stdio.h>
+
+#include "host_model.h"
+
+static int HostTest_fail;
+
+#define CHECK(EXPR)                                                  \
+    do {                                                             \
+        if (!(EXPR)) {                                               \
+            fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__,   \
+                    __LINE__, #EXPR);                                \
+            HostTest_fail++;                                         \
+        }                                                            \
+    } while (0)
+
+#define HOSTTEST_RESULT() (HostTest_fail ? 1 : 0)
+
+#endif  // HOST_TEST_H
@@ -0,0 +1,84 @@
+/**
+ * @file host_wire.c
+ * @brief 主機端的全雙工 UART 連線模型實作。
+ */
+
+#include "host_wire.h"
+
+/* 模組寫入了 UDRn 時開始送出該位元組 */
+static void HostWire_watch(HostWireEndStr_t* End_p) {
+    if (End_p->TxBuf_p->Tail != End_p->Tail) {
+        End_p->Tail  = End_p->TxBuf_p->Tail;
+        End_p->Shift = *End_p->Udr_p;
+        End_p->Busy  = 1;
+    }
+}
+
+static void HostWire_watchAll(HostWireStr_t* Str_p) {
+    HostWire_watch(&Str_p->End[0]);
+    HostWire_watch(&Str_p->End[1]);
+}
+
+void HostWire_net(HostWireStr_t* Str_p, UartIntStr_t* Int0_p,
+                  RingBufStr_t* Buf0_p, UartIntStr_t* Int1_p,
+                  RingBufStr_t* Buf1_p, uint16_t Latency) {
+    HostWireEndStr_t* end_p;
+
+    for (uint8_t i = 0; i < 2; i++) {
+        end_p          = &Str_p->End[i];
+        end_p->Int_p   = i ? Int1_p : Int0_p;
+        end_p->Udr_p   = i ? &UDR1 : &UDR0;
+        end_p->TxBuf_p = i ? Buf1_p : Buf0_p;
+        end_p->Tail    = end_p->TxBuf_p->Tail;
+        end_p->Busy    = 0;
+        end_p->Head    = 0;
+        end_p->Out     = 0;
+        end_p->Bytes   = 0;
+    }
+    Str_p->Latency = Latency;
+    Str_p->Now     = 0;
+}
+
+void HostWire_step(HostWireStr_t* Str_p) {
+    HostWire_watchAll(Str_p);
+    Str_p->Now++;
+
+    /* 送完的位元組進入線上，並執行傳送中斷 */
+    for (uint8_t i = 0; i < 2; i++) {
+        HostWireEndStr_t* end_p = &Str_p->End[i];
+
+        if (!end_p->Busy) {
+            continue;
+        }
+        end_p->Busy = 0;
+        end_p->Fifo[end_p->Head] = end_p->Shift;
+        end_p->Due[end_p->Head]  = Str_p->Now + Str_p->Latency;
+        end_p->Head++;
+        end_p->Bytes++;
+        UartTx_step(end_p->Int_p);
+        HostWire_watchAll(Str_p);
+    }
+
+    /* 到達另一端的位元組，執行接收中斷 */
+    for (uint8_t i = 0; i < 2; i++) {
+        HostWireEndStr_t* end_p = &Str_p->End[i];
+        HostWireEndStr_t* far_p = &Str_p->End[!i];
+
+        while (end_p->Out != end_p->Head &&
+               end_p->Due[end_p->Out] <= Str_p->Now) {
+            *far_p->Udr_p = end_p->Fifo[end_p->Out++];
+            UartRx_step(far_p->Int_p);
+            HostWire_watchAll(Str_p);
+        }
+    }
+}
+
+uint8_t HostWire_isIdle(HostWireStr_t* Str_p) {
+    HostWire_watchAll(Str_p);
+    for (uint8_t i = 0; i < 2; i++) {
+        if (Str_p->End[i].Busy || Str_p->End[i].Out != Str_p->End[i].Head) {
+            return 0;
+        }
+    }
+    return 1;
+}
@@ -0,0 +1,72 @@
+/**
+ * @file host_wire.h
+ * @brief 主機端的全雙工 UART 連線模型。
+ *
+ * 連接 UART0 與 UART1 兩端，以位元組時間為單位推進：
+ *   - 一端寫入 UDRn 後，該位元組在下一個位元組時間送完，執行該端的
+ *     傳送中斷，並在 Latency 個位元組時間後到達另一端，執行另一端的
+ *     接收中斷。
+ *   - 模擬的 UDRn 只是記憶體，無法得知何時被寫入，因此以該端傳送環狀
+ *     緩衝區的 Tail 變化判斷：模組每寫入一次 UDRn 即從緩衝區取出一個
+ *     位元組。
+ */
+
+#ifndef HOST_WIRE_H
+#define HOST_WIRE_H
+
+#include "host_model.h"
+#include "ringbuf.h"
+
+#define HOSTWIRE_FIFO_SZ 256  ///< 線上傳遞中的最大位元組數
+
+/**
+ * @brief 連線一端
+ */
+typedef struct {
+    UartIntStr_t* Int_p;     ///< 該端的 UART 中斷結構。
+    volatile uint8_t* Udr_p; ///< 該端的 UDRn。
+    RingBufStr_t* TxBuf_p;   ///< 該端的傳送環狀緩衝區。
+    uint8_t Tail;            ///< 上次看到的 TxBuf_p->Tail。
+    uint8_t Shift;           ///< 正在送出的位元組。
+    uint8_t Busy;            ///< 正在送出一個位元組。
+    uint8_t Fifo[HOSTWIRE_FIFO_SZ];   ///< 送往另一端的位元組。
+    uint32_t Due[HOSTWIRE_FIFO_SZ];   ///< 各位元組到達另一端的時間。
+    uint8_t Head;            ///< Fifo 寫入計數。
+    uint8_t Out;             ///< Fifo 讀出計數。
+    uint32_t Bytes;          ///< 已送出位元組數。
+} HostWireEndStr_t;
+
+/**
+ * @brief 全雙工連線
+ */
+typedef struct {
+    HostWireEndStr_t End[2];  ///< End[0] 為 UART0，End[1] 為 UART1。
+    uint16_t Latency;         ///< 單向傳遞延遲，以位元組時間計。
+    uint32_t Now;             ///< 目前時間，以位元組時間計。
+} HostWireStr_t;
+
+/**
+ * @brief 初始化連線。
+ *
+ * @param Str_p   連線結構指標。
+ * @param Int0_p  UART0 端的中斷結構。
+ * @param Buf0_p  UART0 端模組的傳送環狀緩衝區。
+ * @param Int1_p  UART1 端的中斷結構。
+ * @param Buf1_p  UART1 端模組的傳送環狀緩衝區。
+ * @param Latency 單向傳遞延遲，以位元組時間計。
+ */
+void HostWire_net(HostWireStr_t* Str_p, UartIntStr_t* Int0_p,
+                  RingBufStr_t* Buf0_p, UartIntStr_t* Int1_p,
+                  RingBufStr_t* Buf1_p, uint16_t Latency);
+
+/**
+ * @brief 經過一個位元組時間。
+ */
+void HostWire_step(HostWireStr_t* Str_p);
+
+/**
+ * @brief 兩端都沒有送出中或傳遞中的位元組。
+ */
+uint8_t HostWire_isIdle(HostWireStr_t* Str_p);
+
+#endif  // HOST_WIRE_H
@@ -0,0 +1,19 @@
+/**
+ * @file interrupt.h
+ * @brief 主機端的 cli、sei 與 ISR。
+ *
+ * cli、sei 只改變 SREG 的 I 位元，周邊模型依此決定是否執行中斷。
+ * ISR 展開為一般函式，由測試程式直接呼叫。
+ */
+
+#ifndef HOST_AVR_INTERRUPT_H
+#define HOST_AVR_INTERRUPT_H
+
+#include <avr/io.h>
+
+#define cli() (SREG &= (uint8_t)~_BV(SREG_I))
+#define sei() (SREG |= _BV(SREG_I))
+
+#define ISR(VECTOR, ...) void VECTOR(void)
+
+#endif  // HOST_AVR_INTERRUPT_H
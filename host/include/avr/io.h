@@ -0,0 +1,258 @@
+/**
+ * @file io.h
+ * @brief 主機端模擬的 ATmega128 暫存器。
+ *
+ * 所有暫存器皆為 HostReg 陣列中的元素，陣列索引即為 ATmega128 的資料
+ * 空間位址(I/O 位址 + 0x20)，16 位元暫存器以相鄰兩格、低位元組在前
+ * 組成。EECR、EEDR 經由 HostEe_cr、HostEe_dr 存取，以模擬 EEPROM 讀寫
+ * 的副作用，其餘暫存器都是單純的記憶體，由 host_model.h 中的周邊模型
+ * 或測試程式驅動。
+ */
+
+#ifndef HOST_AVR_IO_H
+#define HOST_AVR_IO_H
+
+#include <stdint.h>
+
+#define HOSTREG_SZ 0x100  ///< 模擬的資料空間位址範圍
+
+extern volatile uint8_t HostReg[HOSTREG_SZ];
+volatile uint8_t* HostEe_cr(void);
+volatile uint8_t* HostEe_dr(void);
+
+#define _SFR_MEM8(ADDR)  (HostReg[ADDR])
+#define _SFR_MEM16(ADDR) (*(volatile uint16_t*)&HostReg[ADDR])
+#define _SFR_IO8(ADDR)   _SFR_MEM8((ADDR) + 0x20)
+#define _SFR_IO16(ADDR)  _SFR_MEM16((ADDR) + 0x20)
+#define _SFR_ADDR(REG)   ((uint16_t)(&(REG) - HostReg))
+#define _BV(BIT)         (1 << (BIT))
+
+/* I/O 位址 0x00~0x3F */
+#define PINF   _SFR_IO8(0x00)
+#define PINE   _SFR_IO8(0x01)
+#define DDRE   _SFR_IO8(0x02)
+#define PORTE  _SFR_IO8(0x03)
+#define ADCW   _SFR_IO16(0x04)
+#define ADC    _SFR_IO16(0x04)
+#define ADCL   _SFR_IO8(0x04)
+#define ADCH   _SFR_IO8(0x05)
+#define ADCSRA _SFR_IO8(0x06)
+#define ADCSR  _SFR_IO8(0x06)
+#define ADMUX  _SFR_IO8(0x07)
+#define ACSR   _SFR_IO8(0x08)
+#define UBRR0L _SFR_IO8(0x09)
+#define UCSR0B _SFR_IO8(0x0A)
+#define UCSR0A _SFR_IO8(0x0B)
+#define UDR0   _SFR_IO8(0x0C)
+#define SPCR   _SFR_IO8(0x0D)
+#define SPSR   _SFR_IO8(0x0E)
+#define SPDR   _SFR_IO8(0x0F)
+#define PIND   _SFR_IO8(0x10)
+#define DDRD   _SFR_IO8(0x11)
+#define PORTD  _SFR_IO8(0x12)
+#define PINC   _SFR_IO8(0x13)
+#define DDRC   _SFR_IO8(0x14)
+#define PORTC  _SFR_IO8(0x15)
+#define PINB   _SFR_IO8(0x16)
+#define DDRB   _SFR_IO8(0x17)
+#define PORTB  _SFR_IO8(0x18)
+#define PINA   _SFR_IO8(0x19)
+#define DDRA   _SFR_IO8(0x1A)
+#define PORTA  _SFR_IO8(0x1B)
+#define EECR   (*HostEe_cr())
+#define EEDR   (*HostEe_dr())
+#define EEAR   _SFR_IO16(0x1E)
+#define EEARL  _SFR_IO8(0x1E)
+#define EEARH  _SFR_IO8(0x1F)
+#define SFIOR  _SFR_IO8(0x20)
+#define WDTCR  _SFR_IO8(0x21)
+#define OCDR   _SFR_IO8(0x22)
+#define OCR2   _SFR_IO8(0x23)
+#define TCNT2  _SFR_IO8(0x24)
+#define TCCR2  _SFR_IO8(0x25)
+#define ICR1   _SFR_IO16(0x26)
+#define ICR1L  _SFR_IO8(0x26)
+#define ICR1H  _SFR_IO8(0x27)
+#define OCR1B  _SFR_IO16(0x28)
+#define OCR1BL _SFR_IO8(0x28)
+#define OCR1BH _SFR_IO8(0x29)
+#define OCR1A  _SFR_IO16(0x2A)
+#define OCR1AL _SFR_IO8(0x2A)
+#define OCR1AH _SFR_IO8(0x2B)
+#define TCNT1  _SFR_IO16(0x2C)
+#define TCNT1L _SFR_IO8(0x2C)
+#define TCNT1H _SFR_IO8(0x2D)
+#define TCCR1B _SFR_IO8(0x2E)
+#define TCCR1A _SFR_IO8(0x2F)
+#define ASSR   _SFR_IO8(0x30)
+#define OCR0   _SFR_IO8(0x31)
+#define TCNT0  _SFR_IO8(0x32)
+#define TCCR0  _SFR_IO8(0x33)
+#define MCUCSR _SFR_IO8(0x34)
+#define MCUCR  _SFR_IO8(0x35)
+#define TIFR   _SFR_IO8(0x36)
+#define TIMSK  _SFR_IO8(0x37)
+#define EIFR   _SFR_IO8(0x38)
+#define EIMSK  _SFR_IO8(0x39)
+#define EICRB  _SFR_IO8(0x3A)
+#define RAMPZ  _SFR_IO8(0x3B)
+#define XDIV   _SFR_IO8(0x3C)
+#define SPL    _SFR_IO8(0x3D)
+#define SPH    _SFR_IO8(0x3E)
+#define SREG   _SFR_IO8(0x3F)
+
+/* 延伸 I/O 位址 0x60~0xFF */
+#define DDRF   _SFR_MEM8(0x61)
+#define PORTF  _SFR_MEM8(0x62)
+#define PING   _SFR_MEM8(0x63)
+#define DDRG   _SFR_MEM8(0x64)
+#define PORTG  _SFR_MEM8(0x65)
+#define SPMCSR _SFR_MEM8(0x68)
+#define EICRA  _SFR_MEM8(0x6A)
+#define XMCRB  _SFR_MEM8(0x6C)
+#define XMCRA  _SFR_MEM8(0x6D)
+#define OSCCAL _SFR_MEM8(0x6F)
+#define TWBR   _SFR_MEM8(0x70)
+#define TWSR   _SFR_MEM8(0x71)
+#define TWAR   _SFR_MEM8(0x72)
+#define TWDR   _SFR_MEM8(0x73)
+#define TWCR   _SFR_MEM8(0x74)
+#define OCR1C  _SFR_MEM16(0x78)
+#define OCR1CL _SFR_MEM8(0x78)
+#define OCR1CH _SFR_MEM8(0x79)
+#define TCCR1C _SFR_MEM8(0x7A)
+#define ETIFR  _SFR_MEM8(0x7C)
+#define ETIMSK _SFR_MEM8(0x7D)
+#define ICR3   _SFR_MEM16(0x80)
+#define OCR3C  _SFR_MEM16(0x82)
+#define OCR3B  _SFR_MEM16(0x84)
+#define OCR3A  _SFR_MEM16(0x86)
+#define TCNT3  _SFR_MEM16(0x88)
+#define TCCR3B _SFR_MEM8(0x8A)
+#define TCCR3A _SFR_MEM8(0x8B)
+#define TCCR3C _SFR_MEM8(0x8C)
+#define UBRR0H _SFR_MEM8(0x90)
+#define UCSR0C _SFR_MEM8(0x95)
+#define UBRR1H _SFR_MEM8(0x98)
+#define UBRR1L _SFR_MEM8(0x99)
+#define UCSR1B _SFR_MEM8(0x9A)
+#define UCSR1A _SFR_MEM8(0x9B)
+#define UDR1   _SFR_MEM8(0x9C)
+#define UCSR1C _SFR_MEM8(0x9D)
+
+/* SREG */
+#define SREG_C 0
+#define SREG_Z 1
+#define SREG_N 2
+#define SREG_V 3
+#define SREG_S 4
+#define SREG_H 5
+#define SREG_T 6
+#define SREG_I 7
+
+/* EECR */
+#define EERE  0
+#define EEWE  1
+#define EEMWE 2
+#define EERIE 3
+
+/* ADMUX、ADCSRA */
+#define MUX0  0
+#define MUX1  1
+#define MUX2  2
+#define MUX3  3
+#define MUX4  4
+#define ADLAR 5
+#define REFS0 6
+#define REFS1 7
+#define ADPS0 0
+#define ADPS1 1
+#define ADPS2 2
+#define ADIE  3
+#define ADIF  4
+#define ADFR  5
+#define ADSC  6
+#define ADEN  7
+
+/* SPCR、SPSR */
+#define SPR0  0
+#define SPR1  1
+#define CPHA  2
+#define CPOL  3
+#define MSTR  4
+#define DORD  5
+#define SPE   6
+#define SPIE  7
+#define SPI2X 0
+#define WCOL  6
+#define SPIF  7
+
+/* TWCR、TWSR */
+#define TWIE  0
+#define TWEN  2
+#define TWWC  3
+#define TWSTO 4
+#define TWSTA 5
+#define TWEA  6
+#define TWINT 7
+#define TWPS0 0
+#define TWPS1 1
+
+/* UCSRnA、UCSRnB */
+#define MPCM0  0
+#define U2X0   1
+#define UPE0   2
+#define DOR0   3
+#define FE0    4
+#define UDRE0  5
+#define TXC0   6
+#define RXC0   7
+#define TXB80  0
+#define RXB80  1
+#define UCSZ02 2
+#define TXEN0  3
+#define RXEN0  4
+#define UDRIE0 5
+#define TXCIE0 6
+#define RXCIE0 7
+#define MPCM1  0
+#define U2X1   1
+#define UPE1   2
+#define DOR1   3
+#define FE1    4
+#define UDRE1  5
+#define TXC1   6
+#define RXC1   7
+#define TXB81  0
+#define RXB81  1
+#define UCSZ12 2
+#define TXEN1  3
+#define RXEN1  4
+#define UDRIE1 5
+#define TXCIE1 6
+#define RXCIE1 7
+
+/* TIMSK、TIFR */
+#define TOIE0  0
+#define OCIE0  1
+#define TOIE2  6
+#define OCIE2  7
+#define TOIE1  2
+#define OCIE1B 3
+#define OCIE1A 4
+#define TICIE1 5
+#define TOV0   0
+#define OCF0   1
+#define TOV1   2
+#define OCF1B  3
+#define OCF1A  4
+#define ICF1   5
+#define TOV2   6
+#define OCF2   7
+
+#define RAMSTART 0x100
+#define RAMEND   0x10FF
+#define E2END    0x0FFF
+#define FLASHEND 0x1FFFF
+
+#endif  // HOST_AVR_IO_H
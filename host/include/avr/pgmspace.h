@@ -0,0 +1,23 @@
+/**
+ * @file pgmspace.h
+ * @brief 主機端的 PROGMEM 存取，程式記憶體與資料記憶體相同。
+ */
+
+#ifndef HOST_AVR_PGMSPACE_H
+#define HOST_AVR_PGMSPACE_H
+
+#include <stdint.h>
+#include <string.h>
+
+#define PROGMEM
+#define PSTR(S) (S)
+
+#define pgm_read_byte(ADDR)  (*(const uint8_t*)(ADDR))
+#define pgm_read_word(ADDR)  (*(const uint16_t*)(ADDR))
+#define pgm_read_dword(ADDR) (*(const uint32_t*)(ADDR))
+#define pgm_read_ptr(ADDR)   (*(void* const*)(ADDR))
+
+#define memcpy_P memcpy
+#define strlen_P strlen
+
+#endif  // HOST_AVR_PGMSPACE_H
@@ -0,0 +1,12 @@
+/**
+ * @file delay.h
+ * @brief 主機端不模擬時間，延遲為空操作。
+ */
+
+#ifndef HOST_UTIL_DELAY_H
+#define HOST_UTIL_DELAY_H
+
+#define _delay_us(US) ((void)(US))
+#define _delay_ms(MS) ((void)(MS))
+
+#endif  // HOST_UTIL_DELAY_H
@@ -0,0 +1,160 @@
+/**
+ * @file test_adc_filt.c
+ * @brief AdcFilt 以合成取樣序列對照參考模型的測試。
+ */
+
+#include "adc_filt.h"
+#include "host_test.h"
+
+static uint16_t Buf[8];
+
+/* 以 64 位元累加的 CIC 參考模型，不受積分器溢位影響 */
+typedef struct {
+    uint8_t Order;
+    uint8_t DecBits;
+    uint8_t Shift;
+    uint16_t Count;
+    uint64_t Integ[2];
+    uint64_t Comb[2];
+} RefStr_t;
+
+static uint8_t refPut(RefStr_t* Ref_p, uint16_t Sample, uint16_t* Out_p) {
+    uint64_t out;
+    uint64_t last;
+
+    Ref_p->Integ[0] += Sample;
+    Ref_p->Integ[1] += Ref_p->Integ[0];
+    if (++Ref_p->Count < ((uint16_t)1 << Ref_p->DecBits)) {
+        return 0;
+    }
+    Ref_p->Count = 0;
+    last = Ref_p->Integ[Ref_p->Order - 1];
+    out  = last - Ref_p->Comb[0];
+    Ref_p->Comb[0] = last;
+    if (Ref_p->Order == 2) {
+        last           = out;
+        out            = out - Ref_p->Comb[1];
+        Ref_p->Comb[1] = last;
+    }
+    *Out_p = (uint16_t)(out >> Ref_p->Shift);
+    return 1;
+}
+
+/* 預設設定：16 倍過取樣增加2位元 */
+static void testDefault(void) {
+    AdcFiltStr_t filt = ADC0_FILT_STR_INI;
+    uint16_t data;
+
+    CHECK(AdcFilt_net(&filt, Buf, 8) == 0);
+    for (uint8_t i = 0; i < 15; i++) {
+        AdcFilt_put(&filt, 512);
+    }
+    CHECK(AdcFilt_get(&filt, &data) == 1);
+    AdcFilt_put(&filt, 512);
+    CHECK(AdcFilt_get(&filt, &data) == 0 && data == 512 << 2);
+
+    /* 取樣在 512、513 間交替，平均值 512.5 可由增加的位元表示 */
+    for (uint8_t i = 0; i < 16; i++) {
+        AdcFilt_put(&filt, 512 + (i & 1));
+    }
+    CHECK(AdcFilt_get(&filt, &data) == 0 && data == 2050);
+
+    /* 經由 ADCW 輸入 */
+    ADCW = 100;
+    for (uint8_t i = 0; i < 16; i++) {
+        AdcFilt_step(&filt);
+    }
+    CHECK(AdcFilt_get(&filt, &data) == 0 && data == 400);
+}
+
+/* 二階 CIC 積分器溢位後結果仍與參考模型相同 */
+static void testWrap(void) {
+    AdcFiltStr_t filt = {.Order = 2, .DecBits = 11, .ExtraBits = 6};
+    RefStr_t ref      = {.Order = 2, .DecBits = 11, .Shift = 16};
+    uint32_t seed     = 1;
+    uint16_t outputs  = 0;
+    uint16_t mismatch = 0;
+    uint16_t expect;
+    uint16_t data;
+
+    CHECK(AdcFilt_net(&filt, Buf, 8) == 0);
+    for (uint32_t i = 0; i < 20UL * 2048; i++) {
+        uint16_t sample;
+
+        seed   = seed * 1103515245 + 12345;
+        sample = 1000 + ((seed >> 16) & 0x17);
+        AdcFilt_put(&filt, sample);
+        if (refPut(&ref, sample, &expect)) {
+            outputs++;
+            if (AdcFilt_get(&filt, &data) || data != expect) {
+                mismatch++;
+            }
+        }
+    }
+    CHECK(outputs == 20);
+    CHECK(mismatch == 0);
+    CHECK(ref.Integ[1] > UINT32_MAX);
+}
+
+/* 低通濾波：第一筆輸出直接載入，之後單調趨近步階輸入 */
+static void testIir(void) {
+    AdcFiltStr_t filt = {.Order = 1, .DecBits = 2, .ExtraBits = 0,
+                         .IirShift = 2};
+    uint16_t last;
+    uint16_t data;
+
+    CHECK(AdcFilt_net(&filt, Buf, 8) == 0);
+    for (uint8_t i = 0; i < 4; i++) {
+        AdcFilt_put(&filt, 100);
+    }
+    CHECK(AdcFilt_get(&filt, &data) == 0 && data == 100);
+    last = data;
+    for (uint8_t n = 0; n < 40; n++) {
+        for (uint8_t i = 0; i < 4; i++) {
+            AdcFilt_put(&filt, 900);
+        }
+        CHECK(AdcFilt_get(&filt, &data) == 0);
+        CHECK(data >= last && data <= 900);
+        last = data;
+    }
+    CHECK(last >= 896);
+}
+
+static void testOverrun(void) {
+    AdcFiltStr_t filt = {.Order = 1, .DecBits = 0, .ExtraBits = 0};
+    uint16_t data;
+
+    CHECK(AdcFilt_net(&filt, Buf, 2) == 0);
+    AdcFilt_put(&filt, 1);
+    AdcFilt_put(&filt, 2);
+    AdcFilt_put(&filt, 3);
+    CHECK(filt.Overrun == 1);
+    CHECK(AdcFilt_get(&filt, &data) == 0 && data == 1);
+    CHECK(AdcFilt_get(&filt, &data) == 0 && data == 2);
+    CHECK(AdcFilt_get(&filt, &data) == 1);
+}
+
+static void testNet(void) {
+    AdcFiltStr_t filt = ADC0_FILT_STR_INI;
+
+    CHECK(AdcFilt_net(&filt, Buf, 6) == 1);
+    filt.Order = 3;
+    CHECK(AdcFilt_net(&filt, Buf, 8) == 2);
+    filt.Order     = 1;
+    filt.ExtraBits = 7;
+    CHECK(AdcFilt_net(&filt, Buf, 8) == 3);
+    filt.ExtraBits = 2;
+    filt.IirShift  = 9;
+    CHECK(AdcFilt_net(&filt, Buf, 8) == 4);
+}
+
+int main(void) {
+    Host_reset();
+
+    testDefault();
+    testWrap();
+    testIir();
+    testOverrun();
+    testNet();
+    return HOSTTEST_RESULT();
+}
@@ -0,0 +1,133 @@
+/**
+ * @file test_asaspi_vec.c
+ * @brief ASA_SPIM 分段與批次傳輸對 RemoSlave SPI 的迴路測試。
+ *
+ * ASABUS_SPI_swap 直接接到 Slave：回傳 Slave 先前放入 SPDR 的位元組，
+ * 再將 Master 的位元組放入 SPDR 並執行 Slave 的 SPI 中斷。
+ */
+
+#include <string.h>
+
+#include "asaspi_vec.h"
+#include "host_test.h"
+#include "remo_slave.h"
+
+static RemoSlaveStr_t Slave;
+static SpiIntStr_t SpiInt;
+static RemoSlaveRegStr_t Regs[8];
+static uint8_t Reg1[2], Reg2[4], Reg2Back[4], Reg4[1];
+static uint16_t Swaps;
+
+static uint8_t swap(uint8_t Data) {
+    uint8_t out = SPDR;
+
+    SPDR = Data;
+    SpiInt_step(&SpiInt);
+    Swaps++;
+    return out;
+}
+
+static void setup(uint8_t Mode) {
+    memset(&SpiInt, 0, sizeof(SpiInt));
+    memset(Regs, 0, sizeof(Regs));
+    Regs[1].Data_p = Reg1;
+    Regs[1].Bytes  = sizeof(Reg1);
+    Regs[2].Data_p = Reg2;
+    Regs[2].Back_p = Reg2Back;
+    Regs[2].Bytes  = sizeof(Reg2);
+    Regs[4].Data_p = Reg4;
+    Regs[4].Bytes  = sizeof(Reg4);
+    CHECK(RemoSlave_net(&Slave, SERIAL_TYPE_SPI, 0, Mode, 0, Regs, 8) == 0);
+    RemoSlave_spiReg(&Slave, &SpiInt);
+    HostSpi_swap_p = swap;
+    Swaps          = 0;
+}
+
+static void testBulk(uint8_t Mode) {
+    static const SpimBulkStr_t list[3] = {{1, 2}, {2, 4}, {4, 1}};
+    static const SpimBulkStr_t bad[2]  = {{1, 2}, {3, 1}};
+    uint8_t data[7] = {0x11, 0x12, 0x21, 0x22, 0x23, 0x24, 0x41};
+    uint8_t back[7];
+    uint8_t* reg2_p;
+
+    setup(Mode);
+    CHECK(ASA_SPIM_trmb(Mode, 1, 3, list, data, 0) == 0);
+    /* [W|0x7F]、[3]、3 組列表、7 位元組資料 */
+    CHECK(Swaps == 1 + 1 + 6 + 7);
+    reg2_p = RemoSlave_regData(&Slave, 2);
+    CHECK(memcmp(Reg1, data, 2) == 0);
+    CHECK(memcmp(reg2_p, &data[2], 4) == 0);
+    CHECK(Reg4[0] == 0x41);
+    CHECK(HostSpi_id == 1);
+    CHECK(PORTF & _BV(ASA_SPIM_CS_PIN));
+
+    memset(back, 0, sizeof(back));
+    CHECK(ASA_SPIM_recb(Mode, 1, 3, list, back, 0) == 0);
+    CHECK(memcmp(back, data, 7) == 0);
+
+    /* 列表中有未註冊的暫存器，全部不寫入 */
+    data[0] = 0x99;
+    CHECK(ASA_SPIM_trmb(Mode, 1, 2, bad, data, 0) == 0);
+    CHECK(Reg1[0] == 0x11);
+    CHECK(Slave.Result == REMOSLAVE_RES_REGADD);
+
+    /* 之後的單一暫存器傳輸不受影響 */
+    {
+        SpimVecStr_t vec = {back, 2, (Mode & 1) ? SPIMV_LOWFIRST
+                                                : SPIMV_HIFIRST};
+        CHECK(ASA_SPIM_recv(Mode, 1, 1, 1, &vec, 0) == 0);
+        CHECK(back[0] == 0x11 && back[1] == 0x12);
+    }
+}
+
+static void testError(void) {
+    static const SpimBulkStr_t list[1] = {{1, 2}};
+    uint8_t data[2];
+    SpimVecStr_t vec = {data, 2, SPIMV_LOWFIRST};
+
+    setup(7);
+    CHECK(ASA_SPIM_trmb(5, 1, 1, list, data, 0) == 5);
+    CHECK(ASA_SPIM_recb(11, 1, 1, list, data, 0) == 5);
+    CHECK(ASA_SPIM_trmb(7, 1, 0, list, data, 0) == 4);
+    CHECK(ASA_SPIM_recb(7, 1, REMOSLAVE_BULK_MAX + 1, list, data, 0) == 4);
+    /* 帶 R/W 位元的 mode 中 0x7F 為批次標記 */
+    for (uint8_t mode = 7; mode <= 10; mode++) {
+        CHECK(ASA_SPIM_trmv(mode, 1, REMOSLAVE_BULK_REG, 1, &vec, 0) == 4);
+        CHECK(ASA_SPIM_recv(mode, 1, REMOSLAVE_BULK_REG, 1, &vec, 0) == 4);
+        CHECK(ASA_SPIM_recv(mode, 1, 0x80, 1, &vec, 0) == 4);
+    }
+    CHECK(Swaps == 0);
+}
+
+/* 帶 R/W 位元的 mode 不接受在批次標記位址放有資料的暫存器表 */
+static void testBulkReg(void) {
+    static RemoSlaveRegStr_t wide[REMOSLAVE_BULK_REG + 1];
+
+    wide[1].Data_p = Reg1;
+    wide[1].Bytes  = sizeof(Reg1);
+    CHECK(RemoSlave_net(&Slave, SERIAL_TYPE_SPI, 0, 7, 0, wide,
+                        REMOSLAVE_BULK_REG + 1) == 0);
+    wide[REMOSLAVE_BULK_REG].Data_p = Reg4;
+    wide[REMOSLAVE_BULK_REG].Bytes  = sizeof(Reg4);
+    for (uint8_t mode = 7; mode <= 10; mode++) {
+        CHECK(RemoSlave_net(&Slave, SERIAL_TYPE_SPI, 0, mode, 0, wide,
+                            REMOSLAVE_BULK_REG + 1) == 3);
+    }
+    CHECK(RemoSlave_net(&Slave, SERIAL_TYPE_UART, 0, 0, 1, wide,
+                        REMOSLAVE_BULK_REG + 1) == 3);
+    CHECK(RemoSlave_net(&Slave, SERIAL_TYPE_SPI, 0, 5, 0, wide,
+                        REMOSLAVE_BULK_REG + 1) == 0);
+    CHECK(RemoSlave_net(&Slave, SERIAL_TYPE_SPI, 0, 7, 0, wide,
+                        REMOSLAVE_BULK_REG) == 0);
+}
+
+int main(void) {
+    Host_reset();
+
+    for (uint8_t mode = 7; mode <= 10; mode++) {
+        testBulk(mode);
+    }
+    testError();
+    testBulkReg();
+    return HOSTTEST_RESULT();
+}
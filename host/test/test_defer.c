@@ -0,0 +1,87 @@
+/**
+ * @file test_defer.c
+ * @brief Defer 依優先權取出、佇列已滿與 Defer_step 的測試。
+ */
+
+#include "defer.h"
+#include "host_test.h"
+
+static DeferStr_t Defer;
+static DeferFbStr_t Fb;
+static uint8_t Log[64];
+static uint8_t LogLen;
+
+static void record(void* Para_p) {
+    Log[LogLen++] = (uint8_t)(uintptr_t)Para_p;
+}
+
+/* 執行時再放入一個最高優先權的事件 */
+static void repost(void* Para_p) {
+    record(Para_p);
+    CHECK(Defer_post(&Defer, 0, record, (void*)0x99) == 0);
+}
+
+static void testOrder(void) {
+    static const uint8_t expect[7] = {0x01, 0x02, 0x11, 0x99, 0x12, 0x21,
+                                      0x22};
+
+    Defer_net(&Defer);
+    LogLen = 0;
+    CHECK(Defer_post(&Defer, 2, record, (void*)0x21) == 0);
+    CHECK(Defer_post(&Defer, 1, repost, (void*)0x11) == 0);
+    CHECK(Defer_post(&Defer, 2, record, (void*)0x22) == 0);
+    CHECK(Defer_post(&Defer, 0, record, (void*)0x01) == 0);
+    CHECK(Defer_post(&Defer, 1, record, (void*)0x12) == 0);
+    CHECK(Defer_post(&Defer, 0, record, (void*)0x02) == 0);
+    CHECK(Defer_post(&Defer, DEFER_PRI_NUM, record, NULL) == 1);
+
+    /* 同一優先權先進先出，每個事件後重新從最高優先權檢查 */
+    CHECK(Defer_run(&Defer) == 7);
+    CHECK(LogLen == 7);
+    for (uint8_t i = 0; i < 7; i++) {
+        CHECK(Log[i] == expect[i]);
+    }
+    CHECK(Defer_dispatch(&Defer) == 0);
+}
+
+static void testFull(void) {
+    Defer_net(&Defer);
+    LogLen = 0;
+    for (uint8_t i = 0; i < DEFER_QUEUE_SZ; i++) {
+        CHECK(Defer_post(&Defer, 1, record, (void*)(uintptr_t)i) == 0);
+    }
+    CHECK(Defer_post(&Defer, 1, record, (void*)0xFF) == 2);
+    CHECK(Defer_post(&Defer, 1, record, (void*)0xFF) == 2);
+    CHECK(Defer.Queue[1].Lost == 2);
+    /* 其他優先權不受影響 */
+    CHECK(Defer_post(&Defer, 2, record, (void*)0x80) == 0);
+
+    CHECK(Defer_dispatch(&Defer) == 1);
+    CHECK(Defer_post(&Defer, 1, record, (void*)0x40) == 0);
+    CHECK(Defer_run(&Defer) == DEFER_QUEUE_SZ + 1);
+    CHECK(LogLen == DEFER_QUEUE_SZ + 2);
+    for (uint8_t i = 0; i < DEFER_QUEUE_SZ; i++) {
+        CHECK(Log[i] == i);
+    }
+    CHECK(Log[DEFER_QUEUE_SZ] == 0x40);
+    CHECK(Log[DEFER_QUEUE_SZ + 1] == 0x80);
+}
+
+static void testStep(void) {
+    Defer_net(&Defer);
+    LogLen = 0;
+    Defer_step(Defer_link(&Fb, &Defer, record, (void*)0x55, 2));
+    CHECK(LogLen == 0);
+    CHECK(SREG & _BV(SREG_I));
+    CHECK(Defer_run(&Defer) == 1);
+    CHECK(LogLen == 1 && Log[0] == 0x55);
+}
+
+int main(void) {
+    Host_reset();
+
+    testOrder();
+    testFull();
+    testStep();
+    return HOSTTEST_RESULT();
+}
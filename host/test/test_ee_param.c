@@ -0,0 +1,203 @@
+/**
+ * @file test_ee_param.c
+ * @brief EeParam 以實際 EeQueue 與 EEPROM 模型進行的斷電測試。
+ *
+ * 斷電以寫入位元組數模擬：執行 EE_READY 中斷直到寫入指定個數後停止，
+ * 等正在寫入的位元組結束，再以新的 EeQueue、EeParam 結構重新開機。
+ * HostEe_mem 保留斷電前的內容。
+ */
+
+#include <string.h>
+
+#include "ee_param.h"
+#include "host_test.h"
+
+#define KEY_CNT  0  ///< 每次更新的計數值，2 位元組
+#define KEY_CAL  1  ///< 不變的校正值，4 位元組
+#define KEY_MAX  2  ///< EEPARAM_MAX_LEN 位元組
+
+static EeQueueStr_t Queue;
+static EeParamStr_t Param;
+static uint8_t Snap[E2END + 1];
+static const uint8_t Cal[4] = {0x12, 0x34, 0x56, 0x78};
+static uint8_t Max[EEPARAM_MAX_LEN];
+static uint8_t Done;
+
+static void done(void* Para_p) {
+    Done++;
+}
+
+/* 執行壓縮與 EE_READY 中斷直到全部寫入，或寫入數達到 Limit */
+static void pump(uint32_t Limit) {
+    while (HostEe_writes < Limit) {
+        EeParam_run(&Param);
+        if (Param.State == EEPARAM_ST_IDLE && EeQueue_isIdle(&Queue)) {
+            break;
+        }
+        if (HostEe_tick()) {
+            EeQueue_step(&Queue);
+        }
+    }
+}
+
+/* 斷電後重新開機，佇列中尚未寫入的請求全部遺失 */
+static uint8_t reboot(void) {
+    while (EECR & _BV(EEWE)) {
+    }
+    memset(&Queue, 0, sizeof(Queue));
+    memset(&Param, 0, sizeof(Param));
+    EeQueue_net(&Queue);
+    return EeParam_net(&Param, &Queue);
+}
+
+static uint16_t getCnt(void) {
+    uint16_t cnt;
+
+    CHECK(EeParam_get(&Param, KEY_CNT, &cnt, 2) == 0);
+    return cnt;
+}
+
+static void checkOthers(void) {
+    uint8_t back[EEPARAM_MAX_LEN];
+
+    CHECK(EeParam_get(&Param, KEY_CAL, back, 4) == 0);
+    CHECK(memcmp(back, Cal, 4) == 0);
+    CHECK(EeParam_get(&Param, KEY_MAX, back, EEPARAM_MAX_LEN) == 0);
+    CHECK(memcmp(back, Max, EEPARAM_MAX_LEN) == 0);
+}
+
+static void testBasic(void) {
+    uint8_t back[4];
+    uint16_t cnt;
+
+    CHECK(reboot() == 1);
+    pump(UINT32_MAX);
+    CHECK(EeParam_get(&Param, KEY_CNT, &cnt, 2) == 2);
+
+    for (uint8_t i = 0; i < EEPARAM_MAX_LEN; i++) {
+        Max[i] = 0xA0 + i;
+    }
+    CHECK(EeParam_set(&Param, KEY_CAL, Cal, 4, NULL, NULL) == 0);
+    /* 最大長度的紀錄在空佇列中一定排得進去 */
+    pump(UINT32_MAX);
+    CHECK(EeParam_set(&Param, KEY_MAX, Max, EEPARAM_MAX_LEN, done, NULL) == 0);
+    pump(UINT32_MAX);
+    CHECK(Done == 1);
+
+    /* 足以壓縮數次的更新 */
+    for (cnt = 0; cnt < 600; cnt++) {
+        while (EeParam_set(&Param, KEY_CNT, &cnt, 2, NULL, NULL)) {
+            pump(HostEe_writes + 1);
+        }
+        CHECK(getCnt() == cnt);
+    }
+    pump(UINT32_MAX);
+    CHECK(EeParam_get(&Param, KEY_CAL, back, 2) == 4);
+    CHECK(EeParam_set(&Param, KEY_CAL, Max, EEPARAM_MAX_LEN + 1, NULL,
+                      NULL) == 4);
+    CHECK(EeParam_set(&Param, EEPARAM_KEY_NUM, Cal, 4, NULL, NULL) == 1);
+
+    CHECK(reboot() == 0);
+    CHECK(getCnt() == 599);
+    checkOthers();
+}
+
+/* 從快照開機並寫入 Cnt，在第 Cut 個位元組寫入後斷電，回傳是否已全部寫入 */
+static uint8_t cutAt(uint16_t Cnt, uint32_t Cut, uint8_t* Compact_p) {
+    uint32_t base;
+    uint8_t full;
+
+    memcpy(HostEe_mem, Snap, sizeof(Snap));
+    CHECK(reboot() == 0);
+    base = HostEe_writes;
+    CHECK(EeParam_set(&Param, KEY_CNT, &Cnt, 2, NULL, NULL) == 0);
+    *Compact_p = Param.State != EEPARAM_ST_IDLE;
+    pump(base + Cut);
+    full = Param.State == EEPARAM_ST_IDLE && EeQueue_isIdle(&Queue);
+
+    CHECK(reboot() == 0);
+    return full;
+}
+
+/* 每一個斷電點重新開機後都必須是舊值或新值，其他參數不受影響 */
+static void testCut(uint8_t Compact) {
+    uint16_t end = EEPARAM_BASE + EEPARAM_BANK_SZ;
+    uint16_t old = getCnt();
+    uint16_t cnt;
+    uint8_t compact;
+    uint8_t full;
+    uint32_t cut;
+
+    pump(UINT32_MAX);
+    if (Compact) {
+        /* 更新到下一次附加就會觸發壓縮為止 */
+        end += Param.Bank ? EEPARAM_BANK_SZ : 0;
+        while (Param.Tail + 5 < end) {
+            old++;
+            CHECK(EeParam_set(&Param, KEY_CNT, &old, 2, NULL, NULL) == 0);
+            pump(UINT32_MAX);
+        }
+    }
+    memcpy(Snap, HostEe_mem, sizeof(Snap));
+
+    for (cut = 0;; cut++) {
+        full = cutAt(old + 1, cut, &compact);
+        CHECK(compact == Compact);
+        cnt = getCnt();
+        CHECK(cnt == old || cnt == old + 1);
+        checkOthers();
+        if (full) {
+            CHECK(cnt == old + 1);
+            break;
+        }
+    }
+    CHECK(cut > 2);
+
+    /* 斷電後的日誌可以繼續附加 */
+    cnt = old + 2;
+    CHECK(EeParam_set(&Param, KEY_CNT, &cnt, 2, NULL, NULL) == 0);
+    pump(UINT32_MAX);
+    CHECK(reboot() == 0);
+    CHECK(getCnt() == cnt);
+    checkOthers();
+}
+
+/* Key 寫入中斷，只有 Key 這一個位元組錯誤 */
+static void testBadKey(void) {
+    static const uint8_t bad[3] = {KEY_CNT ^ 0x01, KEY_CNT ^ 0x04, 0x80};
+    uint16_t old;
+    uint16_t cnt;
+    uint16_t tail;
+
+    pump(UINT32_MAX);
+    old  = getCnt();
+    tail = Param.Tail;
+    cnt = old + 1;
+    CHECK(EeParam_set(&Param, KEY_CNT, &cnt, 2, NULL, NULL) == 0);
+    pump(UINT32_MAX);
+    CHECK(HostEe_mem[tail] == KEY_CNT);
+
+    for (uint8_t i = 0; i < 3; i++) {
+        HostEe_mem[tail] = bad[i];
+        CHECK(reboot() == 0);
+        CHECK(getCnt() == old);
+        checkOthers();
+        CHECK(Param.Tail == tail);
+    }
+
+    CHECK(EeParam_set(&Param, KEY_CNT, &cnt, 2, NULL, NULL) == 0);
+    pump(UINT32_MAX);
+    CHECK(reboot() == 0);
+    CHECK(getCnt() == cnt);
+}
+
+int main(void) {
+    Host_reset();
+    HostEe_writeTicks = 2;
+
+    testBasic();
+    testCut(0);
+    testCut(1);
+    testBadKey();
+    return HOSTTEST_RESULT();
+}
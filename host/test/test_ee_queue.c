@@ -0,0 +1,53 @@
+/**
+ * @file test_ee_queue.c
+ * @brief EeQueue 與 EEPROM 模型測試。
+ */
+
+#include "ee_queue.h"
+#include "host_test.h"
+
+static EeQueueStr_t Queue;
+static uint8_t Done;
+
+static void done(void* Para_p) {
+    Done++;
+}
+
+/* 執行 EE_READY 中斷直到佇列清空 */
+static void drain(void) {
+    while (!EeQueue_isIdle(&Queue)) {
+        if (HostEe_tick()) {
+            EeQueue_step(&Queue);
+        }
+    }
+}
+
+int main(void) {
+    uint8_t data[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+    uint8_t back[8];
+
+    Host_reset();
+    HostEe_writeTicks = 3;
+    EeQueue_net(&Queue);
+
+    CHECK(EeQueue_set(&Queue, 0x10, 8, data, done, NULL) == 0);
+    /* 尚未寫入前即可讀到佇列中的資料 */
+    EeQueue_get(&Queue, 0x0E, 8, back);
+    CHECK(back[0] == 0xFF && back[1] == 0xFF && back[2] == 1 && back[7] == 6);
+    CHECK(HostEe_mem[0x10] == 0xFF);
+    drain();
+    CHECK(Done == 1);
+    CHECK(HostEe_writes == 8);
+    CHECK(HostEe_mem[0x10] == 1 && HostEe_mem[0x17] == 8);
+
+    /* 內容相同的位元組不寫入 */
+    data[3] = 0x40;
+    CHECK(EeQueue_set(&Queue, 0x10, 8, data, done, NULL) == 0);
+    drain();
+    CHECK(Done == 2);
+    CHECK(HostEe_writes == 9);
+    EeQueue_get(&Queue, 0x10, 8, back);
+    CHECK(back[3] == 0x40 && back[4] == 5);
+
+    return HOSTTEST_RESULT();
+}
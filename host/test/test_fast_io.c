@@ -0,0 +1,65 @@
+/**
+ * @file test_fast_io.c
+ * @brief DIO_FPT、ADC_FPT 等常數展開巨集的暫存器對照測試。
+ *
+ * 主機上無法計算 AVR 週期，以下為 ATmega128 上 PORTB bit 3 切換一次
+ * (設為 1 再清為 0)的指令序列，函式庫路徑由 libc4m.a 的 dio.o 解碼：
+ *
+ *   DIO_FPT(1, 0x08, 3, 1) 常數展開：
+ *     sbi 0x18, 3                                   2 週期
+ *   DIO_fpt(1, 0x08, 3, 1) 函式庫：
+ *     ldi ×4、call                                  8 週期
+ *     Shift、LSByte 範圍檢查，__tablejump2__ 查表  約 26 週期
+ *     in PORTB、lsl/dec/brpl 移位迴圈 ×3、eor/and/eor、out PORTB
+ *                                                  21 週期
+ *     in DDRB、and、cpse 檢查方向、ldi、ret         11 週期
+ *                                                  約 66 週期
+ *
+ * 切換一次為 4 週期對約 132 週期。
+ */
+
+#include "fast_io.h"
+#include "host_test.h"
+
+static void testDio(void) {
+    uint8_t data;
+
+    PORTB = 0x00;
+    CHECK(DIO_FPT(1, 0x08, 3, 1) == 0);
+    CHECK(PORTB == 0x08);
+    CHECK(DIO_FPT(201, 0xF0, 4, 0x0A) == 0);
+    CHECK(DDRB == 0xA0);
+    PINF = 0x5A;
+    CHECK(DIO_FGT(105, 0x18, 3, &data) == 0 && data == 0x03);
+    CHECK(DIO_FPT(7, 0x01, 0, 1) == 2);
+    CHECK(DIO_FPT(0, 0x01, 8, 1) == 5);
+}
+
+static void testAdc(void) {
+    uint8_t data;
+
+    ADMUX  = 0x00;
+    ADCSRA = 0x00;
+    DDRF   = 0xFF;
+    CHECK(ADC_FPT(200, 0xC0, 6, 1) == 0);
+    CHECK(ADMUX == _BV(REFS0));
+    CHECK(ADC_FPT(201, _BV(ADEN), ADEN, 1) == 0);
+    CHECK(ADC_FPT(201, 0x07, 0, 6) == 0);
+    CHECK(ADCSRA == (_BV(ADEN) | 6));
+    CHECK(ADC_FPT(202, 0x01, 0, 0) == 0);
+    CHECK(DDRF == 0xFE);
+    CHECK(ADC_FGT(201, 0x07, 0, &data) == 0 && data == 6);
+    /* ADC_fgt 只接受 ADCSRA，常數展開相同 */
+    CHECK(ADC_FGT(200, 0xC0, 6, &data) == 2);
+    CHECK(ADC_FGT(202, 0xFF, 0, &data) == 2);
+    CHECK(ADC_FPT(203, 0x01, 0, 1) == 2);
+    CHECK(ADC_FGT(201, 0x01, 9, &data) == 5);
+}
+
+int main(void) {
+    Host_reset();
+
+    testDio();
+    testAdc();
+    return HOSTTEST_RESULT();
+}
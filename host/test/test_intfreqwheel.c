@@ -0,0 +1,161 @@
+/**
+ * @file test_intfreqwheel.c
+ * @brief IntFreqWheel 觸發次數與工作函式中啟用/關閉的測試。
+ */
+
+#include "host_test.h"
+#include "intfreqwheel.h"
+
+#define JOB_NUM 8
+
+static IntFreqWheelStr_t Wheel;
+static uint16_t Hits[JOB_NUM];
+static uint8_t Id[JOB_NUM];
+
+static void hit(void* Para_p) {
+    Hits[(uintptr_t)Para_p]++;
+}
+
+/* 觸發次數與 IntFreqDiv 相同：第 k 次計數在 k % cycle == phase 時觸發 */
+static void testCount(void) {
+    static const uint16_t cycle[JOB_NUM] = {1, 3, 5, 16, 40, 32, 17, 100};
+    static const uint16_t phase[JOB_NUM] = {0, 2, 0, 5, 39, 0, 16, 7};
+    uint16_t expect[JOB_NUM] = {0};
+
+    IntFreqWheel_net(&Wheel);
+    for (uintptr_t i = 0; i < JOB_NUM; i++) {
+        Hits[i] = 0;
+        Id[i]   = IntFreqWheel_reg(&Wheel, hit, (void*)i, cycle[i], phase[i]);
+        CHECK(Id[i] == i);
+        IntFreqWheel_en(&Wheel, Id[i], 1);
+    }
+    for (uint16_t k = 1; k <= 5000; k++) {
+        IntFreqWheel_step(&Wheel);
+        for (uint8_t i = 0; i < JOB_NUM; i++) {
+            if (k % cycle[i] == phase[i] && !(i == 3 && k > 2000)) {
+                expect[i]++;
+            }
+        }
+        if (k == 2000) {
+            IntFreqWheel_en(&Wheel, Id[3], 0);
+        }
+    }
+    for (uint8_t i = 0; i < JOB_NUM; i++) {
+        CHECK(Hits[i] == expect[i]);
+    }
+    CHECK(IntFreqWheel_reg(&Wheel, hit, NULL, 0, 0) == IFDW_NONE);
+    CHECK(IntFreqWheel_reg(&Wheel, hit, NULL, 4, 4) == IFDW_NONE);
+}
+
+/*----- 工作函式中的啟用/關閉 -----------------------------------------------*/
+
+static uint8_t SelfHits;
+static uint8_t OtherHits;
+static uint8_t Self;
+static uint8_t Other;
+static uint8_t Late;
+
+/* 第一次執行時關閉自己 */
+static void selfOff(void* Para_p) {
+    SelfHits++;
+    IntFreqWheel_en(&Wheel, Self, 0);
+}
+
+/* 關閉同一格中排在後面的工作 */
+static void otherOff(void* Para_p) {
+    SelfHits++;
+    IntFreqWheel_en(&Wheel, Other, 0);
+}
+
+/* 開啟另一項工作，並立即關閉再開啟自己 */
+static void otherOn(void* Para_p) {
+    SelfHits++;
+    IntFreqWheel_en(&Wheel, Late, 1);
+    IntFreqWheel_en(&Wheel, Self, 0);
+    IntFreqWheel_en(&Wheel, Self, 1);
+}
+
+static void other(void* Para_p) {
+    OtherHits++;
+}
+
+/* 時間輪每一格中沒有工作或串列沒有形成迴圈 */
+static uint8_t wheelSane(void) {
+    uint8_t count = 0;
+
+    for (uint8_t s = 0; s < IFDW_WHEEL_SZ; s++) {
+        for (uint8_t i = Wheel.head[s]; i != IFDW_NONE; i = Wheel.fb[i].next) {
+            if (++count > Wheel.total || !Wheel.fb[i].enable ||
+                Wheel.fb[i].slot != s) {
+                return 0;
+            }
+        }
+    }
+    return 1;
+}
+
+static void testSelfDisable(void) {
+    IntFreqWheel_net(&Wheel);
+    SelfHits  = 0;
+    OtherHits = 0;
+    /* 同一格中前後各有一項工作，鏈結不可被打斷 */
+    Other = IntFreqWheel_reg(&Wheel, other, NULL, 4, 0);
+    Self  = IntFreqWheel_reg(&Wheel, selfOff, NULL, 4, 0);
+    Late  = IntFreqWheel_reg(&Wheel, other, NULL, 4, 0);
+    IntFreqWheel_en(&Wheel, Other, 1);
+    IntFreqWheel_en(&Wheel, Self, 1);
+    IntFreqWheel_en(&Wheel, Late, 1);
+    for (uint8_t k = 0; k < 40; k++) {
+        IntFreqWheel_step(&Wheel);
+        CHECK(wheelSane());
+    }
+    CHECK(SelfHits == 1);
+    CHECK(OtherHits == 20);
+    CHECK(!Wheel.fb[Self].enable);
+}
+
+static void testDisableLater(void) {
+    IntFreqWheel_net(&Wheel);
+    SelfHits  = 0;
+    OtherHits = 0;
+    /* 後註冊的工作排在串列前端，Self 先於 Other 執行 */
+    Other = IntFreqWheel_reg(&Wheel, other, NULL, 4, 0);
+    Self  = IntFreqWheel_reg(&Wheel, otherOff, NULL, 4, 0);
+    IntFreqWheel_en(&Wheel, Other, 1);
+    IntFreqWheel_en(&Wheel, Self, 1);
+    for (uint8_t k = 0; k < 40; k++) {
+        IntFreqWheel_step(&Wheel);
+        CHECK(wheelSane());
+    }
+    CHECK(SelfHits == 10);
+    CHECK(OtherHits == 0);
+    CHECK(!Wheel.fb[Other].enable);
+}
+
+static void testEnableLater(void) {
+    IntFreqWheel_net(&Wheel);
+    SelfHits  = 0;
+    OtherHits = 0;
+    /* cycle 為格數的倍數，開啟後落在正在走訪的同一格 */
+    Self = IntFreqWheel_reg(&Wheel, otherOn, NULL, IFDW_WHEEL_SZ, 0);
+    Late = IntFreqWheel_reg(&Wheel, other, NULL, IFDW_WHEEL_SZ, 0);
+    IntFreqWheel_en(&Wheel, Self, 1);
+    for (uint16_t k = 0; k < IFDW_WHEEL_SZ * 4; k++) {
+        IntFreqWheel_step(&Wheel);
+        CHECK(wheelSane());
+    }
+    CHECK(SelfHits == 4);
+    CHECK(OtherHits == 3);
+    CHECK(Wheel.fb[Self].enable && Wheel.fb[Late].enable);
+    CHECK(Wheel.pend == IFDW_NONE && !Wheel.busy);
+}
+
+int main(void) {
+    Host_reset();
+
+    testCount();
+    testSelfDisable();
+    testDisableLater();
+    testEnableLater();
+    return HOSTTEST_RESULT();
+}
@@ -0,0 +1,94 @@
+/**
+ * @file test_reg_shadow.c
+ * @brief RegShadow 讀寫次數、批次合併與失效時待寫內容的測試。
+ */
+
+#include "host_test.h"
+#include "reg_shadow.h"
+
+#define SLA 0x20
+
+static RegShadowStr_t Shadow;
+static RegShadowEntryStr_t Entry[4];
+static HostBusFunc_t Trm;
+
+static char failTrm(uint8_t Bus, char Mode, char Id, char RegAdd, char Bytes,
+                    void* Data_p) {
+    return 1;
+}
+
+static void testFlag(void) {
+    uint8_t v;
+
+    HostBus_mem[HOSTBUS_TWI][5] = 0xF0;
+    v = 1;
+    CHECK(RegShadow_ftm(&Shadow, REGSHADOW_BUS_TWI, 5, SLA, 5, 5, 0x01, 0,
+                        &v) == 0);
+    CHECK(RegShadow_ftm(&Shadow, REGSHADOW_BUS_TWI, 5, SLA, 5, 5, 0x02, 1,
+                        &v) == 0);
+    /* 只讀回一次，每次旗標寫入各寫出一次 */
+    CHECK(HostBus_count[HOSTBUS_TWI] == 3);
+    CHECK(HostBus_mem[HOSTBUS_TWI][5] == 0xF3);
+
+    /* 批次區間內的寫入合併為一次 */
+    RegShadow_begin(&Shadow);
+    for (uint8_t i = 2; i < 4; i++) {
+        CHECK(RegShadow_ftm(&Shadow, REGSHADOW_BUS_TWI, 5, SLA, 5, 5, 1 << i,
+                            i, &v) == 0);
+    }
+    CHECK(HostBus_count[HOSTBUS_TWI] == 3);
+    CHECK(RegShadow_end(&Shadow) == 0);
+    CHECK(HostBus_count[HOSTBUS_TWI] == 4);
+    CHECK(HostBus_mem[HOSTBUS_TWI][5] == 0xFF);
+
+    CHECK(RegShadow_frc(&Shadow, REGSHADOW_BUS_TWI, 5, SLA, 5, 0xF0, 4, &v) ==
+          0);
+    CHECK(v == 0x0F && HostBus_count[HOSTBUS_TWI] == 4);
+
+    CHECK(RegShadow_ftm(&Shadow, 3, 5, SLA, 5, 5, 1, 0, &v) == 5);
+}
+
+static void testInvalidate(void) {
+    uint8_t v = 1;
+
+    HostBus_mem[HOSTBUS_SPI][0x10] = 0x00;
+    HostBus_mem[HOSTBUS_SPI][0x11] = 0x00;
+    RegShadow_begin(&Shadow);
+    CHECK(RegShadow_ftm(&Shadow, REGSHADOW_BUS_SPI, 5, 1, 0x10, 0x90, 0x01, 0,
+                        &v) == 0);
+    CHECK(RegShadow_frc(&Shadow, REGSHADOW_BUS_SPI, 5, 1, 0x11, 0xFF, 0,
+                        &v) == 0);
+
+    /* 遠端自行改變了 0x11，使整個裝置失效：0x10 的待寫內容先寫出 */
+    HostBus_mem[HOSTBUS_SPI][0x11] = 0x80;
+    CHECK(RegShadow_invalidate(&Shadow, REGSHADOW_BUS_SPI, 1, 0xFF) == 0);
+    CHECK(HostBus_mem[HOSTBUS_SPI][0x90] == 0x01);
+    CHECK(RegShadow_frc(&Shadow, REGSHADOW_BUS_SPI, 5, 1, 0x11, 0xFF, 0,
+                        &v) == 0);
+    CHECK(v == 0x80);
+    CHECK(RegShadow_end(&Shadow) == 0);
+
+    /* 寫出失敗時影子值保持有效與待寫，不被讀回的值取代 */
+    v = 1;
+    RegShadow_begin(&Shadow);
+    CHECK(RegShadow_ftm(&Shadow, REGSHADOW_BUS_SPI, 5, 1, 0x11, 0x91, 0x02, 1,
+                        &v) == 0);
+    HostBus_trm_p = failTrm;
+    CHECK(RegShadow_refresh(&Shadow, REGSHADOW_BUS_SPI, 5, 1, 0x11) == 1);
+    CHECK(RegShadow_frc(&Shadow, REGSHADOW_BUS_SPI, 5, 1, 0x11, 0xFF, 0,
+                        &v) == 0);
+    CHECK(v == 0x82);
+    HostBus_trm_p = Trm;
+    CHECK(RegShadow_end(&Shadow) == 0);
+    CHECK(HostBus_mem[HOSTBUS_SPI][0x91] == 0x82);
+}
+
+int main(void) {
+    Host_reset();
+    Trm = HostBus_trm_p;
+    RegShadow_net(&Shadow, Entry, 4, 0);
+
+    testFlag();
+    testInvalidate();
+    return HOSTTEST_RESULT();
+}
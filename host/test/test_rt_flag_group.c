@@ -0,0 +1,63 @@
+/**
+ * @file test_rt_flag_group.c
+ * @brief RtFlagGroup 與逐一以 Mask、Shift 讀寫旗標的對照測試。
+ */
+
+#include "host_test.h"
+#include "rt_flag_group.h"
+
+static RtFlagGroupStr_t Group;
+static RealTimeFlagStr_t Flag[10];
+static RealTimeFlagStr_t* List[10];
+
+static void setFlag(uint8_t N, volatile uint8_t* Reg_p, uint8_t Mask,
+                    uint8_t Shift) {
+    Flag[N].Reg_p = Reg_p;
+    Flag[N].Mask  = Mask;
+    Flag[N].Shift = Shift;
+    List[N]       = &Flag[N];
+}
+
+int main(void) {
+    Host_reset();
+
+    /* PORTA 每個位元一個旗標，PORTC 兩個多位元欄位，順序故意打亂 */
+    for (uint8_t i = 0; i < 8; i++) {
+        setFlag(i, &PORTA, 1 << (7 - i), 7 - i);
+    }
+    setFlag(8, &PORTC, 0xF0, 4);
+    setFlag(9, &PORTC, 0x0E, 1);
+    List[0] = &Flag[9];
+    List[9] = &Flag[0];
+    CHECK(RtFlagGroup_net(&Group, List, 10) == 0);
+    CHECK(Group.RegNum == 2);
+    CHECK(RtFlagGroup_net(&Group, List, 0) == 1);
+    CHECK(RtFlagGroup_net(&Group, List, RTFLAGGROUP_MAX_FLAG + 1) == 1);
+    CHECK(RtFlagGroup_net(&Group, List, 10) == 0);
+
+    for (uint16_t v = 0; v < 256; v++) {
+        PORTA = v;
+        PORTC = v ^ 0x5A;
+        RtFlagGroupIn_step(&Group);
+        for (uint8_t i = 0; i < 10; i++) {
+            uint8_t reg = *Flag[i].Reg_p;
+
+            CHECK(Flag[i].FlagsValue ==
+                  ((reg & Flag[i].Mask) >> Flag[i].Shift));
+        }
+    }
+
+    /* 輸出只改變遮罩內的位元 */
+    PORTA = 0x00;
+    PORTC = 0x01;
+    for (uint8_t i = 0; i < 8; i++) {
+        Flag[i].FlagsValue = i & 1;
+    }
+    Flag[8].FlagsValue = 0x0A;
+    Flag[9].FlagsValue = 0x05;
+    RtFlagGroupOut_step(&Group);
+    CHECK(PORTA == 0x55);
+    CHECK(PORTC == 0xAB);
+    CHECK(Group.TrigCount == (uint8_t)(256 + 1));
+    return HOSTTEST_RESULT();
+}
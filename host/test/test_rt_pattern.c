@@ -0,0 +1,94 @@
+/**
+ * @file test_rt_pattern.c
+ * @brief RtPattern 播放、換表與單次播放結束後排入的測試。
+ */
+
+#include <string.h>
+
+#include "host_test.h"
+#include "rt_pattern.h"
+
+static RealTimePortStr_t Port;
+static RtPatternStr_t Pat;
+static uint8_t Calls;
+
+static const uint8_t TabA[3] = {0x11, 0x12, 0x13};
+static const uint8_t TabB[2] = {0x21, 0x22};
+static const uint8_t HoldB[2] = {2, 1};
+
+static void func(void* Para_p) {
+    Calls++;
+}
+
+/* 執行 N 次中斷，回傳最後的輸出值 */
+static uint8_t run(uint8_t N) {
+    for (uint8_t i = 0; i < N; i++) {
+        RtPattern_step(&Pat);
+    }
+    return PORTA;
+}
+
+static void setup(void) {
+    memset(&Port, 0, sizeof(Port));
+    Port.Reg_p = &PORTA;
+    Port.Bytes = 1;
+    PORTA      = 0;
+    Calls      = 0;
+    CHECK(RtPattern_net(&Pat, &Port, func, NULL) == 0);
+}
+
+static void testSwitch(void) {
+    setup();
+    CHECK(RtPattern_queue(&Pat, TabA, NULL, 3, RTPATTERN_F_LOOP) == 0);
+    CHECK(RtPattern_isRunning(&Pat));
+    CHECK(run(1) == 0x11);
+    CHECK(RtPattern_queue(&Pat, TabB, HoldB, 2, RTPATTERN_F_LOOP) == 0);
+    CHECK(RtPattern_queue(&Pat, TabB, HoldB, 2, 0) == 2);
+    CHECK(run(2) == 0x13);
+    CHECK(Calls == 1);
+    /* 兩張表之間沒有間隙，0x21 保持 2 次 */
+    CHECK(run(1) == 0x21);
+    CHECK(run(1) == 0x21);
+    CHECK(run(1) == 0x22);
+    CHECK(run(1) == 0x21);
+    CHECK(Port.TrigCount == 6);
+    CHECK(RtPattern_queue(&Pat, TabA, NULL, 0, 0) == 1);
+}
+
+static void testLast(void) {
+    setup();
+    CHECK(RtPattern_start(&Pat, TabA, NULL, 3, 0) == 0);
+    CHECK(run(3) == 0x13);
+    CHECK(Pat.Run == RTPATTERN_LAST);
+
+    /* 最後一步保持中排入，立即切換並執行 Func_p */
+    CHECK(RtPattern_queue(&Pat, TabB, NULL, 2, 0) == 0);
+    CHECK(Calls == 1);
+    CHECK(Pat.Run == RTPATTERN_RUN);
+    CHECK(run(1) == 0x21);
+    CHECK(run(1) == 0x22);
+    CHECK(run(1) == 0x22);
+    CHECK(Pat.Run == RTPATTERN_STOP);
+    CHECK(Calls == 2);
+
+    /* 已停止時排入直接開始播放 */
+    CHECK(RtPattern_queue(&Pat, TabA, NULL, 3, 0) == 0);
+    CHECK(Pat.Pending == 0);
+    CHECK(run(1) == 0x11);
+    CHECK(Calls == 2);
+
+    /* 呼叫後中斷維持原本的狀態 */
+    CHECK(SREG & _BV(SREG_I));
+    cli();
+    CHECK(RtPattern_queue(&Pat, TabB, NULL, 2, 0) == 0);
+    CHECK(!(SREG & _BV(SREG_I)));
+    sei();
+}
+
+int main(void) {
+    Host_reset();
+
+    testSwitch();
+    testLast();
+    return HOSTTEST_RESULT();
+}
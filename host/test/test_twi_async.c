@@ -0,0 +1,294 @@
+/**
+ * @file test_twi_async.c
+ * @brief TwiAsync 與 TwiPoll 以腳本 TWSR 驅動的測試。
+ *
+ * 主機模型的 TWCR、TWSR、TWDR 只是記憶體。twi 依腳本寫入 TWSR 狀態碼
+ * 與讀取時的 TWDR 後執行 TWI 中斷，再記錄模組寫入的 TWCR；硬體送出
+ * STOP 後會清除 TWSTO，這裡也在每次中斷後清除，否則 TwiAsync_submit
+ * 會一直等待。
+ */
+
+#include <string.h>
+
+#include "host_test.h"
+#include "twi_async.h"
+#include "twi_poll.h"
+
+#define SLA_A 0x20
+#define SLA_B 0x21
+#define SLA_C 0x22
+
+#define CR_START(CR) ((CR) & _BV(TWSTA))
+#define CR_STOP(CR)  ((CR) & _BV(TWSTO))
+#define CR_ACK(CR)   ((CR) & _BV(TWEA))
+
+static TwiAsyncStr_t Twi;
+static TwiIntStr_t TwiInt;
+static uint8_t Cr;
+static uint8_t Done;
+
+static void done(void* Para_p) {
+    Done++;
+}
+
+static void setup(uint16_t Timeout) {
+    memset(&TwiInt, 0, sizeof(TwiInt));
+    TWCR = 0;
+    TWSR = 0;
+    CHECK(TwiAsync_net(&Twi, &TwiInt, Timeout) == 0);
+    Done = 0;
+}
+
+/* 以狀態碼 Status 執行一次 TWI 中斷，回傳模組寫入的 TWDR */
+static uint8_t twi(uint8_t Status) {
+    TWSR = Status | (TWSR & 0x03);
+    TwiInt_step(&TwiInt);
+    Cr = TWCR;
+    TWCR &= ~_BV(TWSTO);
+    return TWDR;
+}
+
+/* 讀取時 Slave 送出 Data */
+static void twiRead(uint8_t Status, uint8_t Data) {
+    TWDR = Data;
+    twi(Status);
+}
+
+static void testRead(void) {
+    uint8_t back[2] = {0, 0};
+    uint8_t handle;
+
+    /* Mode 5：寫入 RegAdd 後以 repeated START 讀取，由高至低 */
+    setup(0);
+    CHECK(TwiAsync_rec(&Twi, 5, SLA_A, 0x12, 2, back, done, NULL, &handle) ==
+          0);
+    CHECK(CR_START(TWCR));
+    CHECK(twi(0x08) == SLA_A << 1);
+    CHECK(twi(0x18) == 0x12);
+    twi(0x28);
+    CHECK(CR_START(Cr) && !CR_STOP(Cr));
+    CHECK(twi(0x10) == ((SLA_A << 1) | 1));
+    twi(0x40);
+    CHECK(CR_ACK(Cr));
+    twiRead(0x50, 0xAA);
+    CHECK(!CR_ACK(Cr));
+    CHECK(!TwiAsync_isDone(&Twi, handle));
+    twiRead(0x58, 0xBB);
+    CHECK(CR_STOP(Cr));
+    CHECK(TwiAsync_getResult(&Twi, handle) == TWIASYNC_RES_OK);
+    CHECK(back[1] == 0xAA && back[0] == 0xBB);
+    CHECK(Done == 1 && !Twi.Busy);
+    /* START 與 repeated START 各1、位元組各9，加上 STOP */
+    CHECK(Twi.BitCount == 1 + 9 + 9 + 1 + 9 + 9 + 9 + 1);
+
+    /* Mode 6：由低至高，只有一個位元組時直接回 NACK */
+    CHECK(TwiAsync_rec(&Twi, 6, SLA_A, 0x34, 1, back, NULL, NULL, &handle) ==
+          0);
+    twi(0x08);
+    CHECK(twi(0x18) == 0x34);
+    twi(0x28);
+    twi(0x10);
+    twi(0x40);
+    CHECK(!CR_ACK(Cr));
+    twiRead(0x58, 0x5C);
+    CHECK(TwiAsync_getResult(&Twi, handle) == TWIASYNC_RES_OK);
+    CHECK(back[0] == 0x5C);
+
+    CHECK(TwiAsync_rec(&Twi, 7, SLA_A, 0, 1, back, NULL, NULL, &handle) == 1);
+    CHECK(TwiAsync_rec(&Twi, 5, SLA_A, 0, 0, back, NULL, NULL, &handle) == 3);
+}
+
+static void testChain(void) {
+    uint8_t data[2] = {0x11, 0x22};
+    uint8_t back    = 0;
+    uint8_t first;
+    uint8_t second;
+    uint8_t third;
+
+    setup(0);
+    CHECK(TwiAsync_trm(&Twi, 4, SLA_A, 0, 2, data, done, NULL, &first) == 0);
+    CHECK(TwiAsync_rec(&Twi, 3, SLA_B, 0, 1, &back, done, NULL, &second) ==
+          0);
+    CHECK(TwiAsync_trm(&Twi, 6, SLA_C, 0x40, 2, data, done, NULL, &third) ==
+          0);
+    CHECK(TwiAsync_trm(&Twi, 4, SLA_C, 0, 1, data, NULL, NULL, &third) == 0);
+    CHECK(TwiAsync_trm(&Twi, 4, SLA_C, 0, 1, data, NULL, NULL, &third) == 2);
+
+    /* 成功結束後不送 STOP，直接以 repeated START 接續 */
+    twi(0x08);
+    CHECK(twi(0x18) == 0x11);
+    CHECK(twi(0x28) == 0x22);
+    twi(0x28);
+    CHECK(CR_START(Cr) && !CR_STOP(Cr));
+    CHECK(TwiAsync_getResult(&Twi, first) == TWIASYNC_RES_OK);
+
+    CHECK(twi(0x10) == ((SLA_B << 1) | 1));
+    twi(0x40);
+    twiRead(0x58, 0x99);
+    CHECK(CR_START(Cr) && !CR_STOP(Cr));
+    CHECK(TwiAsync_getResult(&Twi, second) == TWIASYNC_RES_OK);
+    CHECK(back == 0x99);
+
+    /* 資料被 NACK 時以 STOP 加 START 結束並接續下一筆 */
+    twi(0x10);
+    CHECK(twi(0x18) == 0x40);
+    twi(0x28);
+    twi(0x30);
+    CHECK(CR_START(Cr) && CR_STOP(Cr));
+    CHECK(TwiAsync_getResult(&Twi, (uint8_t)(second + 1)) ==
+          TWIASYNC_RES_NACK);
+
+    /* SLA 未被 ACK，佇列已空，只送 STOP */
+    twi(0x08);
+    twi(0x20);
+    CHECK(CR_STOP(Cr) && !CR_START(Cr));
+    CHECK(TwiAsync_getResult(&Twi, third) == TWIASYNC_RES_SLA);
+    CHECK(Done == 3 && !Twi.Busy);
+}
+
+static void testBusError(void) {
+    uint8_t data = 0x33;
+    uint8_t lost;
+    uint8_t next;
+
+    /* 仲裁失敗時已不是 Master，不送 STOP，只以 START 等待匯流排 */
+    setup(0);
+    CHECK(TwiAsync_trm(&Twi, 3, SLA_A, 0, 1, &data, NULL, NULL, &lost) == 0);
+    CHECK(TwiAsync_trm(&Twi, 3, SLA_B, 0, 1, &data, NULL, NULL, &next) == 0);
+    twi(0x08);
+    twi(0x38);
+    CHECK(CR_START(Cr) && !CR_STOP(Cr));
+    CHECK(TwiAsync_getResult(&Twi, lost) == TWIASYNC_RES_BUS);
+    CHECK(twi(0x08) == SLA_B << 1);
+
+    /* 匯流排錯誤以 STOP 釋放，並以 START 接續下一筆 */
+    CHECK(TwiAsync_trm(&Twi, 3, SLA_C, 0, 1, &data, NULL, NULL, &lost) == 0);
+    twi(0x00);
+    CHECK(CR_STOP(Cr) && CR_START(Cr));
+    CHECK(TwiAsync_getResult(&Twi, next) == TWIASYNC_RES_BUS);
+    CHECK(twi(0x08) == SLA_C << 1);
+    twi(0x00);
+    CHECK(CR_STOP(Cr) && !CR_START(Cr));
+    CHECK(TwiAsync_getResult(&Twi, lost) == TWIASYNC_RES_BUS);
+    CHECK(!Twi.Busy);
+}
+
+static void testTimeout(void) {
+    uint8_t data = 0x44;
+    uint8_t lost;
+    uint8_t next;
+
+    setup(3);
+    CHECK(TwiAsync_trm(&Twi, 3, SLA_A, 0, 1, &data, NULL, NULL, &lost) == 0);
+    CHECK(TwiAsync_trm(&Twi, 3, SLA_B, 0, 1, &data, NULL, NULL, &next) == 0);
+    twi(0x08);
+    TwiAsync_tick(&Twi);
+    TwiAsync_tick(&Twi);
+    CHECK(!TwiAsync_isDone(&Twi, lost));
+    TwiAsync_tick(&Twi);
+    CHECK(TwiAsync_getResult(&Twi, lost) == TWIASYNC_RES_TIMEOUT);
+    CHECK(CR_STOP(TWCR) && CR_START(TWCR));
+    TWCR &= ~_BV(TWSTO);
+
+    /* 下一筆工作重新計時 */
+    CHECK(Twi.TimeLeft == 3);
+    twi(0x08);
+    twi(0x18);
+    twi(0x28);
+    CHECK(TwiAsync_getResult(&Twi, next) == TWIASYNC_RES_OK);
+    TwiAsync_tick(&Twi);
+    CHECK(!Twi.Busy);
+}
+
+static void testBusLoad(void) {
+    setup(0);
+
+    /* TWBR 12、預除1：每個 SCL 週期 16 + 2 * 12 = 40 個 CPU 週期 */
+    TWBR          = 12;
+    TWSR          = 0x00;
+    Twi.BitCount  = 1382;
+    /* 10 ms 為 110590 個 CPU 週期，計算取 110 * 1000 */
+    CHECK(TwiAsync_busLoad(&Twi, 10) == 1382UL * 40 / 110);
+    CHECK(Twi.BitCount == 0);
+    CHECK(TwiAsync_busLoad(&Twi, 10) == 0);
+
+    /* 預除4：16 + 2 * 12 * 4 = 112 */
+    TWSR         = 0x01;
+    Twi.BitCount = 500;
+    CHECK(TwiAsync_busLoad(&Twi, 10) == 500UL * 112 / 110);
+
+    Twi.BitCount = 5000;
+    CHECK(TwiAsync_busLoad(&Twi, 10) == 1000);
+    Twi.BitCount = 5000;
+    CHECK(TwiAsync_busLoad(&Twi, 0) == 0);
+    TWSR = 0;
+    TWBR = 0;
+}
+
+static void testPoll(void) {
+    static TwiPollStr_t poll;
+    uint8_t a       = 0;
+    uint8_t b[2]    = {0x01, 0x02};
+    uint8_t c       = 0;
+    uint8_t extra   = 0;
+    uint8_t handle;
+    TwiPollItemStr_t item[3] = {
+        {TWIASYNC_TYPE_REC, 5, SLA_A, 0x10, 1, &a},
+        {TWIASYNC_TYPE_TRM, 4, SLA_B, 0, 2, b},
+        {TWIASYNC_TYPE_REC, 3, SLA_C, 0, 1, &c},
+    };
+
+    setup(0);
+    CHECK(TwiPoll_net(&poll, &Twi, item, 0, done, NULL) == 1);
+    CHECK(TwiPoll_net(&poll, &Twi, item, TWIASYNC_MAX_JOB + 1, done, NULL) ==
+          1);
+    CHECK(TwiPoll_net(&poll, &Twi, item, 3, done, NULL) == 0);
+
+    TwiPoll_step(&poll);
+    CHECK(poll.Busy && Twi.JobHead == 3);
+    /* 上一輪未完成 */
+    TwiPoll_step(&poll);
+    CHECK(poll.Overrun == 1 && Twi.JobHead == 3);
+
+    twi(0x08);
+    twi(0x18);
+    twi(0x28);
+    twi(0x10);
+    twi(0x40);
+    twiRead(0x58, 0xA5);
+    CHECK(item[0].Result == TWIASYNC_RES_OK && a == 0xA5);
+
+    /* 本輪中間的工作被 NACK，其餘工作照常完成 */
+    twi(0x10);
+    twi(0x18);
+    twi(0x30);
+    CHECK(CR_STOP(Cr) && CR_START(Cr));
+    CHECK(item[1].Result == TWIASYNC_RES_NACK);
+    CHECK(poll.Busy);
+
+    twi(0x08);
+    twi(0x40);
+    twiRead(0x58, 0x3C);
+    CHECK(item[2].Result == TWIASYNC_RES_OK && c == 0x3C);
+    CHECK(!poll.Busy && poll.Round == 1 && Done == 1);
+
+    /* TwiAsync 佇列空間不足以放入整輪 */
+    CHECK(TwiAsync_trm(&Twi, 3, SLA_A, 0, 1, &extra, NULL, NULL, &handle) ==
+          0);
+    CHECK(TwiAsync_trm(&Twi, 3, SLA_A, 0, 1, &extra, NULL, NULL, &handle) ==
+          0);
+    TwiPoll_step(&poll);
+    CHECK(poll.Overrun == 2 && poll.Busy == 0);
+}
+
+int main(void) {
+    Host_reset();
+
+    testRead();
+    testChain();
+    testBusError();
+    testTimeout();
+    testBusLoad();
+    testPoll();
+    return HOSTTEST_RESULT();
+}
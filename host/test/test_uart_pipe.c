@@ -0,0 +1,316 @@
+/**
+ * @file test_uart_pipe.c
+ * @brief UartPipe Master 與 Slave 經全雙工連線模型的迴路測試。
+ *
+ * testShared 以本檔的共用匯流排模型連接一個 Master 與兩個 Slave：命令線
+ * 送到所有 Slave，所有 Slave 共用回應線，同一個位元組時間有兩個 Slave
+ * 送出即為碰撞。
+ */
+
+#include <string.h>
+
+#include "host_test.h"
+#include "host_wire.h"
+#include "uart_pipe.h"
+
+#define SLAVE_ID 3
+#define LATENCY  8
+#define JOBS     32
+
+static UartPipeStr_t Pipe;
+static UartIntStr_t MasterInt;
+static UartPipeSStr_t Slave;
+static UartIntStr_t SlaveInt;
+static UartPipeRegStr_t Regs[4];
+static uint8_t Reg[4][4];
+static HostWireStr_t Wire;
+
+static void setup(uint8_t Window, uint16_t Timeout) {
+    memset(&MasterInt, 0, sizeof(MasterInt));
+    memset(&SlaveInt, 0, sizeof(SlaveInt));
+    memset(Reg, 0, sizeof(Reg));
+    for (uint8_t i = 0; i < 3; i++) {
+        Regs[i].Data_p = Reg[i];
+        Regs[i].Bytes  = 4;
+    }
+    CHECK(UartPipe_net(&Pipe, &MasterInt, 0, Window, Timeout) == 0);
+    CHECK(UartPipeS_net(&Slave, &SlaveInt, 1, SLAVE_ID, Regs, 4) == 0);
+    HostWire_net(&Wire, &MasterInt, &Pipe.TxBuf, &SlaveInt, &Slave.TxBuf,
+                 LATENCY);
+}
+
+/* 執行到所有工作完成，回傳經過的位元組時間 */
+static uint32_t run(uint8_t Handle) {
+    uint32_t start = Wire.Now;
+
+    while (!UartPipe_isDone(&Pipe, Handle) || !HostWire_isIdle(&Wire)) {
+        HostWire_step(&Wire);
+        UartPipe_tick(&Pipe);
+        if (Wire.Now - start > 100000) {
+            break;
+        }
+    }
+    return Wire.Now - start;
+}
+
+/* 交替寫入與讀回 JOBS 筆，工作佇列滿時先推進時間 */
+static uint32_t stream(uint8_t Window) {
+    uint8_t data[JOBS][4];
+    uint8_t back[JOBS][4];
+    uint8_t handle[JOBS];
+    uint8_t fail = 0;
+    uint32_t start;
+
+    setup(Window, 0);
+    memset(back, 0, sizeof(back));
+    start = Wire.Now;
+    for (uint8_t n = 0; n < JOBS; n++) {
+        uint8_t res;
+
+        for (uint8_t i = 0; i < 4; i++) {
+            data[n][i] = n * 4 + i;
+        }
+        do {
+            if (n & 1) {
+                res = UartPipe_rec(&Pipe, SLAVE_ID, (n / 2) % 3, 4, back[n],
+                                   NULL, NULL, &handle[n]);
+            }
+            else {
+                res = UartPipe_trm(&Pipe, SLAVE_ID, (n / 2) % 3, 4, data[n],
+                                   NULL, NULL, &handle[n]);
+            }
+            if (res) {
+                HostWire_step(&Wire);
+            }
+        } while (res == 2 || res == 3);
+        CHECK(res == 0);
+    }
+    run(handle[JOBS - 1]);
+    for (uint8_t n = 0; n < JOBS; n++) {
+        if (UartPipe_getResult(&Pipe, handle[n]) != UARTPIPE_RES_OK) {
+            fail++;
+        }
+        if ((n & 1) && memcmp(back[n], data[n - 1], 4) != 0) {
+            fail++;
+        }
+    }
+    CHECK(fail == 0);
+    CHECK(Pipe.Stray == 0 && Slave.Drop == 0);
+    return Wire.Now - start;
+}
+
+static void testWindow(void) {
+    uint32_t time1 = stream(1);
+    uint32_t time4 = stream(4);
+
+    /* 每個封包的來回延遲在視窗為 4 時與其他封包重疊 */
+    CHECK(time4 < time1);
+    CHECK(Wire.End[0].Bytes == JOBS / 2 * (10 + 6));
+}
+
+static void testError(void) {
+    uint8_t data[4] = {1, 2, 3, 4};
+    uint8_t back[2];
+    uint8_t handle;
+
+    setup(4, 200);
+    /* 未註冊的暫存器與位元組數不符 */
+    CHECK(UartPipe_trm(&Pipe, SLAVE_ID, 3, 4, data, NULL, NULL, &handle) ==
+          0);
+    run(handle);
+    CHECK(UartPipe_getResult(&Pipe, handle) == UARTPIPE_RES_REGADD);
+    CHECK(UartPipe_rec(&Pipe, SLAVE_ID, 0, 2, back, NULL, NULL, &handle) ==
+          0);
+    run(handle);
+    CHECK(UartPipe_getResult(&Pipe, handle) == UARTPIPE_RES_BYTES);
+
+    /* 沒有裝置回應時逾時 */
+    CHECK(UartPipe_trm(&Pipe, SLAVE_ID + 1, 0, 4, data, NULL, NULL,
+                       &handle) == 0);
+    run(handle);
+    CHECK(UartPipe_getResult(&Pipe, handle) == UARTPIPE_RES_TIMEOUT);
+    CHECK(Reg[0][0] == 0);
+
+    CHECK(UartPipe_trm(&Pipe, SLAVE_ID, 0, 0, data, NULL, NULL, &handle) ==
+          4);
+}
+
+/*-- 共用匯流排 ---------------------------------------------------------------*/
+
+#define BUS_END 3  ///< End[0] 為 Master(UART0)，其餘為 Slave(UART1)
+
+typedef struct {
+    UartIntStr_t* Int_p;
+    RingBufStr_t* TxBuf_p;
+    volatile uint8_t* Udr_p;
+    uint8_t Tail;
+    uint8_t Shift;
+    uint8_t Busy;
+} BusEndStr_t;
+
+typedef struct {
+    uint8_t Fifo[256];
+    uint32_t Due[256];
+    uint8_t Head;
+    uint8_t Out;
+} BusLineStr_t;
+
+static BusEndStr_t End[BUS_END];
+static BusLineStr_t CmdLine, RspLine;
+static uint32_t Now;
+static uint16_t Collision;
+static UartPipeSStr_t Slave2;
+static UartIntStr_t Slave2Int;
+
+/* 與 host_wire 相同，以傳送緩衝區的 Tail 變化判斷寫入了 UDRn */
+static void busWatch(uint8_t N) {
+    BusEndStr_t* end_p = &End[N];
+
+    if (end_p->TxBuf_p->Tail != end_p->Tail) {
+        end_p->Tail  = end_p->TxBuf_p->Tail;
+        end_p->Shift = *end_p->Udr_p;
+        end_p->Busy  = 1;
+    }
+}
+
+static void busNet(void) {
+    End[0] = (BusEndStr_t){&MasterInt, &Pipe.TxBuf, &UDR0};
+    End[1] = (BusEndStr_t){&SlaveInt, &Slave.TxBuf, &UDR1};
+    End[2] = (BusEndStr_t){&Slave2Int, &Slave2.TxBuf, &UDR1};
+    for (uint8_t i = 0; i < BUS_END; i++) {
+        End[i].Tail = End[i].TxBuf_p->Tail;
+    }
+    memset(&CmdLine, 0, sizeof(CmdLine));
+    memset(&RspLine, 0, sizeof(RspLine));
+    Now       = 0;
+    Collision = 0;
+}
+
+static void busPut(BusLineStr_t* Line_p, uint8_t Data) {
+    Line_p->Fifo[Line_p->Head] = Data;
+    Line_p->Due[Line_p->Head]  = Now + LATENCY;
+    Line_p->Head++;
+}
+
+static void busStep(void) {
+    uint8_t senders = 0;
+    uint8_t data    = 0;
+
+    busWatch(0);
+    Now++;
+    if (End[0].Busy) {
+        End[0].Busy = 0;
+        busPut(&CmdLine, End[0].Shift);
+        UartTx_step(End[0].Int_p);
+        busWatch(0);
+    }
+    for (uint8_t i = 1; i < BUS_END; i++) {
+        if (End[i].Busy) {
+            End[i].Busy = 0;
+            data ^= End[i].Shift;
+            senders++;
+            UartTx_step(End[i].Int_p);
+            busWatch(i);
+        }
+    }
+    if (senders > 1) {
+        Collision++;
+    }
+    if (senders) {
+        busPut(&RspLine, data);
+    }
+
+    while (CmdLine.Out != CmdLine.Head && CmdLine.Due[CmdLine.Out] <= Now) {
+        data = CmdLine.Fifo[CmdLine.Out++];
+        for (uint8_t i = 1; i < BUS_END; i++) {
+            *End[i].Udr_p = data;
+            UartRx_step(End[i].Int_p);
+            busWatch(i);
+        }
+    }
+    while (RspLine.Out != RspLine.Head && RspLine.Due[RspLine.Out] <= Now) {
+        UDR0 = RspLine.Fifo[RspLine.Out++];
+        UartRx_step(&MasterInt);
+        busWatch(0);
+    }
+    UartPipe_tick(&Pipe);
+}
+
+static uint8_t busIsIdle(void) {
+    for (uint8_t i = 0; i < BUS_END; i++) {
+        busWatch(i);
+        if (End[i].Busy) {
+            return 0;
+        }
+    }
+    return CmdLine.Out == CmdLine.Head && RspLine.Out == RspLine.Head;
+}
+
+/* 兩個 Slave 交替讀寫，讀取命令短而回應長，最容易碰撞 */
+static void testShared(void) {
+    static UartPipeRegStr_t regs2[1];
+    uint8_t reg2[4] = {0};
+    uint8_t data[JOBS][4];
+    uint8_t back[JOBS][4];
+    uint8_t handle[JOBS];
+    uint8_t fail = 0;
+
+    setup(4, 200);
+    memset(&Slave2Int, 0, sizeof(Slave2Int));
+    regs2[0].Data_p = reg2;
+    regs2[0].Bytes  = 4;
+    CHECK(UartPipeS_net(&Slave2, &Slave2Int, 1, SLAVE_ID + 1, regs2, 1) ==
+          0);
+    busNet();
+
+    memset(back, 0, sizeof(back));
+    for (uint8_t n = 0; n < JOBS; n++) {
+        uint8_t uid = (n & 1) ? SLAVE_ID + 1 : SLAVE_ID;
+        uint8_t res;
+
+        for (uint8_t i = 0; i < 4; i++) {
+            data[n][i] = n * 4 + i;
+        }
+        do {
+            if (n & 2) {
+                res = UartPipe_rec(&Pipe, uid, 0, 4, back[n], NULL, NULL,
+                                   &handle[n]);
+            }
+            else {
+                res = UartPipe_trm(&Pipe, uid, 0, 4, data[n], NULL, NULL,
+                                   &handle[n]);
+            }
+            if (res) {
+                busStep();
+            }
+        } while (res == 2 || res == 3);
+        CHECK(res == 0);
+    }
+    while (!UartPipe_isDone(&Pipe, handle[JOBS - 1]) || !busIsIdle()) {
+        busStep();
+        if (Now > 100000) {
+            break;
+        }
+    }
+    for (uint8_t n = 0; n < JOBS; n++) {
+        if (UartPipe_getResult(&Pipe, handle[n]) != UARTPIPE_RES_OK) {
+            fail++;
+        }
+        if ((n & 2) && memcmp(back[n], data[n - 2], 4) != 0) {
+            fail++;
+        }
+    }
+    CHECK(fail == 0);
+    CHECK(Collision == 0);
+    CHECK(Pipe.Stray == 0 && Slave.Drop == 0 && Slave2.Drop == 0);
+    CHECK(memcmp(reg2, data[JOBS - 3], 4) == 0);
+}
+
+int main(void) {
+    Host_reset();
+
+    testWindow();
+    testError();
+    testShared();
+    return HOSTTEST_RESULT();
+}
@@ -0,0 +1,230 @@
+/**
+ * @file test_uart_stream.c
+ * @brief UartStream 與 RemoSlave UART Mode 0 的迴路測試。
+ *
+ * UART0 為 Master、UART1 為 Slave，wire 將 Master 送出的封包逐位元組
+ * 交給 Slave 的接收中斷，再將回應交回 Master。
+ */
+
+#include <string.h>
+
+#include "host_test.h"
+#include "remo_slave.h"
+#include "uart_stream.h"
+
+#define SLAVE_ID 7
+
+static UartStreamStr_t Stream;
+static UartIntStr_t MasterInt;
+static RemoSlaveStr_t Slave;
+static UartIntStr_t SlaveInt;
+static RemoSlaveRegStr_t Regs[8];
+static uint8_t Reg2[2], Reg3[4], Reg3Back[4], Reg5[3];
+
+static uint8_t Cmd[64];
+static uint8_t CmdLen;
+static uint8_t Rsp;
+static uint8_t Done;
+
+static void done(void* Para_p) {
+    Done++;
+}
+
+static void toSlave(void) {
+    Cmd[CmdLen++] = UDR0;
+    UDR1          = UDR0;
+    UartRx_step(&SlaveInt);
+}
+
+/* 送完目前工作的封包並接收回應 */
+static void wire(void) {
+    CmdLen = 0;
+    Rsp    = 0;
+    toSlave();
+    while (Stream.TxLeft) {
+        UartTx_step(&MasterInt);
+        toSlave();
+    }
+    UartTx_step(&MasterInt);
+    while (Slave.TxActive) {
+        UDR0 = UDR1;
+        Rsp++;
+        UartRx_step(&MasterInt);
+        UartTx_step(&SlaveInt);
+    }
+}
+
+/* 送完目前工作的封包，Slave 不回應 */
+static void send(void) {
+    while (Stream.TxLeft) {
+        UartTx_step(&MasterInt);
+    }
+}
+
+static void rspByte(uint8_t Data) {
+    UDR0 = Data;
+    UartRx_step(&MasterInt);
+}
+
+static void testSingle(void) {
+    uint8_t data[2] = {0x11, 0x22};
+    uint8_t back[2] = {0, 0};
+    uint8_t handle;
+
+    CHECK(UartStream_trm(&Stream, SLAVE_ID, 2, 2, data, done, NULL,
+                         &handle) == 0);
+    wire();
+    CHECK(UartStream_isDone(&Stream, handle));
+    CHECK(UartStream_getResult(&Stream, handle) == UARTSTREAM_RES_OK);
+    CHECK(CmdLen == 6 && Cmd[0] == 0xAA && Cmd[2] == 2);
+    CHECK(Cmd[5] == (uint8_t)(SLAVE_ID + 2 + 0x11 + 0x22));
+    CHECK(Reg2[0] == 0x11 && Reg2[1] == 0x22);
+
+    /* 讀取命令同 UARTM_rec：RegAdd 最高位元為 1，並計入 checksum */
+    CHECK(UartStream_rec(&Stream, SLAVE_ID, 2, 2, back, done, NULL,
+                         &handle) == 0);
+    wire();
+    CHECK(UartStream_getResult(&Stream, handle) == UARTSTREAM_RES_OK);
+    CHECK(CmdLen == 4 && Cmd[2] == 0x82);
+    CHECK(Cmd[3] == (uint8_t)(SLAVE_ID + 0x82));
+    CHECK(Rsp == 4);
+    CHECK(back[0] == 0x11 && back[1] == 0x22);
+    CHECK(Done == 2);
+
+    CHECK(UartStream_trm(&Stream, SLAVE_ID, 0x80, 2, data, NULL, NULL,
+                         &handle) == 4);
+    CHECK(UartStream_rec(&Stream, SLAVE_ID, 0x80, 2, back, NULL, NULL,
+                         &handle) == 4);
+    /* 0x7F 為批次標記，不可作為單一暫存器位址 */
+    CHECK(UartStream_trm(&Stream, SLAVE_ID, UARTSTREAM_BULK_W, 2, data, NULL,
+                         NULL, &handle) == 4);
+    CHECK(UartStream_rec(&Stream, SLAVE_ID, UARTSTREAM_BULK_W, 2, back, NULL,
+                         NULL, &handle) == 4);
+    CHECK(UartStream_rec(&Stream, SLAVE_ID, 2, UARTSTREAM_REC_SZ + 1, back,
+                         NULL, NULL, &handle) == 4);
+}
+
+static void testBulk(void) {
+    const UartStreamBulkStr_t list[3] = {{2, 2}, {3, 4}, {5, 3}};
+    const UartStreamBulkStr_t bad[2]  = {{2, 2}, {4, 1}};
+    uint8_t data[9] = {1, 2, 3, 4, 5, 6, 7, 8, 9};
+    uint8_t back[9];
+    uint8_t* reg3_p;
+    uint8_t handle;
+
+    CHECK(UartStream_bulkTrm(&Stream, SLAVE_ID, list, 3, data, NULL, NULL,
+                             &handle) == 0);
+    wire();
+    CHECK(UartStream_getResult(&Stream, handle) == UARTSTREAM_RES_OK);
+    CHECK(CmdLen == 20);
+    reg3_p = RemoSlave_regData(&Slave, 3);
+    CHECK(Reg2[0] == 1 && Reg2[1] == 2);
+    CHECK(reg3_p[0] == 3 && reg3_p[3] == 6);
+    CHECK(Reg5[0] == 7 && Reg5[2] == 9);
+
+    memset(back, 0, sizeof(back));
+    CHECK(UartStream_bulkRec(&Stream, SLAVE_ID, list, 3, back, NULL, NULL,
+                             &handle) == 0);
+    wire();
+    CHECK(UartStream_getResult(&Stream, handle) == UARTSTREAM_RES_OK);
+    CHECK(memcmp(back, data, 9) == 0);
+
+    /* 暫存器 4 未註冊，Slave 回應錯誤且不寫入任何暫存器 */
+    Reg2[0] = 0;
+    CHECK(UartStream_bulkTrm(&Stream, SLAVE_ID, bad, 2, data, NULL, NULL,
+                             &handle) == 0);
+    wire();
+    CHECK(UartStream_getResult(&Stream, handle) == UARTSTREAM_RES_SLAVE);
+    CHECK(Reg2[0] == 0);
+
+    CHECK(UartStream_bulkTrm(&Stream, SLAVE_ID, list, 0, data, NULL, NULL,
+                             &handle) == 4);
+}
+
+static void testTimeout(void) {
+    uint8_t back[2] = {0xEE, 0xEE};
+    uint8_t data[3] = {0x5A, 0x5B, 0x5C};
+    uint8_t lost;
+    uint8_t next;
+
+    /* 沒有回應的工作逾時後，下一筆工作接著送出 */
+    CHECK(UartStream_rec(&Stream, SLAVE_ID + 1, 2, 2, back, NULL, NULL,
+                         &lost) == 0);
+    CHECK(UartStream_trm(&Stream, SLAVE_ID, 5, 3, data, NULL, NULL,
+                         &next) == 0);
+    send();
+    rspByte(ASAUART_RSP_HEADER);
+    rspByte(0x11);
+    for (uint8_t i = 0; i < 4; i++) {
+        UartStream_tick(&Stream);
+    }
+    CHECK(!UartStream_isDone(&Stream, lost));
+    UartStream_tick(&Stream);
+    CHECK(UartStream_getResult(&Stream, lost) == UARTSTREAM_RES_TIMEOUT);
+    CHECK(back[0] == 0xEE);
+    CHECK(Stream.TxBusy);
+    wire();
+    CHECK(UartStream_getResult(&Stream, next) == UARTSTREAM_RES_OK);
+    CHECK(Reg5[0] == 0x5A && Reg5[2] == 0x5C);
+
+    /* 逾時發生在封包送完前，未送出的部分不可接到下一筆工作 */
+    CHECK(UartStream_trm(&Stream, SLAVE_ID, 2, 2, back, NULL, NULL,
+                         &lost) == 0);
+    CHECK(UartStream_trm(&Stream, SLAVE_ID, 5, 3, data, NULL, NULL,
+                         &next) == 0);
+    for (uint8_t i = 0; i < 5; i++) {
+        UartStream_tick(&Stream);
+    }
+    CHECK(UartStream_getResult(&Stream, lost) == UARTSTREAM_RES_TIMEOUT);
+    wire();
+    CHECK(CmdLen == 7 && Cmd[2] == 5);
+    CHECK(UartStream_getResult(&Stream, next) == UARTSTREAM_RES_OK);
+}
+
+static void testChecksum(void) {
+    uint8_t back[2] = {0xEE, 0xEE};
+    uint8_t handle;
+
+    /* checksum 錯誤時不寫入使用者的資料 */
+    CHECK(UartStream_rec(&Stream, SLAVE_ID, 2, 2, back, NULL, NULL,
+                         &handle) == 0);
+    send();
+    rspByte(ASAUART_RSP_HEADER);
+    rspByte(1);
+    rspByte(2);
+    rspByte(4);
+    CHECK(UartStream_getResult(&Stream, handle) == UARTSTREAM_RES_CHKSUM);
+    CHECK(back[0] == 0xEE && back[1] == 0xEE);
+
+    CHECK(UartStream_rec(&Stream, SLAVE_ID, 2, 2, back, NULL, NULL,
+                         &handle) == 0);
+    send();
+    rspByte(ASAUART_RSP_HEADER);
+    rspByte(1);
+    rspByte(2);
+    rspByte(3);
+    CHECK(UartStream_getResult(&Stream, handle) == UARTSTREAM_RES_OK);
+    CHECK(back[0] == 1 && back[1] == 2);
+}
+
+int main(void) {
+    Host_reset();
+
+    Regs[2].Data_p  = Reg2;
+    Regs[2].Bytes   = sizeof(Reg2);
+    Regs[3].Data_p  = Reg3;
+    Regs[3].Back_p  = Reg3Back;
+    Regs[3].Bytes   = sizeof(Reg3);
+    Regs[5].Data_p  = Reg5;
+    Regs[5].Bytes   = sizeof(Reg5);
+    CHECK(UartStream_net(&Stream, &MasterInt, 0, 5) == 0);
+    CHECK(RemoSlave_net(&Slave, SERIAL_TYPE_UART, 1, 0, SLAVE_ID, Regs, 8) ==
+          0);
+    RemoSlave_uartReg(&Slave, &SlaveInt);
+
+    testSingle();
+    testBulk();
+    testTimeout();
+    testChecksum();
+    return HOSTTEST_RESULT();
+}